@@ -32,6 +32,8 @@
 
 using namespace std;
 
+extern bool g_enable_snapshot_reads;
+
 namespace Buffer_Namespace {
 
 std::string BufferMgr::keyToString(const ChunkKey& key) {
@@ -101,10 +103,12 @@ void BufferMgr::clear() {
   }
 
   chunk_index_.clear();
+  detached_buffer_keys_.clear();
   slabs_.clear();
   slab_segments_.clear();
   unsized_segs_.clear();
   buffer_epoch_ = 0;
+  num_pages_used_ = 0;
 }
 
 /// Throws a runtime_error if the Chunk already exists
@@ -164,6 +168,9 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
       CHECK(evict_it->buffer->getPinCount() < 1);
     }
     num_pages += evict_it->num_pages;
+    if (evict_it->mem_status == USED) {
+      num_pages_used_ -= evict_it->num_pages;
+    }
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
       chunk_index_.erase(evict_it->chunk_key);
     }
@@ -182,6 +189,7 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
   data_seg.slab_num = slab_num;
   auto data_seg_it =
       slab_segments_[slab_num].insert(evict_it, data_seg);  // Will insert before evict_it
+  addUsedPages(num_pages_requested);
   if (num_pages_requested < num_pages) {
     size_t excess_pages = num_pages - num_pages_requested;
     if (evict_it != slab_segments_[slab_num].end() &&
@@ -216,6 +224,7 @@ BufferList::iterator BufferMgr::reserveBuffer(
       // Then we can just use the next BufferSeg which happens to be free
       size_t leftover_pages = next_it->num_pages - num_pages_extra_needed;
       seg_it->num_pages = num_pages_requested;
+      addUsedPages(num_pages_extra_needed);
       next_it->num_pages = leftover_pages;
       next_it->start_page = seg_it->start_page + seg_it->num_pages;
       return seg_it;
@@ -263,6 +272,7 @@ BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
       buffer_it->mem_status = USED;
       buffer_it->last_touched = buffer_epoch_++;
       buffer_it->slab_num = slab_num;
+      addUsedPages(num_pages_requested);
       if (excess_pages > 0) {
         BufferSeg free_seg(
             buffer_it->start_page + num_pages_requested, excess_pages, FREE);
@@ -287,7 +297,24 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
 
   size_t num_slabs = slab_segments_.size();
 
+  // Take free segments of the slabs local to the preferred NUMA node first, so that the
+  // thread loading a chunk does not have to reach across the interconnect for it.
+  const auto preferred_numa_node = getPreferredNumaNode();
+  if (preferred_numa_node >= 0) {
+    for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
+      if (getSlabNumaNode(slab_num) == preferred_numa_node) {
+        auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
+        if (seg_it != slab_segments_[slab_num].end()) {
+          return seg_it;
+        }
+      }
+    }
+  }
+
   for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
+    if (preferred_numa_node >= 0 && getSlabNumaNode(slab_num) == preferred_numa_node) {
+      continue;
+    }
     auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
     if (seg_it != slab_segments_[slab_num].end()) {
       return seg_it;
@@ -635,9 +662,16 @@ void BufferMgr::deleteBuffersWithPrefix(const ChunkKey& key_prefix, const bool)
     auto seg_it = buffer_it->second;
     if (seg_it->buffer) {
       if (seg_it->buffer->getPinCount() != 0) {
-        // leave the buffer and buffer segment in place, they are in use elsewhere. once
-        // unpinned, the buffer will be inaccessible and evicted
-        buffer_it++;
+        if (g_enable_snapshot_reads) {
+          // the buffer is in use elsewhere. detach it from the chunk, so that later
+          // readers do not find it, and free it once unpinned
+          detachBuffer(seg_it);
+          chunk_index_.erase(buffer_it++);
+        } else {
+          // leave the buffer and buffer segment in place, they are in use elsewhere.
+          // once unpinned, the buffer will be inaccessible and evicted
+          buffer_it++;
+        }
         continue;
       }
       delete seg_it->buffer;  // Delete Buffer for segment
@@ -646,6 +680,73 @@ void BufferMgr::deleteBuffersWithPrefix(const ChunkKey& key_prefix, const bool)
     removeSegment(seg_it);
     chunk_index_.erase(buffer_it++);
   }
+  freeDetachedBuffers();
+}
+
+void BufferMgr::replaceBuffer(const ChunkKey& key, AbstractBuffer* buffer) {
+  std::lock_guard<std::mutex> lock(global_mutex_);
+  std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
+  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  auto casted_buffer = dynamic_cast<Buffer*>(buffer);
+  CHECK(casted_buffer);
+  auto new_seg_it = casted_buffer->seg_it_;
+  CHECK_EQ(new_seg_it->chunk_key[0], -1) << "Only allocated buffers can be swapped in.";
+
+  auto buffer_it = chunk_index_.find(key);
+  if (buffer_it != chunk_index_.end()) {
+    auto seg_it = buffer_it->second;
+    chunk_index_.erase(buffer_it);
+    if (seg_it->buffer && seg_it->buffer->getPinCount() != 0) {
+      detachBuffer(seg_it);
+    } else {
+      delete seg_it->buffer;
+      seg_it->buffer = nullptr;
+      removeSegment(seg_it);
+    }
+  }
+  chunk_index_.erase(new_seg_it->chunk_key);
+  new_seg_it->chunk_key = key;
+  chunk_index_[key] = new_seg_it;
+  freeDetachedBuffers();
+}
+
+void BufferMgr::addUsedPages(const size_t num_pages) {
+  const auto num_pages_used = num_pages_used_ += num_pages;
+  auto max_num_pages_used = max_num_pages_used_.load();
+  while (num_pages_used > max_num_pages_used &&
+         !max_num_pages_used_.compare_exchange_weak(max_num_pages_used,
+                                                    num_pages_used)) {
+  }
+}
+
+// Moves a pinned buffer out of the way of the chunk it held. The buffer stays valid for
+// whoever pinned it and is freed once unpinned, by freeDetachedBuffers() or eviction.
+// Assumes the caller holds chunk_index_mutex_ and removes the buffer's current key.
+void BufferMgr::detachBuffer(BufferList::iterator seg_it) {
+  ChunkKey detached_key{-1, getBufferId()};
+  seg_it->chunk_key = detached_key;
+  chunk_index_[detached_key] = seg_it;
+  detached_buffer_keys_.push_back(detached_key);
+}
+
+// Assumes the caller holds sized_segs_mutex_ and chunk_index_mutex_.
+void BufferMgr::freeDetachedBuffers() {
+  auto key_it = detached_buffer_keys_.begin();
+  while (key_it != detached_buffer_keys_.end()) {
+    auto buffer_it = chunk_index_.find(*key_it);
+    if (buffer_it != chunk_index_.end()) {  // otherwise already evicted
+      auto seg_it = buffer_it->second;
+      if (seg_it->buffer && seg_it->buffer->getPinCount() != 0) {
+        ++key_it;
+        continue;
+      }
+      delete seg_it->buffer;
+      seg_it->buffer = nullptr;
+      removeSegment(seg_it);
+      chunk_index_.erase(buffer_it);
+    }
+    key_it = detached_buffer_keys_.erase(key_it);
+  }
 }
 
 void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
@@ -656,6 +757,9 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
     std::lock_guard<std::mutex> unsized_segs_lock(unsized_segs_mutex_);
     unsized_segs_.erase(seg_it);
   } else {
+    if (seg_it->mem_status == USED) {
+      num_pages_used_ -= seg_it->num_pages;
+    }
     if (seg_it != slab_segments_[slab_num].begin()) {
       auto prev_it = std::prev(seg_it);
       // LOG(INFO) << "PrevIt: " << " " << getStringMgrType() << ":" << device_id_;
@@ -887,6 +991,42 @@ const std::vector<BufferList>& BufferMgr::getSlabSegments() {
   return slab_segments_;
 }
 
+std::map<int, int32_t> BufferMgr::getFragmentNumaNodes(const ChunkKey& table_key) {
+  CHECK_EQ(table_key.size(), size_t(2));
+  std::map<int, std::map<int32_t, size_t>> num_pages_per_fragment;
+  {
+    std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
+    std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+    for (auto buffer_it = chunk_index_.lower_bound(table_key);
+         buffer_it != chunk_index_.end() &&
+         buffer_it->first.size() >= table_key.size() &&
+         std::equal(table_key.begin(), table_key.end(), buffer_it->first.begin());
+         ++buffer_it) {
+      const auto& chunk_key = buffer_it->first;
+      const auto seg_it = buffer_it->second;
+      if (chunk_key.size() <= CHUNK_KEY_FRAGMENT_IDX || seg_it->slab_num < 0) {
+        continue;
+      }
+      const auto numa_node = getSlabNumaNode(seg_it->slab_num);
+      if (numa_node >= 0) {
+        num_pages_per_fragment[chunk_key[CHUNK_KEY_FRAGMENT_IDX]][numa_node] +=
+            seg_it->num_pages;
+      }
+    }
+  }
+  std::map<int, int32_t> fragment_numa_nodes;
+  for (const auto& [fragment_id, num_pages_per_node] : num_pages_per_fragment) {
+    fragment_numa_nodes[fragment_id] =
+        std::max_element(num_pages_per_node.begin(),
+                         num_pages_per_node.end(),
+                         [](const auto& lhs, const auto& rhs) {
+                           return lhs.second < rhs.second;
+                         })
+            ->first;
+  }
+  return fragment_numa_nodes;
+}
+
 void BufferMgr::removeTableRelatedDS(const int db_id, const int table_id) {
   UNREACHABLE();
 }
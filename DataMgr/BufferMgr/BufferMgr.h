@@ -26,6 +26,7 @@
 
 #define BOOST_STACKTRACE_GNU_SOURCE_NOT_REQUIRED 1
 
+#include <atomic>
 #include <iostream>
 #include <list>
 #include <map>
@@ -123,7 +124,15 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   size_t getMaxSlabSize();
   size_t getPageSize();
   bool isAllocationCapped() override;
+  /// Returns the most pages in use at once since the last resetMaxNumPagesUsed().
+  size_t getMaxNumPagesUsed() const { return max_num_pages_used_; }
+  void resetMaxNumPagesUsed() { max_num_pages_used_ = num_pages_used_.load(); }
   const std::vector<BufferList>& getSlabSegments();
+  /// Returns the NUMA node the memory of the slab is placed on, or -1 if unknown.
+  virtual int32_t getSlabNumaNode(const size_t slab_num) const { return -1; }
+  /// Returns the NUMA node holding most pages of the buffers of each fragment of the
+  /// table with the specified key, for the fragments with buffers on a known node.
+  std::map<int, int32_t> getFragmentNumaNodes(const ChunkKey& table_key);
 
   /// Creates a chunk with the specified key and page size.
   AbstractBuffer* createBuffer(const ChunkKey& key,
@@ -135,6 +144,11 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   void deleteBuffersWithPrefix(const ChunkKey& key_prefix,
                                const bool purge = true) override;
 
+  /// Makes a buffer returned by alloc() the buffer of the chunk with the specified key.
+  /// The previous buffer of the chunk is deleted, or kept for its readers until it is
+  /// unpinned.
+  void replaceBuffer(const ChunkKey& key, AbstractBuffer* buffer);
+
   /// Returns the a pointer to the chunk with the specified key.
   AbstractBuffer* getBuffer(const ChunkKey& key, const size_t num_bytes = 0) override;
 
@@ -184,9 +198,14 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   BufferMgr(const BufferMgr&);             // private copy constructor
   BufferMgr& operator=(const BufferMgr&);  // private assignment
   void removeSegment(BufferList::iterator& seg_it);
+  void addUsedPages(const size_t num_pages);
+  void detachBuffer(BufferList::iterator seg_it);
+  void freeDetachedBuffers();
   BufferList::iterator findFreeBufferInSlab(const size_t slab_num,
                                             const size_t num_pages_requested);
   int getBufferId();
+  /// Returns the NUMA node whose slabs are searched first for free segments, or -1.
+  virtual int32_t getPreferredNumaNode() const { return -1; }
   virtual void addSlab(const size_t slab_size) = 0;
   virtual void freeAllMem() = 0;
   virtual void allocateBuffer(BufferList::iterator seg_it,
@@ -201,8 +220,13 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   std::mutex global_mutex_;
 
   std::map<ChunkKey, BufferList::iterator> chunk_index_;
+  // keys of the pinned buffers that were replaced or deleted while in use
+  std::list<ChunkKey> detached_buffer_keys_;
   size_t max_buffer_pool_num_pages_;  // max number of pages for buffer pool
   size_t num_pages_allocated_;
+  // pages of the slabs in use by buffers, now and at most
+  std::atomic<size_t> num_pages_used_{0};
+  std::atomic<size_t> max_num_pages_used_{0};
   size_t min_num_pages_per_slab_;
   size_t max_num_pages_per_slab_;
   size_t current_max_slab_page_size_;
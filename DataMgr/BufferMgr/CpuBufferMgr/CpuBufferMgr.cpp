@@ -20,6 +20,78 @@
 #include "DataMgr/Allocators/ArenaAllocator.h"
 #include "DataMgr/BufferMgr/CpuBufferMgr/CpuBuffer.h"
 
+#include <fstream>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+bool g_enable_numa_aware_cpu_buffer_pool{false};
+
+namespace {
+
+// Returns the number of NUMA nodes of the host, 1 if it cannot be determined.
+int32_t get_numa_node_count() {
+  static const int32_t numa_node_count = [] {
+    // the online nodes are listed as ranges, e.g. "0-1" or "0,2-3"
+    std::ifstream online_nodes("/sys/devices/system/node/online");
+    std::string node_list;
+    if (!(online_nodes >> node_list) || node_list.empty()) {
+      return 1;
+    }
+    try {
+      return std::stoi(node_list.substr(node_list.find_last_of("-,") + 1)) + 1;
+    } catch (const std::exception&) {
+      return 1;
+    }
+  }();
+  return numa_node_count;
+}
+
+int32_t get_current_numa_node() {
+#ifdef __linux__
+  unsigned cpu{0};
+  unsigned numa_node{0};
+  if (syscall(SYS_getcpu, &cpu, &numa_node, nullptr) == 0) {
+    return static_cast<int32_t>(numa_node);
+  }
+#endif
+  return -1;
+}
+
+// Asks the OS to place the pages of the slab on the given NUMA node, moving those
+// already touched. The node is only preferred, so that the slab spills over to the
+// other nodes instead of failing once the node runs out of memory.
+bool place_on_numa_node(int8_t* slab, const size_t slab_size, const int32_t numa_node) {
+#ifdef __linux__
+  unsigned long node_mask{0};
+  if (numa_node < 0 || numa_node >= static_cast<int32_t>(8 * sizeof(node_mask))) {
+    return false;
+  }
+  node_mask = 1UL << numa_node;
+  const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const auto slab_begin = reinterpret_cast<uintptr_t>(slab);
+  const auto begin = (slab_begin + page_size - 1) / page_size * page_size;
+  const auto end = (slab_begin + slab_size) / page_size * page_size;
+  if (begin >= end) {
+    return false;
+  }
+  return syscall(SYS_mbind,
+                 begin,
+                 end - begin,
+                 MPOL_PREFERRED,
+                 &node_mask,
+                 8 * sizeof(node_mask) + 1,
+                 MPOL_MF_MOVE) == 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
 namespace Buffer_Namespace {
 
 void CpuBufferMgr::addSlab(const size_t slab_size) {
@@ -31,11 +103,37 @@ void CpuBufferMgr::addSlab(const size_t slab_size) {
     slabs_.resize(slabs_.size() - 1);
     throw FailedToCreateSlab(slab_size);
   }
+  // a new slab goes to the node of the thread loading the chunk which needed it
+  auto numa_node = getPreferredNumaNode();
+  if (numa_node >= 0 && !placeSlabOnNumaNode(slabs_.back(), slab_size, numa_node)) {
+    LOG(WARNING) << "Could not place slab " << slabs_.size() - 1 << " on NUMA node "
+                 << numa_node << ".";
+    numa_node = -1;
+  }
+  slab_numa_nodes_.resize(slabs_.size(), -1);
+  slab_numa_nodes_.back() = numa_node;
   slab_segments_.resize(slab_segments_.size() + 1);
   slab_segments_[slab_segments_.size() - 1].push_back(
       BufferSeg(0, slab_size / page_size_));
 }
 
+int32_t CpuBufferMgr::getSlabNumaNode(const size_t slab_num) const {
+  return slab_num < slab_numa_nodes_.size() ? slab_numa_nodes_[slab_num] : -1;
+}
+
+int32_t CpuBufferMgr::getPreferredNumaNode() const {
+  if (!g_enable_numa_aware_cpu_buffer_pool || get_numa_node_count() < 2) {
+    return -1;
+  }
+  return get_current_numa_node();
+}
+
+bool CpuBufferMgr::placeSlabOnNumaNode(int8_t* slab,
+                                       const size_t slab_size,
+                                       const int32_t numa_node) {
+  return place_on_numa_node(slab, slab_size, numa_node);
+}
+
 void CpuBufferMgr::freeAllMem() {
   CHECK(allocator_);
   initializeMem();
@@ -57,6 +155,7 @@ void CpuBufferMgr::allocateBuffer(BufferList::iterator seg_it,
 
 void CpuBufferMgr::initializeMem() {
   allocator_.reset(new DramArena(max_slab_size_ + kArenaBlockOverhead));
+  slab_numa_nodes_.clear();
 }
 
 }  // namespace Buffer_Namespace
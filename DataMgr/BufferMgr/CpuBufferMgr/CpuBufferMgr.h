@@ -52,6 +52,8 @@ class CpuBufferMgr : public BufferMgr {
   inline MgrType getMgrType() override { return CPU_MGR; }
   inline std::string getStringMgrType() override { return ToString(CPU_MGR); }
 
+  int32_t getSlabNumaNode(const size_t slab_num) const override;
+
  protected:
   void addSlab(const size_t slab_size) override;
   void freeAllMem() override;
@@ -59,11 +61,18 @@ class CpuBufferMgr : public BufferMgr {
                       const size_t page_size,
                       const size_t initial_size) override;
   virtual void initializeMem();
+  int32_t getPreferredNumaNode() const override;
+  // Binds the memory of the slab to the NUMA node, returns false if it could not be.
+  virtual bool placeSlabOnNumaNode(int8_t* slab,
+                                   const size_t slab_size,
+                                   const int32_t numa_node);
 
   CudaMgr_Namespace::CudaMgr* cuda_mgr_;
 
  private:
   std::unique_ptr<DramArena> allocator_;
+  // NUMA node each slab is placed on, -1 if the placement is left to the OS
+  std::vector<int32_t> slab_numa_nodes_;
 };
 
 }  // namespace Buffer_Namespace
@@ -371,6 +371,7 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfoUnlocked(
 
     const auto& slab_segments = cpu_buffer->getSlabSegments();
     for (size_t slab_num = 0; slab_num < slab_segments.size(); ++slab_num) {
+      const auto numa_node = cpu_buffer->getSlabNumaNode(slab_num);
       for (auto segment : slab_segments[slab_num]) {
         MemoryData md;
         md.slabNum = slab_num;
@@ -380,6 +381,10 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfoUnlocked(
         md.memStatus = segment.mem_status;
         md.chunk_key.insert(
             md.chunk_key.end(), segment.chunk_key.begin(), segment.chunk_key.end());
+        md.numaNode = numa_node;
+        if (numa_node >= 0) {
+          mi.numaNodeNumPageAllocated[numa_node] += segment.num_pages;
+        }
         mi.nodeMemoryData.push_back(md);
       }
     }
@@ -418,6 +423,33 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfoUnlocked(
   return mem_info;
 }
 
+size_t DataMgr::getMaxBufferPoolBytesUsed(const MemoryLevel mem_level) const {
+  CHECK_NE(mem_level, MemoryLevel::DISK_LEVEL);
+  size_t max_bytes_used{0};
+  if (static_cast<size_t>(mem_level) >= bufferMgrs_.size()) {
+    return max_bytes_used;  // no GPUs
+  }
+  for (const auto buffer_mgr : bufferMgrs_[mem_level]) {
+    const auto casted_buffer_mgr = dynamic_cast<Buffer_Namespace::BufferMgr*>(buffer_mgr);
+    CHECK(casted_buffer_mgr);
+    max_bytes_used +=
+        casted_buffer_mgr->getMaxNumPagesUsed() * casted_buffer_mgr->getPageSize();
+  }
+  return max_bytes_used;
+}
+
+void DataMgr::resetMaxBufferPoolBytesUsed(const MemoryLevel mem_level) {
+  CHECK_NE(mem_level, MemoryLevel::DISK_LEVEL);
+  if (static_cast<size_t>(mem_level) >= bufferMgrs_.size()) {
+    return;
+  }
+  for (const auto buffer_mgr : bufferMgrs_[mem_level]) {
+    const auto casted_buffer_mgr = dynamic_cast<Buffer_Namespace::BufferMgr*>(buffer_mgr);
+    CHECK(casted_buffer_mgr);
+    casted_buffer_mgr->resetMaxNumPagesUsed();
+  }
+}
+
 std::string DataMgr::dumpLevel(const MemoryLevel memLevel) {
   std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
 
@@ -531,6 +563,22 @@ void DataMgr::free(AbstractBuffer* buffer) {
   bufferMgrs_[level][buffer->getDeviceId()]->free(buffer);
 }
 
+void DataMgr::replaceChunkBuffer(const ChunkKey& key, AbstractBuffer* buffer) {
+  std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+  const auto level = static_cast<int>(buffer->getType());
+  auto buffer_mgr = dynamic_cast<Buffer_Namespace::BufferMgr*>(
+      bufferMgrs_[level][buffer->getDeviceId()]);
+  CHECK(buffer_mgr);
+  buffer_mgr->replaceBuffer(key, buffer);
+}
+
+std::map<int, int32_t> DataMgr::getCpuFragmentNumaNodes(const ChunkKey& table_key) {
+  auto buffer_mgr =
+      dynamic_cast<Buffer_Namespace::BufferMgr*>(bufferMgrs_[MemoryLevel::CPU_LEVEL][0]);
+  CHECK(buffer_mgr);
+  return buffer_mgr->getFragmentNumaNodes(table_key);
+}
+
 void DataMgr::copy(AbstractBuffer* destBuffer, AbstractBuffer* srcBuffer) {
   destBuffer->write(srcBuffer->getMemoryPtr(),
                     srcBuffer->size(),
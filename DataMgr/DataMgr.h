@@ -64,6 +64,7 @@ struct MemoryData {
   uint32_t touch;
   std::vector<int32_t> chunk_key;
   Buffer_Namespace::MemStatus memStatus;
+  int32_t numaNode{-1};  // NUMA node of the slab, -1 if unknown
 };
 
 struct MemoryInfo {
@@ -72,6 +73,8 @@ struct MemoryInfo {
   size_t numPageAllocated;
   bool isAllocationCapped;
   std::vector<MemoryData> nodeMemoryData;
+  // # pages of the slabs placed on each NUMA node
+  std::map<int32_t, size_t> numaNodeNumPageAllocated;
 };
 
 //! Parse /proc/meminfo into key/value pairs.
@@ -197,6 +200,10 @@ class DataMgr {
                         const int deviceId,
                         const size_t numBytes);
   void free(AbstractBuffer* buffer);
+  // makes a buffer returned by alloc() the buffer of the chunk with the given key
+  void replaceChunkBuffer(const ChunkKey& key, AbstractBuffer* buffer);
+  // NUMA node holding most of each fragment of the table in the CPU buffer pool
+  std::map<int, int32_t> getCpuFragmentNumaNodes(const ChunkKey& table_key);
   // copies one buffer to another
   void copy(AbstractBuffer* destBuffer, AbstractBuffer* srcBuffer);
   bool isBufferOnDevice(const ChunkKey& key,
@@ -204,6 +211,10 @@ class DataMgr {
                         const int deviceId);
   std::vector<MemoryInfo> getMemoryInfo(const MemoryLevel memLevel) const;
   std::vector<MemoryInfo> getMemoryInfoUnlocked(const MemoryLevel memLevel) const;
+  // bytes of the buffer pools of a level in use at once at most since the last reset,
+  // summed over the devices of the level
+  size_t getMaxBufferPoolBytesUsed(const MemoryLevel mem_level) const;
+  void resetMaxBufferPoolBytesUsed(const MemoryLevel mem_level);
   std::string dumpLevel(const MemoryLevel memLevel);
   void clearMemory(const MemoryLevel memLevel);
 
@@ -179,6 +179,7 @@ static void sighandler(int sig) {
 #endif
 
 void FileInfo::freePage(int pageId, const bool isRolloff, int32_t epoch) {
+  fileMgr->invalidateHeaderSnapshot();
   std::lock_guard<std::mutex> lock(readWriteMutex_);
   int32_t epoch_freed_page[2] = {DELETE_CONTINGENT, epoch};
   if (isRolloff) {
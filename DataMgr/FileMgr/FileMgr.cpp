@@ -24,6 +24,7 @@
 
 #include <fcntl.h>
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <future>
 #include <string>
@@ -31,6 +32,7 @@
 #include <utility>
 #include <vector>
 
+#include <boost/crc.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/system/error_code.hpp>
@@ -42,6 +44,9 @@
 
 using namespace std;
 
+bool g_enable_file_mgr_header_snapshot{false};
+size_t g_file_mgr_header_snapshot_interval{10};
+
 namespace File_Namespace {
 
 FileMgr::FileMgr(const int32_t deviceId,
@@ -233,6 +238,327 @@ OpenFilesResult FileMgr::openFiles() {
   return result;
 }
 
+namespace {
+// Layout of the header snapshot file: magic number, CRC32 of the rest of the file, table
+// key and checkpointed epoch, then the page size, page count and free pages of every
+// data file, followed by the header (chunk key, page id, version epoch and page) of
+// every used page.
+constexpr char kHeaderSnapshotMagic[] = "HDBHSNP1";
+constexpr size_t kHeaderSnapshotMagicSize{sizeof(kHeaderSnapshotMagic) - 1};
+constexpr size_t kHeaderSnapshotPayloadOffset{kHeaderSnapshotMagicSize +
+                                              sizeof(uint32_t)};
+
+template <typename T>
+void append_to_header_snapshot(std::vector<char>& buffer, const T value) {
+  const auto bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+uint32_t get_header_snapshot_checksum(const std::vector<char>& buffer) {
+  boost::crc_32_type crc;
+  crc.process_bytes(buffer.data() + kHeaderSnapshotPayloadOffset,
+                    buffer.size() - kHeaderSnapshotPayloadOffset);
+  return crc.checksum();
+}
+
+class HeaderSnapshotReader {
+ public:
+  HeaderSnapshotReader(const std::vector<char>& buffer)
+      : buffer_(buffer), offset_(kHeaderSnapshotPayloadOffset) {}
+
+  template <typename T>
+  bool read(T& value) {
+    if (offset_ + sizeof(T) > buffer_.size()) {
+      return false;
+    }
+    std::memcpy(&value, buffer_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  size_t remainingBytes() const { return buffer_.size() - offset_; }
+
+ private:
+  const std::vector<char>& buffer_;
+  size_t offset_;
+};
+
+struct HeaderSnapshotFile {
+  int32_t file_id;
+  uint64_t page_size;
+  uint64_t num_pages;
+  std::vector<size_t> free_pages;
+};
+}  // namespace
+
+bool FileMgr::openFilesFromHeaderSnapshot(OpenFilesResult& result) {
+  if (!g_enable_file_mgr_header_snapshot || !hasFileMgrKey()) {
+    return false;
+  }
+  const auto snapshot_path = getFilePath(HEADER_SNAPSHOT_FILENAME);
+  if (!boost::filesystem::exists(snapshot_path)) {
+    return false;
+  }
+  auto clock_begin = timer_start();
+  std::vector<char> buffer;
+  {
+    std::ifstream snapshot_file(snapshot_path.string(), std::ios::binary);
+    buffer.assign(std::istreambuf_iterator<char>(snapshot_file),
+                  std::istreambuf_iterator<char>());
+  }
+  auto reject = [this](const std::string& reason) {
+    LOG(INFO) << "Not using the header snapshot of " << describeSelf() << ": " << reason;
+    return false;
+  };
+  if (buffer.size() < kHeaderSnapshotPayloadOffset ||
+      std::memcmp(buffer.data(), kHeaderSnapshotMagic, kHeaderSnapshotMagicSize) != 0) {
+    return reject("invalid file");
+  }
+  uint32_t checksum;
+  std::memcpy(&checksum, buffer.data() + kHeaderSnapshotMagicSize, sizeof(checksum));
+  if (checksum != get_header_snapshot_checksum(buffer)) {
+    return reject("checksum mismatch");
+  }
+
+  HeaderSnapshotReader reader(buffer);
+  int32_t db_id, tb_id, snapshot_epoch;
+  if (!reader.read(db_id) || !reader.read(tb_id) || !reader.read(snapshot_epoch)) {
+    return reject("truncated file");
+  }
+  if (db_id != fileMgrKey_.first || tb_id != fileMgrKey_.second) {
+    return reject("snapshot of another table");
+  }
+  // The snapshot is invalidated before any page header changes, so checkpoints taken
+  // after it without rewriting it did not modify any page header.
+  if (snapshot_epoch > lastCheckpointedEpoch()) {
+    return reject("snapshot epoch " + std::to_string(snapshot_epoch) +
+                  " is ahead of the checkpointed epoch " +
+                  std::to_string(lastCheckpointedEpoch()));
+  }
+
+  // The snapshot is only valid for exactly the set of data files it was taken from.
+  std::map<int32_t, FileMetadata> data_files;
+  boost::filesystem::directory_iterator end_itr;
+  for (boost::filesystem::directory_iterator file_it(fileMgrBasePath_);
+       file_it != end_itr;
+       ++file_it) {
+    if (is_compaction_status_file(file_it->path().filename().string())) {
+      return reject("pending data compaction");
+    }
+    FileMetadata file_metadata = getMetadataForFile(file_it);
+    if (file_metadata.is_data_file) {
+      data_files.emplace(file_metadata.file_id, file_metadata);
+    }
+  }
+  uint64_t file_count;
+  if (!reader.read(file_count) || file_count != data_files.size()) {
+    return reject("data files do not match");
+  }
+  std::vector<HeaderSnapshotFile> snapshot_files(file_count);
+  for (auto& snapshot_file : snapshot_files) {
+    uint64_t free_page_count;
+    if (!reader.read(snapshot_file.file_id) || !reader.read(snapshot_file.page_size) ||
+        !reader.read(snapshot_file.num_pages) || !reader.read(free_page_count) ||
+        free_page_count > snapshot_file.num_pages) {
+      return reject("truncated file");
+    }
+    auto it = data_files.find(snapshot_file.file_id);
+    if (it == data_files.end() || it->second.page_size != snapshot_file.page_size ||
+        it->second.num_pages != snapshot_file.num_pages) {
+      return reject("data files do not match");
+    }
+    snapshot_file.free_pages.resize(free_page_count);
+    for (auto& page_num : snapshot_file.free_pages) {
+      uint64_t free_page;
+      if (!reader.read(free_page) || free_page >= snapshot_file.num_pages) {
+        return reject("invalid free page");
+      }
+      page_num = free_page;
+    }
+  }
+  uint64_t header_count;
+  if (!reader.read(header_count)) {
+    return reject("truncated file");
+  }
+  std::vector<HeaderInfo> header_infos;
+  header_infos.reserve(std::min<uint64_t>(header_count, reader.remainingBytes()));
+  for (uint64_t i = 0; i < header_count; ++i) {
+    int32_t key_size;
+    if (!reader.read(key_size) || key_size < CHUNK_KEY_VARLEN_IDX ||
+        key_size > CHUNK_KEY_VARLEN_IDX + 1) {
+      return reject("invalid chunk key");
+    }
+    ChunkKey chunk_key(key_size);
+    for (auto& key_part : chunk_key) {
+      if (!reader.read(key_part)) {
+        return reject("truncated file");
+      }
+    }
+    int32_t page_id, version_epoch, file_id;
+    uint64_t page_num;
+    if (!reader.read(page_id) || !reader.read(version_epoch) || !reader.read(file_id) ||
+        !reader.read(page_num)) {
+      return reject("truncated file");
+    }
+    auto it = data_files.find(file_id);
+    if (it == data_files.end() || page_num >= it->second.num_pages) {
+      return reject("invalid page");
+    }
+    header_infos.emplace_back(chunk_key, page_id, version_epoch, Page(file_id, page_num));
+  }
+  if (reader.remainingBytes() != 0) {
+    return reject("trailing data");
+  }
+
+  for (const auto& snapshot_file : snapshot_files) {
+    const auto& file_metadata = data_files.at(snapshot_file.file_id);
+    FILE* f = open(file_metadata.file_path);
+    auto file_info = new FileInfo(this,
+                                  snapshot_file.file_id,
+                                  f,
+                                  snapshot_file.page_size,
+                                  snapshot_file.num_pages,
+                                  false);  // false means don't init file
+    file_info->freePages.insert(snapshot_file.free_pages.begin(),
+                                snapshot_file.free_pages.end());
+    mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
+    files_[snapshot_file.file_id] = file_info;
+    fileIndex_.insert(std::pair<size_t, int32_t>(snapshot_file.page_size,
+                                                 snapshot_file.file_id));
+  }
+  result.header_infos = std::move(header_infos);
+  result.max_file_id = data_files.empty() ? -1 : data_files.rbegin()->first;
+
+  int64_t queue_time_ms = timer_stop(clock_begin);
+  LOG(INFO) << "Completed reading table's file metadata from header snapshot, Elapsed "
+            << "time : " << queue_time_ms << "ms Epoch: " << epoch_.ceiling()
+            << " files: " << file_count << " table location: '" << fileMgrBasePath_
+            << "'";
+  return true;
+}
+
+void FileMgr::writeHeaderSnapshot() {
+  if (!g_enable_file_mgr_header_snapshot || g_read_only || !hasFileMgrKey()) {
+    return;
+  }
+  auto clock_begin = timer_start();
+  mapd_shared_lock<mapd_shared_mutex> chunk_index_read_lock(chunkIndexMutex_);
+  std::lock_guard<std::mutex> header_snapshot_lock(header_snapshot_mutex_);
+  if (has_valid_header_snapshot_) {
+    // No page header changed since the snapshot was written, it is still up to date.
+    return;
+  }
+  if (checkpoints_until_header_snapshot_ > 0) {
+    checkpoints_until_header_snapshot_--;
+    return;
+  }
+  std::vector<char> buffer(kHeaderSnapshotMagic,
+                           kHeaderSnapshotMagic + kHeaderSnapshotMagicSize);
+  append_to_header_snapshot<uint32_t>(buffer, 0);  // checksum, set below
+  append_to_header_snapshot<int32_t>(buffer, fileMgrKey_.first);
+  append_to_header_snapshot<int32_t>(buffer, fileMgrKey_.second);
+  append_to_header_snapshot<int32_t>(buffer, lastCheckpointedEpoch());
+  {
+    mapd_shared_lock<mapd_shared_mutex> files_read_lock(files_rw_mutex_);
+    append_to_header_snapshot<uint64_t>(buffer, files_.size());
+    for (const auto& [file_id, file_info] : files_) {
+      append_to_header_snapshot<int32_t>(buffer, file_id);
+      append_to_header_snapshot<uint64_t>(buffer, file_info->pageSize);
+      append_to_header_snapshot<uint64_t>(buffer, file_info->numPages);
+      std::lock_guard<std::mutex> free_pages_lock(file_info->freePagesMutex_);
+      append_to_header_snapshot<uint64_t>(buffer, file_info->freePages.size());
+      for (const auto page_num : file_info->freePages) {
+        append_to_header_snapshot<uint64_t>(buffer, page_num);
+      }
+    }
+  }
+  const auto header_count_offset = buffer.size();
+  uint64_t header_count{0};
+  append_to_header_snapshot<uint64_t>(buffer, header_count);
+  auto append_header = [&buffer, &header_count](const ChunkKey& chunk_key,
+                                                const int32_t page_id,
+                                                const EpochedPage& epoched_page) {
+    append_to_header_snapshot<int32_t>(buffer, chunk_key.size());
+    for (const auto key_part : chunk_key) {
+      append_to_header_snapshot<int32_t>(buffer, key_part);
+    }
+    append_to_header_snapshot<int32_t>(buffer, page_id);
+    append_to_header_snapshot<int32_t>(buffer, epoched_page.epoch);
+    append_to_header_snapshot<int32_t>(buffer, epoched_page.page.fileId);
+    append_to_header_snapshot<uint64_t>(buffer, epoched_page.page.pageNum);
+    header_count++;
+  };
+  for (const auto& [chunk_key, file_buffer] : chunkIndex_) {
+    for (const auto& epoched_page : file_buffer->metadataPages_.pageVersions) {
+      append_header(chunk_key, -1, epoched_page);
+    }
+    for (size_t page_id = 0; page_id < file_buffer->multiPages_.size(); ++page_id) {
+      for (const auto& epoched_page : file_buffer->multiPages_[page_id].pageVersions) {
+        append_header(chunk_key, page_id, epoched_page);
+      }
+    }
+  }
+  std::memcpy(buffer.data() + header_count_offset, &header_count, sizeof(header_count));
+  const auto checksum = get_header_snapshot_checksum(buffer);
+  std::memcpy(buffer.data() + kHeaderSnapshotMagicSize, &checksum, sizeof(checksum));
+
+  // Written to a temporary file first, so that a crash cannot leave a partial snapshot.
+  const auto snapshot_path = getFilePath(HEADER_SNAPSHOT_FILENAME);
+  const auto temp_snapshot_path = snapshot_path.string() + ".tmp";
+  FILE* f = heavyai::fopen(temp_snapshot_path.c_str(), "wb");
+  if (!f) {
+    LOG(WARNING) << "Unable to create header snapshot file '" << temp_snapshot_path
+                 << "': " << std::strerror(errno);
+    return;
+  }
+  const bool written = fwrite(buffer.data(), 1, buffer.size(), f) == buffer.size() &&
+                       fflush(f) == 0 && heavyai::fsync(fileno(f)) == 0;
+  fclose(f);
+  boost::system::error_code ec;
+  if (written) {
+    boost::filesystem::rename(temp_snapshot_path, snapshot_path, ec);
+  }
+  if (!written || ec) {
+    LOG(WARNING) << "Unable to write header snapshot file '" << snapshot_path << "'";
+    boost::filesystem::remove(temp_snapshot_path, ec);
+    return;
+  }
+  has_valid_header_snapshot_ = true;
+  header_snapshot_write_count_++;
+  checkpoints_until_header_snapshot_ =
+      std::max<size_t>(g_file_mgr_header_snapshot_interval, 1) - 1;
+  VLOG(2) << "Wrote header snapshot of " << describeSelf() << " with " << header_count
+          << " page headers in " << timer_stop(clock_begin) << "ms";
+}
+
+void FileMgr::invalidateHeaderSnapshot() {
+  std::lock_guard<std::mutex> header_snapshot_lock(header_snapshot_mutex_);
+  if (!has_valid_header_snapshot_) {
+    return;
+  }
+  invalidateHeaderSnapshotFile();
+  has_valid_header_snapshot_ = false;
+}
+
+void FileMgr::invalidateHeaderSnapshotFile() {
+  if (g_read_only || !hasFileMgrKey()) {
+    return;
+  }
+  const auto snapshot_path = getFilePath(HEADER_SNAPSHOT_FILENAME);
+  if (!boost::filesystem::exists(snapshot_path)) {
+    return;
+  }
+  // Clear the magic number and sync before removing the file, a removal that was not
+  // persisted before a crash must not bring back a stale snapshot.
+  FILE* f = open(snapshot_path.string());
+  const char cleared_magic[kHeaderSnapshotMagicSize]{};
+  write(f, 0, kHeaderSnapshotMagicSize, reinterpret_cast<const int8_t*>(cleared_magic));
+  CHECK_EQ(fflush(f), 0) << "Could not flush header snapshot file to disk";
+  CHECK_EQ(heavyai::fsync(fileno(f)), 0) << "Could not sync header snapshot file to disk";
+  close(f);
+  boost::filesystem::remove(snapshot_path);
+}
+
 void FileMgr::clearFileInfos() {
   for (auto file_info_entry : files_) {
     auto file_info = file_info_entry.second;
@@ -255,12 +581,20 @@ void FileMgr::init(const size_t num_reader_threads, const int32_t epochOverride)
       setEpoch(epochOverride);
     }
 
-    auto open_files_result = openFiles();
-    if (!open_files_result.compaction_status_file_name.empty()) {
-      resumeFileCompaction(open_files_result.compaction_status_file_name);
-      clearFileInfos();
+    OpenFilesResult open_files_result;
+    if (epochOverride == -1 && openFilesFromHeaderSnapshot(open_files_result)) {
+      initialized_from_header_snapshot_ = true;
+      has_valid_header_snapshot_ = true;
+    } else {
+      // page headers may be modified below, any existing snapshot is stale from now on
+      invalidateHeaderSnapshotFile();
       open_files_result = openFiles();
-      CHECK(open_files_result.compaction_status_file_name.empty());
+      if (!open_files_result.compaction_status_file_name.empty()) {
+        resumeFileCompaction(open_files_result.compaction_status_file_name);
+        clearFileInfos();
+        open_files_result = openFiles();
+        CHECK(open_files_result.compaction_status_file_name.empty());
+      }
     }
 
     /* Sort headerVec so that all HeaderInfos
@@ -699,6 +1033,7 @@ void FileMgr::checkpoint() {
   writeAndSyncEpochToDisk();
   incrementEpoch();
   freePages();
+  writeHeaderSnapshot();
 }
 
 FileBuffer* FileMgr::createBuffer(const ChunkKey& key,
@@ -864,6 +1199,7 @@ void FileMgr::free(AbstractBuffer* buffer) {
 }
 
 Page FileMgr::requestFreePage(size_t pageSize, const bool isMetadata) {
+  invalidateHeaderSnapshot();
   std::lock_guard<std::mutex> lock(getPageMutex_);
 
   auto candidateFiles = fileIndex_.equal_range(pageSize);
@@ -893,6 +1229,7 @@ void FileMgr::requestFreePages(size_t numPagesRequested,
                                const bool isMetadata) {
   // not used currently
   // @todo add method to FileInfo to get more than one page
+  invalidateHeaderSnapshot();
   std::lock_guard<std::mutex> lock(getPageMutex_);
   auto candidateFiles = fileIndex_.equal_range(pageSize);
   size_t numPagesNeeded = numPagesRequested;
@@ -1248,6 +1585,7 @@ void FileMgr::resumeFileCompaction(const std::string& status_file_name) {
  * Delete status file.
  */
 void FileMgr::compactFiles() {
+  invalidateHeaderSnapshot();
   mapd_unique_lock<mapd_shared_mutex> write_lock(files_rw_mutex_);
   if (files_.empty()) {
     return;
@@ -43,6 +43,9 @@
 
 using namespace Data_Namespace;
 
+extern bool g_enable_file_mgr_header_snapshot;
+extern size_t g_file_mgr_header_snapshot_interval;
+
 namespace boost {
 namespace filesystem {
 class directory_iterator;
@@ -351,6 +354,23 @@ class FileMgr : public AbstractBufferMgr {  // implements
 
   void compactFiles();
 
+  /**
+   * @brief Discards the page header snapshot written at the last checkpoint. Must be
+   * called before any page header is modified, since the snapshot would otherwise no
+   * longer reflect the page headers on disk.
+   **/
+  void invalidateHeaderSnapshot();
+
+  // Visible for use in unit tests.
+  inline bool isInitializedFromHeaderSnapshot() const {
+    return initialized_from_header_snapshot_;
+  }
+
+  // Visible for use in unit tests.
+  inline size_t getHeaderSnapshotWriteCount() const {
+    return header_snapshot_write_count_;
+  }
+
   /**
    * @brief deletes or recovers a page based on last checkpointed epoch.
    **/
@@ -387,6 +407,7 @@ class FileMgr : public AbstractBufferMgr {  // implements
   static constexpr char EPOCH_FILENAME[] = "epoch_metadata";
   static constexpr char DB_META_FILENAME[] = "dbmeta";
   static constexpr char FILE_MGR_VERSION_FILENAME[] = "filemgr_version";
+  static constexpr char HEADER_SNAPSHOT_FILENAME[] = "header_snapshot";
   static constexpr int32_t INVALID_VERSION = -1;
 
  protected:
@@ -464,6 +485,9 @@ class FileMgr : public AbstractBufferMgr {  // implements
   void migrateLegacyFilesV1();
 
   OpenFilesResult openFiles();
+  bool openFilesFromHeaderSnapshot(OpenFilesResult& result);
+  void writeHeaderSnapshot();
+  void invalidateHeaderSnapshotFile();
 
   void clearFileInfos();
 
@@ -527,6 +551,14 @@ class FileMgr : public AbstractBufferMgr {  // implements
   Epoch epoch_;
   bool epochIsCheckpointed_ = true;
   FILE* epochFile_ = nullptr;
+
+  std::mutex header_snapshot_mutex_;
+  bool has_valid_header_snapshot_{false};
+  bool initialized_from_header_snapshot_{false};
+  // Number of checkpoints modifying page headers that are still to be taken before the
+  // snapshot is written again, bounding the cost of snapshots under frequent writes.
+  size_t checkpoints_until_header_snapshot_{0};
+  size_t header_snapshot_write_count_{0};
 };
 
 }  // namespace File_Namespace
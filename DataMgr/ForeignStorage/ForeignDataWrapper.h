@@ -18,9 +18,11 @@
 
 #include "DataMgr/ChunkMetadata.h"
 #include "ForeignStorageBuffer.h"
+#include "Shared/sqldefs.h"
 #include "Shared/types.h"
 
 #include <map>
+#include <variant>
 
 struct ColumnDescriptor;
 namespace import_export {
@@ -36,6 +38,21 @@ using ChunkToBufferMap = std::map<ChunkKey, AbstractBuffer*>;
 using RenderGroupAnalyzerMap =
     std::map<int, std::unique_ptr<import_export::RenderGroupAnalyzer>>;
 
+/**
+ * A simple query qualifier of the form `column <op> literal`, pushed down to data
+ * wrappers. Integer literals are compared against integer columns, floating point
+ * literals against floating point columns and string literals against (dictionary
+ * encoded) text columns.
+ */
+struct ColumnFilter {
+  int column_id;
+  SQLOps op;
+  std::variant<int64_t, double, std::string> literal;
+};
+
+// Qualifiers that all have to hold for a row to be selected by a query.
+using ColumnFilters = std::vector<ColumnFilter>;
+
 class ForeignDataWrapper {
  public:
   ForeignDataWrapper() = default;
@@ -66,6 +83,22 @@ class ForeignDataWrapper {
                                     const ChunkToBufferMap& optional_buffers,
                                     AbstractBuffer* delete_buffer = nullptr) = 0;
 
+  /**
+   * Checks if the data wrapper can determine, typically from statistics kept in the
+   * source files, that no row of the given fragment satisfies the given filters. Such
+   * fragments are skipped by the executor without fetching any of their chunks.
+   *
+   * Chunk buffers are cached and shared across queries, so filters may only be used to
+   * skip whole fragments and never to change the content of populated buffers.
+   *
+   * @param fragment_id - id of the fragment to check
+   * @param filters - conjunctive filters on the columns of the foreign table
+   */
+  virtual bool canSkipFragment(const int fragment_id,
+                               const ColumnFilters& filters) const {
+    return false;
+  }
+
   /**
    * Serialize internal state of wrapper into file at given path if implemented
    */
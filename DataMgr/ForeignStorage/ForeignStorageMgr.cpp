@@ -280,6 +280,28 @@ std::shared_ptr<ForeignDataWrapper> ForeignStorageMgr::getDataWrapper(
   return data_wrapper_map_.at(table_key);
 }
 
+bool ForeignStorageMgr::canSkipFragment(const ChunkKey& table_key,
+                                        const int fragment_id,
+                                        const ColumnFilters& filters) const {
+  CHECK(is_table_key(table_key));
+  std::shared_ptr<ForeignDataWrapper> data_wrapper;
+  {
+    std::shared_lock data_wrapper_lock(data_wrapper_mutex_);
+    auto it = data_wrapper_map_.find(table_key);
+    if (it == data_wrapper_map_.end()) {
+      return false;
+    }
+    data_wrapper = it->second;
+  }
+  // Checking the filters may require reads from the source files, which should not
+  // block the creation or removal of other data wrappers
+  if (data_wrapper->canSkipFragment(fragment_id, filters)) {
+    skipped_fragment_count_++;
+    return true;
+  }
+  return false;
+}
+
 void ForeignStorageMgr::setDataWrapper(
     const ChunkKey& table_key,
     std::shared_ptr<MockForeignDataWrapper> data_wrapper) {
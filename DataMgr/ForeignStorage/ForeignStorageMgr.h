@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <shared_mutex>
 
 #include "DataMgr/AbstractBufferMgr.h"
@@ -122,6 +123,18 @@ class ForeignStorageMgr : public AbstractBufferMgr {
                       std::shared_ptr<MockForeignDataWrapper> data_wrapper);
   std::shared_ptr<ForeignDataWrapper> getDataWrapper(const ChunkKey& chunk_key) const;
 
+  /*
+    Checks if the data wrapper of the table can rule out that any row of the given
+    fragment satisfies the given filters. Returns false if no data wrapper exists for the
+    table yet.
+   */
+  bool canSkipFragment(const ChunkKey& table_key,
+                       const int fragment_id,
+                       const ColumnFilters& filters) const;
+
+  // Number of fragments ruled out by canSkipFragment so far
+  size_t getSkippedFragmentCount() const { return skipped_fragment_count_; }
+
   virtual void refreshTable(const ChunkKey& table_key, const bool evict_cached_entries);
 
   using ParallelismHint = std::pair<int, int>;
@@ -169,6 +182,8 @@ class ForeignStorageMgr : public AbstractBufferMgr {
 
   mutable std::shared_mutex parallelism_hints_mutex_;
   std::map<ChunkKey, std::set<ParallelismHint>> parallelism_hints_per_table_;
+
+  mutable std::atomic<size_t> skipped_fragment_count_{0};
 };
 
 std::vector<ChunkKey> get_column_key_vec(const ChunkKey& destination_chunk_key);
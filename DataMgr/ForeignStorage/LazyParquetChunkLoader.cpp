@@ -19,6 +19,7 @@
 #include <arrow/api.h>
 #include <arrow/io/api.h>
 #include <parquet/arrow/reader.h>
+#include <parquet/column_page.h>
 #include <parquet/column_scanner.h>
 #include <parquet/exception.h>
 #include <parquet/platform.h>
@@ -1778,6 +1779,172 @@ std::map<int, std::shared_ptr<ParquetEncoder>> populate_encoder_map_for_metadata
   }
   return encoder_map;
 }
+
+// Checks if no value in the range [min, max] satisfies `value <op> literal`.
+template <typename T>
+bool is_range_excluded_by_filter(const T& min,
+                                 const T& max,
+                                 const SQLOps op,
+                                 const T& literal) {
+  switch (op) {
+    case kEQ:
+      return literal < min || max < literal;
+    case kLT:
+      return !(min < literal);
+    case kLE:
+      return literal < min;
+    case kGT:
+      return !(literal < max);
+    case kGE:
+      return max < literal;
+    default:
+      return false;
+  }
+}
+
+bool is_filterable_integer_column(const ColumnDescriptor* omnisci_column,
+                                  const parquet::ColumnDescriptor* parquet_column) {
+  const auto physical_type = parquet_column->physical_type();
+  if (!omnisci_column->columnType.is_integer() ||
+      (physical_type != parquet::Type::INT32 && physical_type != parquet::Type::INT64)) {
+    return false;
+  }
+  if (parquet_column->logical_type()->is_none()) {
+    return true;
+  }
+  // statistics of unsigned integers are ordered as unsigned values
+  auto int_logical_column =
+      dynamic_cast<const parquet::IntLogicalType*>(parquet_column->logical_type().get());
+  return int_logical_column && int_logical_column->is_signed();
+}
+
+bool is_filterable_fp_column(const ColumnDescriptor* omnisci_column,
+                             const parquet::ColumnDescriptor* parquet_column) {
+  const auto physical_type = parquet_column->physical_type();
+  return omnisci_column->columnType.is_fp() &&
+         parquet_column->logical_type()->is_none() &&
+         (physical_type == parquet::Type::FLOAT ||
+          physical_type == parquet::Type::DOUBLE);
+}
+
+bool is_filterable_string_column(const ColumnDescriptor* omnisci_column,
+                                 const parquet::ColumnDescriptor* parquet_column) {
+  return omnisci_column->columnType.is_string() &&
+         is_valid_parquet_string(parquet_column);
+}
+
+bool is_column_chunk_excluded_by_statistics(
+    const ColumnDescriptor* omnisci_column,
+    const parquet::ColumnDescriptor* parquet_column,
+    const parquet::ColumnChunkMetaData* column_chunk,
+    const ColumnFilter& filter) {
+  if (!column_chunk->is_stats_set()) {
+    return false;
+  }
+  const auto stats = column_chunk->statistics();
+  // nulls never satisfy a comparison
+  if (stats->HasNullCount() && stats->null_count() == column_chunk->num_values()) {
+    return true;
+  }
+  if (!stats->HasMinMax()) {
+    return false;
+  }
+  const auto physical_type = parquet_column->physical_type();
+  if (const auto literal = std::get_if<int64_t>(&filter.literal)) {
+    if (!is_filterable_integer_column(omnisci_column, parquet_column)) {
+      return false;
+    }
+    if (physical_type == parquet::Type::INT32) {
+      const auto typed_stats = std::static_pointer_cast<parquet::Int32Statistics>(stats);
+      return is_range_excluded_by_filter<int64_t>(
+          typed_stats->min(), typed_stats->max(), filter.op, *literal);
+    }
+    const auto typed_stats = std::static_pointer_cast<parquet::Int64Statistics>(stats);
+    return is_range_excluded_by_filter<int64_t>(
+        typed_stats->min(), typed_stats->max(), filter.op, *literal);
+  }
+  if (const auto literal = std::get_if<double>(&filter.literal)) {
+    if (!is_filterable_fp_column(omnisci_column, parquet_column)) {
+      return false;
+    }
+    if (physical_type == parquet::Type::FLOAT) {
+      const auto typed_stats = std::static_pointer_cast<parquet::FloatStatistics>(stats);
+      return is_range_excluded_by_filter<double>(
+          typed_stats->min(), typed_stats->max(), filter.op, *literal);
+    }
+    const auto typed_stats = std::static_pointer_cast<parquet::DoubleStatistics>(stats);
+    return is_range_excluded_by_filter<double>(
+        typed_stats->min(), typed_stats->max(), filter.op, *literal);
+  }
+  if (const auto literal = std::get_if<std::string>(&filter.literal)) {
+    if (!is_filterable_string_column(omnisci_column, parquet_column)) {
+      return false;
+    }
+    // string statistics are ordered bytewise, which matches std::string comparisons
+    const auto typed_stats =
+        std::static_pointer_cast<parquet::ByteArrayStatistics>(stats);
+    return is_range_excluded_by_filter<std::string>(
+        parquet::ByteArrayToString(typed_stats->min()),
+        parquet::ByteArrayToString(typed_stats->max()),
+        filter.op,
+        *literal);
+  }
+  return false;
+}
+
+bool is_fully_dictionary_encoded(const parquet::ColumnChunkMetaData* column_chunk) {
+  if (!column_chunk->has_dictionary_page()) {
+    return false;
+  }
+  // writers are not required to record encoding statistics, without them a fallback to
+  // plain encoding in some of the data pages can not be ruled out
+  const auto encoding_stats = column_chunk->encoding_stats();
+  if (encoding_stats.empty()) {
+    return false;
+  }
+  for (const auto& page_encoding_stats : encoding_stats) {
+    if (page_encoding_stats.page_type != parquet::PageType::DICTIONARY_PAGE &&
+        page_encoding_stats.encoding != parquet::Encoding::PLAIN_DICTIONARY &&
+        page_encoding_stats.encoding != parquet::Encoding::RLE_DICTIONARY) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool dictionary_page_contains(parquet::RowGroupReader* row_group_reader,
+                              const int parquet_column_index,
+                              const std::string& value) {
+  auto page_reader = row_group_reader->GetColumnPageReader(parquet_column_index);
+  const auto page = page_reader->NextPage();
+  if (!page || page->type() != parquet::PageType::DICTIONARY_PAGE) {
+    return true;
+  }
+  const auto dictionary_page = std::static_pointer_cast<parquet::DictionaryPage>(page);
+  if (dictionary_page->encoding() != parquet::Encoding::PLAIN &&
+      dictionary_page->encoding() != parquet::Encoding::PLAIN_DICTIONARY) {
+    return true;
+  }
+  // dictionary values are plain encoded byte arrays, each prefixed by its length
+  const uint8_t* data = dictionary_page->data();
+  const uint8_t* data_end = data + dictionary_page->size();
+  for (int32_t i = 0; i < dictionary_page->num_values(); ++i) {
+    uint32_t length;
+    if (static_cast<size_t>(data_end - data) < sizeof(length)) {
+      return true;
+    }
+    std::memcpy(&length, data, sizeof(length));
+    data += sizeof(length);
+    if (static_cast<size_t>(data_end - data) < length) {
+      return true;
+    }
+    if (length == value.size() && std::memcmp(data, value.data(), length) == 0) {
+      return true;
+    }
+    data += length;
+  }
+  return false;
+}
 }  // namespace
 
 std::list<std::unique_ptr<ChunkMetadata>> LazyParquetChunkLoader::appendRowGroups(
@@ -2470,4 +2637,47 @@ std::list<RowGroupMetadata> LazyParquetChunkLoader::metadataScan(
   return row_group_metadata;
 }
 
+bool LazyParquetChunkLoader::canSkipRowGroups(
+    const std::vector<RowGroupInterval>& row_group_intervals,
+    const ColumnFilters& filters,
+    const ForeignTableSchema& schema) {
+  for (const auto& row_group_interval : row_group_intervals) {
+    auto reader =
+        file_reader_cache_->getOrInsert(row_group_interval.file_path, file_system_);
+    auto file_metadata = reader->parquet_reader()->metadata();
+    for (int row_group_index = row_group_interval.start_index;
+         row_group_index <= row_group_interval.end_index;
+         ++row_group_index) {
+      auto group_metadata = file_metadata->RowGroup(row_group_index);
+      bool is_excluded = group_metadata->num_rows() == 0;
+      for (auto filter_it = filters.begin(); !is_excluded && filter_it != filters.end();
+           ++filter_it) {
+        const auto omnisci_column = schema.getColumnDescriptor(filter_it->column_id);
+        if (omnisci_column->columnType.is_array()) {
+          continue;
+        }
+        const auto parquet_column_index =
+            schema.getParquetColumnIndex(filter_it->column_id);
+        const auto parquet_column = file_metadata->schema()->Column(parquet_column_index);
+        auto column_chunk = group_metadata->ColumnChunk(parquet_column_index);
+        if (is_column_chunk_excluded_by_statistics(
+                omnisci_column, parquet_column, column_chunk.get(), *filter_it)) {
+          is_excluded = true;
+        } else if (const auto literal = std::get_if<std::string>(&filter_it->literal);
+                   literal && filter_it->op == kEQ &&
+                   is_filterable_string_column(omnisci_column, parquet_column) &&
+                   is_fully_dictionary_encoded(column_chunk.get())) {
+          auto row_group_reader = reader->parquet_reader()->RowGroup(row_group_index);
+          is_excluded = !dictionary_page_contains(
+              row_group_reader.get(), parquet_column_index, *literal);
+        }
+      }
+      if (!is_excluded) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 }  // namespace foreign_storage
@@ -92,6 +92,24 @@ class LazyParquetChunkLoader {
       const ForeignTableSchema& schema,
       const bool do_metadata_stats_validation = true);
 
+  /**
+   * Determine if no row of the given row groups can satisfy all the given filters.
+   *
+   * A row group is ruled out if the statistics of one of the filtered column chunks
+   * exclude the filter literal. For equality filters on string columns whose data pages
+   * are all dictionary encoded, the dictionary page of the column chunk is checked for
+   * the literal as well.
+   *
+   * @param row_group_intervals - row groups to check
+   * @param filters - conjunctive filters on columns of the foreign table
+   * @param schema - schema of the foreign table
+   *
+   * @return true if every row group is ruled out by at least one filter
+   */
+  bool canSkipRowGroups(const std::vector<RowGroupInterval>& row_group_intervals,
+                        const ColumnFilters& filters,
+                        const ForeignTableSchema& schema);
+
   /**
    * Determine if a Parquet to OmniSci column mapping is supported.
    *
@@ -547,6 +547,17 @@ void ParquetDataWrapper::populateChunkBuffers(const ChunkToBufferMap& required_b
   }
 }
 
+bool ParquetDataWrapper::canSkipFragment(const int fragment_id,
+                                         const ColumnFilters& filters) const {
+  CHECK(schema_);
+  const auto it = fragment_to_row_group_interval_map_.find(fragment_id);
+  if (filters.empty() || it == fragment_to_row_group_interval_map_.end()) {
+    return false;
+  }
+  LazyParquetChunkLoader chunk_loader(file_system_, file_reader_cache_.get(), nullptr);
+  return chunk_loader.canSkipRowGroups(it->second, filters, *schema_);
+}
+
 void set_value(rapidjson::Value& json_val,
                const RowGroupInterval& value,
                rapidjson::Document::AllocatorType& allocator) {
@@ -57,6 +57,9 @@ class ParquetDataWrapper : public AbstractFileStorageDataWrapper {
                             const ChunkToBufferMap& optional_buffers,
                             AbstractBuffer* delete_buffer) override;
 
+  bool canSkipFragment(const int fragment_id,
+                       const ColumnFilters& filters) const override;
+
   std::string getSerializedDataWrapper() const override;
 
   void restoreDataWrapperInternals(
@@ -36,6 +36,53 @@ namespace EmbeddedDatabase {
 
 class DBEngineImpl;
 
+/**
+ * Arrow record batch reader, which converts consecutive ranges of result set entries
+ * on demand, so that only one batch is held in Arrow format at a time
+ */
+class ResultSetRecordBatchReader : public arrow::RecordBatchReader {
+ public:
+  ResultSetRecordBatchReader(std::shared_ptr<ResultSet> result_set,
+                             const std::vector<std::string>& col_names,
+                             const size_t batch_size)
+      : result_set_(result_set)
+      , converter_(result_set, col_names, -1)
+      , schema_(converter_.getArrowSchema())
+      , batch_size_(std::max(batch_size, size_t(1)))
+      , next_entry_(0) {}
+
+  std::shared_ptr<arrow::Schema> schema() const override { return schema_; }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+    batch->reset();
+    try {
+      if (result_set_->isEmpty()) {
+        return arrow::Status::OK();
+      }
+      const auto entry_count = result_set_->entryCount();
+      // entries can be empty, skip ranges without any rows
+      while (next_entry_ < entry_count && !*batch) {
+        const auto end_entry = std::min(next_entry_ + batch_size_, entry_count);
+        auto record_batch = converter_.convertToArrow(next_entry_, end_entry);
+        next_entry_ = end_entry;
+        if (record_batch->num_rows() > 0) {
+          *batch = std::move(record_batch);
+        }
+      }
+    } catch (const std::exception& e) {
+      return arrow::Status::ExecutionError(e.what());
+    }
+    return arrow::Status::OK();
+  }
+
+ private:
+  std::shared_ptr<ResultSet> result_set_;
+  ArrowResultSetConverter converter_;
+  std::shared_ptr<arrow::Schema> schema_;
+  const size_t batch_size_;
+  size_t next_entry_;
+};
+
 /**
  * Cursor internal implementation
  */
@@ -87,6 +134,15 @@ class CursorImpl : public Cursor {
     return nullptr;
   }
 
+  std::shared_ptr<arrow::RecordBatchReader> getArrowRecordBatchReader(
+      const size_t batch_size) {
+    if (!result_set_) {
+      return nullptr;
+    }
+    return std::make_shared<ResultSetRecordBatchReader>(
+        result_set_, col_names_, batch_size);
+  }
+
  private:
   std::shared_ptr<ResultSet> result_set_;
   std::vector<std::string> col_names_;
@@ -547,4 +603,10 @@ std::shared_ptr<arrow::RecordBatch> Cursor::getArrowRecordBatch() {
   CursorImpl* cursor = getImpl(this);
   return cursor->getArrowRecordBatch();
 }
+
+std::shared_ptr<arrow::RecordBatchReader> Cursor::getArrowRecordBatchReader(
+    size_t batch_size) {
+  CursorImpl* cursor = getImpl(this);
+  return cursor->getArrowRecordBatchReader(batch_size);
+}
 }  // namespace EmbeddedDatabase
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <arrow/record_batch.h>
 #include <arrow/table.h>
 #include "DBETypes.h"
 
@@ -23,12 +24,18 @@ namespace EmbeddedDatabase {
 
 class Cursor {
  public:
+  static constexpr size_t default_arrow_record_batch_size{1UL << 20};
+
   virtual ~Cursor() {}
   size_t getColCount();
   size_t getRowCount();
   Row getNextRow();
   ColumnType getColType(uint32_t col_num);
   std::shared_ptr<arrow::RecordBatch> getArrowRecordBatch();
+  // Streams the result as record batches of at most batch_size rows, which are only
+  // converted when read, instead of converting the whole result into a single batch
+  std::shared_ptr<arrow::RecordBatchReader> getArrowRecordBatchReader(
+      size_t batch_size = default_arrow_record_batch_size);
 
  protected:
   Cursor() {}
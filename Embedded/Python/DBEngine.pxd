@@ -8,7 +8,7 @@ from libcpp cimport bool, nullptr_t, nullptr
 from libcpp.pair cimport pair
 from libcpp.vector cimport vector
 from cython.operator cimport dereference as deref
-from pyarrow.lib cimport CTable
+from pyarrow.lib cimport CTable, CRecordBatchReader
 
 cdef extern from "arrow/api.h" namespace "arrow" nogil:
     cdef cppclass CRecordBatch" arrow::RecordBatch":
@@ -47,6 +47,7 @@ cdef extern from "DBEngine.h" namespace 'EmbeddedDatabase':
         Row getNextRow()
         ColumnType getColType(uint32_t nPos)
         shared_ptr[CRecordBatch] getArrowRecordBatch() nogil except +
+        shared_ptr[CRecordBatchReader] getArrowRecordBatchReader(size_t) nogil except +
 
     cdef cppclass DBEngine:
         void executeDDL(string) except +
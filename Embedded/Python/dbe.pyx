@@ -154,6 +154,16 @@ cdef class PyCursor:
             prb = pyarrow_wrap_batch(self.c_batch)
             return prb
 
+    def getArrowRecordBatchReader(self, size_t batch_size=1048576):
+        cdef shared_ptr[CRecordBatchReader] c_reader
+        with nogil:
+            c_reader = self.c_cursor.get().getArrowRecordBatchReader(batch_size)
+        if c_reader.get() is NULL:
+            return None
+        cdef RecordBatchReader reader = RecordBatchReader.__new__(RecordBatchReader)
+        reader.reader = c_reader
+        return reader
+
 ColumnDetailsTp = namedtuple("ColumnDetails", ["name", "type", "nullable",
                                              "precision", "scale",
                                              "comp_param", "encoding",
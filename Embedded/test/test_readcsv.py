@@ -69,6 +69,30 @@ def test_usecols_csv():
     assert batch
     assert batch.to_pydict() == target
 
+def test_record_batch_reader():
+    cursor = engine.executeDML("select * from usecols")
+    assert cursor
+    reader = cursor.getArrowRecordBatchReader(4)
+    assert reader
+    batches = list(reader)
+    assert len(batches) > 1
+    assert all(batch.num_rows <= 4 for batch in batches)
+    table = pa.Table.from_batches(batches, schema=reader.schema)
+    assert table.to_pydict() == cursor.getArrowRecordBatch().to_pydict()
+
+def test_record_batch_reader_dictionaries():
+    cursor = engine.executeDML("select e from usecols")
+    assert cursor
+    reader = cursor.getArrowRecordBatchReader(1)
+    assert reader
+    assert pa.types.is_dictionary(reader.schema.field('e').type)
+    batches = list(reader)
+    assert len(batches) == 6
+    # each batch only carries the strings of its own rows
+    assert all(len(batch.column(0).dictionary) <= batch.num_rows for batch in batches)
+    values = [value for batch in batches for value in batch.to_pydict()['e']]
+    assert values == ['5', '6', '7', '8', '9', '0']
+
 def test_time_parsing():
     target = {
         'timestamp': [datetime.datetime(2010, 4, 1, 0, 0), datetime.datetime(2010, 4, 1, 0, 30), datetime.datetime(2010, 4, 1, 1, 0)],
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "Fragmenter/Fragmenter.h"
+#include "Fragmenter/UniqueKeyIndex.h"
 
 #include <boost/variant.hpp>
 #include <string>
@@ -269,6 +270,16 @@ class AbstractFragmenter {
    * change fragment sizes.
    */
   virtual void resetSizesFromFragments() = 0;
+
+  /**
+   * Returns the positions of the visible rows holding the given values of a key column,
+   * which must be unique among the visible rows. The values of dictionary-encoded
+   * string columns are their string ids. Values without a visible row are left out of
+   * the result.
+   */
+  virtual std::map<int64_t, UniqueKeyIndex::RowPosition> lookupUniqueKeys(
+      const ColumnDescriptor* cd,
+      const std::vector<int64_t>& keys) = 0;
 };
 
 }  // namespace Fragmenter_Namespace
@@ -20,7 +20,9 @@
 #include <deque>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <vector>
 #include "../Catalog/ColumnDescriptor.h"
 #include "../DataMgr/Chunk/Chunk.h"
 #include "../DataMgr/ChunkMetadata.h"
@@ -76,6 +78,22 @@ struct InsertData {
                                    /// replicated element (NULL or DEFAULT)
 };
 
+/**
+ * @struct FragmentVersion
+ * @brief Chunks of a fragment that updates replaced after copies of its FragmentInfo
+ * were made. A query reads a fragment through the FragmentInfo copy it started with, and
+ * so keeps reading the replaced chunks, which are released with the last such copy.
+ * Each update starts a new version and adds the chunks it replaces to the versions
+ * still in use, unless they hold an older chunk of the same column already.
+ */
+
+struct FragmentVersion {
+  mapd_shared_mutex mutex;
+  std::map<int, std::shared_ptr<Chunk_NS::Chunk>> replaced_chunks;
+  // earlier versions, which do not outlive the copies of the fragment info using them
+  std::vector<std::weak_ptr<FragmentVersion>> previous_versions;
+};
+
 /**
  * @class FragmentInfo
  * @brief Used by Fragmenter classes to store info about each
@@ -93,7 +111,8 @@ class FragmentInfo {
       , resultSet(nullptr)
       , numTuples(0)
       , synthesizedNumTuplesIsValid(false)
-      , synthesizedMetadataIsValid(false) {}
+      , synthesizedMetadataIsValid(false)
+      , version(std::make_shared<FragmentVersion>()) {}
 
   void setChunkMetadataMap(const ChunkMetadataMap& chunk_metadata_map) {
     this->chunkMetadataMap = chunk_metadata_map;
@@ -120,6 +139,17 @@ class FragmentInfo {
   void invalidateChunkMetadataMap() const { synthesizedMetadataIsValid = false; };
   void invalidateNumTuples() const { synthesizedNumTuplesIsValid = false; }
 
+  // Returns the chunk of a column as of when this copy of the fragment info was made,
+  // even if an update has replaced the chunk since.
+  std::shared_ptr<Chunk_NS::Chunk> getChunk(
+      const ColumnDescriptor* cd,
+      Data_Namespace::DataMgr* data_mgr,
+      const ChunkKey& key,
+      const Data_Namespace::MemoryLevel memory_level,
+      const int device_id,
+      const size_t num_bytes,
+      const size_t num_elems) const;
+
   // for unit tests
   static void setUnconditionalVacuum(const double unconditionalVacuum) {
     unconditionalVacuum_ = unconditionalVacuum;
@@ -139,6 +169,7 @@ class FragmentInfo {
   mutable ChunkMetadataMap chunkMetadataMap;
   mutable bool synthesizedNumTuplesIsValid;
   mutable bool synthesizedMetadataIsValid;
+  std::shared_ptr<FragmentVersion> version;
 
   friend class InsertOrderFragmenter;
   static bool unconditionalVacuum_;
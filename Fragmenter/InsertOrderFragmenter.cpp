@@ -587,6 +587,9 @@ void InsertOrderFragmenter::addColumns(const InsertData& insertDataStruct) {
 void InsertOrderFragmenter::dropColumns(const std::vector<int>& columnIds) {
   // prevent concurrent insert rows and drop column
   mapd_unique_lock<mapd_shared_mutex> insertLock(insertMutex_);
+  for (const auto column_id : columnIds) {
+    dropUniqueKeyIndex(column_id);
+  }
   // synchronize concurrent accesses to fragmentInfoVec_
   mapd_unique_lock<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
   for (auto const& fragmentInfo : fragmentInfoVec_) {
@@ -701,6 +704,8 @@ void InsertOrderFragmenter::insertChunksIntoFragment(
 }
 
 void InsertOrderFragmenter::insertChunksImpl(const InsertChunks& insert_chunks) {
+  // the chunks are not decoded to maintain the index
+  dropUniqueKeyIndex();
   std::optional<int> delete_column_id{std::nullopt};
   for (const auto& cit : columnMap_) {
     if (cit.second.getColumnDesc()->isDeletedCol) {
@@ -812,6 +817,17 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insert_data) {
         std::make_pair(insert_data.columnIds[insertId], insertId));
   }
 
+  std::lock_guard<std::mutex> unique_key_index_lock(unique_key_index_mutex_);
+  std::optional<size_t> unique_key_insert_id;
+  if (unique_key_index_) {
+    auto it = inverseInsertDataColIdMap.find(unique_key_index_->getColumnId());
+    if (it == inverseInsertDataColIdMap.end() || insert_data.is_default[it->second]) {
+      unique_key_index_.reset();
+    } else {
+      unique_key_insert_id = it->second;
+    }
+  }
+
   size_t numRowsLeft = insert_data.numRows;
   size_t numRowsInserted = 0;
   vector<DataBlockPtr> dataCopy =
@@ -916,6 +932,13 @@ void InsertOrderFragmenter::insertDataImpl(InsertData& insert_data) {
             colMapIt->second.appendData(rowIdBlock, numRowsToInsert, numRowsInserted);
       }
 
+      if (unique_key_insert_id) {
+        unique_key_index_->addInsertedRows(insert_data.data[*unique_key_insert_id],
+                                           numRowsInserted,
+                                           numRowsToInsert,
+                                           currentFragment->fragmentId,
+                                           currentFragment->getPhysicalNumTuples());
+      }
       currentFragment->shadowNumTuples =
           fragmentInfoVec_.back()->getPhysicalNumTuples() + numRowsToInsert;
       numRowsLeft -= numRowsToInsert;
@@ -1034,6 +1057,128 @@ void InsertOrderFragmenter::resetSizesFromFragments() {
   setLastFragmentVarLenColumnSizes();
 }
 
+std::map<int64_t, UniqueKeyIndex::RowPosition> InsertOrderFragmenter::lookupUniqueKeys(
+    const ColumnDescriptor* cd,
+    const std::vector<int64_t>& keys) {
+  // prevent concurrent inserts, which maintain the index
+  mapd_shared_lock<mapd_shared_mutex> insert_lock(insertMutex_);
+  std::lock_guard<std::mutex> unique_key_index_lock(unique_key_index_mutex_);
+  if (!unique_key_index_ || unique_key_index_->getColumnId() != cd->columnId) {
+    buildUniqueKeyIndex(cd);
+  }
+  std::map<int, std::vector<int64_t>> keys_per_fragment;
+  for (const auto key : keys) {
+    if (const auto position = unique_key_index_->find(key)) {
+      keys_per_fragment[position->fragment_id].push_back(key);
+    }
+  }
+
+  std::optional<int> deleted_column_id;
+  for (const auto& [column_id, chunk] : columnMap_) {
+    if (chunk.getColumnDesc()->isDeletedCol) {
+      deleted_column_id = column_id;
+    }
+  }
+  std::map<int64_t, UniqueKeyIndex::RowPosition> positions;
+  mapd_shared_lock<mapd_shared_mutex> read_lock(fragmentInfoMutex_);
+  for (const auto& [fragment_id, fragment_keys] : keys_per_fragment) {
+    // the index can refer to rows which have been deleted, or dropped with their
+    // fragment, since they were inserted
+    const auto fragment_it =
+        std::find_if(fragmentInfoVec_.begin(),
+                     fragmentInfoVec_.end(),
+                     [fragment_id = fragment_id](const auto& fragment) {
+                       return fragment->fragmentId == fragment_id;
+                     });
+    if (fragment_it == fragmentInfoVec_.end()) {
+      continue;
+    }
+    const auto& fragment = **fragment_it;
+    const auto key_chunk = getCpuChunk(cd->columnId, fragment);
+    const auto key_data = key_chunk->getBuffer()->getMemoryPtr();
+    std::shared_ptr<Chunk_NS::Chunk> deleted_chunk;
+    if (deleted_column_id) {
+      deleted_chunk = getCpuChunk(*deleted_column_id, fragment);
+    }
+    for (const auto key : fragment_keys) {
+      const auto position = unique_key_index_->find(key);
+      CHECK(position);
+      if (position->offset >= fragment.getPhysicalNumTuples() ||
+          (deleted_chunk &&
+           deleted_chunk->getBuffer()->getMemoryPtr()[position->offset]) ||
+          unique_key_index_->getChunkValue(key_data, position->offset) != key) {
+        continue;
+      }
+      positions.emplace(key, *position);
+    }
+  }
+  return positions;
+}
+
+void InsertOrderFragmenter::buildUniqueKeyIndex(const ColumnDescriptor* cd) {
+  auto timer = DEBUG_TIMER(__func__);
+  if (!UniqueKeyIndex::isSupportedType(cd->columnType)) {
+    throw std::runtime_error("Column " + cd->columnName + " of type " +
+                             cd->columnType.get_type_name() +
+                             " cannot be used as a unique key.");
+  }
+  auto index = std::make_unique<UniqueKeyIndex>(cd->columnType, cd->columnId);
+  std::optional<int> deleted_column_id;
+  for (const auto& [column_id, chunk] : columnMap_) {
+    if (chunk.getColumnDesc()->isDeletedCol) {
+      deleted_column_id = column_id;
+    }
+  }
+  mapd_shared_lock<mapd_shared_mutex> read_lock(fragmentInfoMutex_);
+  for (const auto& fragment : fragmentInfoVec_) {
+    const auto num_rows = fragment->getPhysicalNumTuples();
+    if (num_rows == 0) {
+      continue;
+    }
+    const auto key_chunk = getCpuChunk(cd->columnId, *fragment);
+    std::shared_ptr<Chunk_NS::Chunk> deleted_chunk;
+    if (deleted_column_id) {
+      deleted_chunk = getCpuChunk(*deleted_column_id, *fragment);
+    }
+    index->addChunkRows(key_chunk->getBuffer()->getMemoryPtr(),
+                        deleted_chunk ? deleted_chunk->getBuffer()->getMemoryPtr()
+                                      : nullptr,
+                        num_rows,
+                        fragment->fragmentId);
+  }
+  VLOG(1) << "Built unique key index with " << index->size() << " keys on column "
+          << cd->columnName << " of table " << physicalTableId_;
+  unique_key_index_ = std::move(index);
+}
+
+void InsertOrderFragmenter::dropUniqueKeyIndex(const std::optional<int> column_id) {
+  std::lock_guard<std::mutex> unique_key_index_lock(unique_key_index_mutex_);
+  if (unique_key_index_ &&
+      (!column_id || unique_key_index_->getColumnId() == *column_id)) {
+    unique_key_index_.reset();
+  }
+}
+
+std::shared_ptr<Chunk_NS::Chunk> InsertOrderFragmenter::getCpuChunk(
+    const int column_id,
+    const FragmentInfo& fragment) {
+  const auto column_it = columnMap_.find(column_id);
+  CHECK(column_it != columnMap_.end());
+  const auto& chunk_metadata_map = fragment.getChunkMetadataMapPhysical();
+  const auto chunk_metadata_it = chunk_metadata_map.find(column_id);
+  CHECK(chunk_metadata_it != chunk_metadata_map.end());
+  ChunkKey chunk_key = chunkKeyPrefix_;
+  chunk_key.push_back(column_id);
+  chunk_key.push_back(fragment.fragmentId);
+  return Chunk_NS::Chunk::getChunk(column_it->second.getColumnDesc(),
+                                   dataMgr_,
+                                   chunk_key,
+                                   Data_Namespace::CPU_LEVEL,
+                                   0,
+                                   chunk_metadata_it->second->numBytes,
+                                   chunk_metadata_it->second->numElements);
+}
+
 void InsertOrderFragmenter::setLastFragmentVarLenColumnSizes() {
   if (!uses_foreign_storage_ && fragmentInfoVec_.size() > 0) {
     // Now need to get the insert buffers for each column - should be last
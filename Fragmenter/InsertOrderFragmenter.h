@@ -187,6 +187,10 @@ class InsertOrderFragmenter : public AbstractFragmenter {
 
   void resetSizesFromFragments() override;
 
+  std::map<int64_t, UniqueKeyIndex::RowPosition> lookupUniqueKeys(
+      const ColumnDescriptor* cd,
+      const std::vector<int64_t>& keys) override;
+
  protected:
   std::vector<int> chunkKeyPrefix_;
   std::map<int, Chunk_NS::Chunk>
@@ -217,6 +221,10 @@ class InsertOrderFragmenter : public AbstractFragmenter {
   int rowIdColId_;
   std::unordered_map<int, size_t> varLenColInfo_;
   std::shared_ptr<std::mutex> mutex_access_inmem_states;
+  // Index of the key column of the last lookupUniqueKeys call, dropped by operations
+  // which move rows or modify the column
+  std::unique_ptr<UniqueKeyIndex> unique_key_index_;
+  std::mutex unique_key_index_mutex_;
 
   /**
    * @brief creates new fragment, calling createChunk()
@@ -237,6 +245,12 @@ class InsertOrderFragmenter : public AbstractFragmenter {
   void insertDataImpl(InsertData& insert_data);
   void insertChunksImpl(const InsertChunks& insert_chunk);
   void addColumns(const InsertData& insertDataStruct);
+  void buildUniqueKeyIndex(const ColumnDescriptor* cd);
+  // Drops the index if it is on the given column, or regardless of its column if none
+  // is given
+  void dropUniqueKeyIndex(const std::optional<int> column_id = std::nullopt);
+  std::shared_ptr<Chunk_NS::Chunk> getCpuChunk(const int column_id,
+                                               const FragmentInfo& fragment);
 
   InsertOrderFragmenter(const InsertOrderFragmenter&);
   InsertOrderFragmenter& operator=(const InsertOrderFragmenter&);
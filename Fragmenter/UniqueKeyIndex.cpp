@@ -0,0 +1,109 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Fragmenter/UniqueKeyIndex.h"
+
+#include "Logger/Logger.h"
+#include "Shared/InlineNullValues.h"
+
+namespace Fragmenter_Namespace {
+
+namespace {
+
+template <typename T>
+std::optional<int64_t> read_value(const int8_t* data, const size_t index) {
+  const auto value = reinterpret_cast<const T*>(data)[index];
+  if (value == inline_int_null_value<T>()) {
+    return std::nullopt;
+  }
+  return static_cast<int64_t>(value);
+}
+
+std::optional<int64_t> read_value(const int8_t* data,
+                                  const size_t index,
+                                  const size_t width,
+                                  const bool is_unsigned) {
+  switch (width) {
+    case 1:
+      return is_unsigned ? read_value<uint8_t>(data, index)
+                         : read_value<int8_t>(data, index);
+    case 2:
+      return is_unsigned ? read_value<uint16_t>(data, index)
+                         : read_value<int16_t>(data, index);
+    case 4:
+      return read_value<int32_t>(data, index);
+    case 8:
+      return read_value<int64_t>(data, index);
+    default:
+      UNREACHABLE() << "Unexpected key width " << width;
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+UniqueKeyIndex::UniqueKeyIndex(const SQLTypeInfo& ti, const int column_id)
+    : column_id_(column_id)
+    , insert_width_(ti.is_string() ? ti.get_size() : ti.get_logical_size())
+    , chunk_width_(ti.get_size())
+    , is_unsigned_(ti.is_string() && ti.get_size() < 4) {
+  CHECK(isSupportedType(ti));
+}
+
+bool UniqueKeyIndex::isSupportedType(const SQLTypeInfo& ti) {
+  return ti.is_integer() || (ti.is_string() && ti.is_dict_encoded_string());
+}
+
+void UniqueKeyIndex::addInsertedRows(const DataBlockPtr& data_block,
+                                     const size_t start_row,
+                                     const size_t num_rows,
+                                     const int fragment_id,
+                                     const size_t offset) {
+  for (size_t i = 0; i < num_rows; ++i) {
+    const auto value =
+        read_value(data_block.numbersPtr, start_row + i, insert_width_, is_unsigned_);
+    if (value) {
+      positions_[*value] = {fragment_id, offset + i};
+    }
+  }
+}
+
+void UniqueKeyIndex::addChunkRows(const int8_t* chunk_data,
+                                  const int8_t* deleted_data,
+                                  const size_t num_rows,
+                                  const int fragment_id) {
+  for (size_t i = 0; i < num_rows; ++i) {
+    if (deleted_data && deleted_data[i]) {
+      continue;
+    }
+    const auto value = getChunkValue(chunk_data, i);
+    if (value) {
+      positions_[*value] = {fragment_id, i};
+    }
+  }
+}
+
+std::optional<int64_t> UniqueKeyIndex::getChunkValue(const int8_t* chunk_data,
+                                                     const size_t offset) const {
+  return read_value(chunk_data, offset, chunk_width_, is_unsigned_);
+}
+
+const UniqueKeyIndex::RowPosition* UniqueKeyIndex::find(const int64_t key) const {
+  const auto it = positions_.find(key);
+  return it == positions_.end() ? nullptr : &it->second;
+}
+
+}  // namespace Fragmenter_Namespace
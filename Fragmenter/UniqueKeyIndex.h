@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    UniqueKeyIndex.h
+ * @brief   Hash index from the values of a key column to the positions of their rows.
+ *
+ * The index backs INSERT ... ON CONFLICT. It is built by the fragmenter on first use,
+ * from the chunks of the key column, and kept up to date by inserts. Each value maps to
+ * the row most recently inserted with it, so entries can refer to rows which have been
+ * deleted since, and lookups verify the rows against the chunks.
+ */
+
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+
+#include "Shared/sqltypes.h"
+
+namespace Fragmenter_Namespace {
+
+class UniqueKeyIndex {
+ public:
+  struct RowPosition {
+    int fragment_id;
+    size_t offset;
+  };
+
+  UniqueKeyIndex(const SQLTypeInfo& ti, const int column_id);
+
+  // Integer and dictionary-encoded string columns, whose values are indexed as 64-bit
+  // integers, can be indexed.
+  static bool isSupportedType(const SQLTypeInfo& ti);
+
+  int getColumnId() const { return column_id_; }
+
+  // Indexes num_rows values, from row start_row on, of a block of the column as passed
+  // to InsertOrderFragmenter::insertData. The rows are stored in the given fragment from
+  // offset on.
+  void addInsertedRows(const DataBlockPtr& data_block,
+                       const size_t start_row,
+                       const size_t num_rows,
+                       const int fragment_id,
+                       const size_t offset);
+
+  // Indexes the values of a chunk of the column. Rows flagged in the deleted column
+  // chunk, if there is one, are skipped.
+  void addChunkRows(const int8_t* chunk_data,
+                    const int8_t* deleted_data,
+                    const size_t num_rows,
+                    const int fragment_id);
+
+  // Returns the value at the given offset of a chunk of the column, std::nullopt for
+  // NULL.
+  std::optional<int64_t> getChunkValue(const int8_t* chunk_data,
+                                       const size_t offset) const;
+
+  const RowPosition* find(const int64_t key) const;
+
+  size_t size() const { return positions_.size(); }
+
+ private:
+  const int column_id_;
+  // Inserts pass integers at their logical width and dictionary ids at their storage
+  // width. Chunks store both at their storage width.
+  const size_t insert_width_;
+  const size_t chunk_width_;
+  const bool is_unsigned_;
+  std::unordered_map<int64_t, RowPosition> positions_;
+};
+
+}  // namespace Fragmenter_Namespace
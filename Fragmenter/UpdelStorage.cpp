@@ -35,6 +35,7 @@
 extern bool g_enable_string_functions;
 
 bool g_enable_auto_metadata_update{true};
+bool g_enable_snapshot_reads{false};
 
 namespace Fragmenter_Namespace {
 
@@ -51,6 +52,38 @@ inline bool is_integral(const SQLTypeInfo& t) {
 
 bool FragmentInfo::unconditionalVacuum_{false};
 
+std::shared_ptr<Chunk_NS::Chunk> FragmentInfo::getChunk(
+    const ColumnDescriptor* cd,
+    Data_Namespace::DataMgr* data_mgr,
+    const ChunkKey& key,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_id,
+    const size_t num_bytes,
+    const size_t num_elems) const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(version->mutex);
+  auto chunk_it = version->replaced_chunks.find(cd->columnId);
+  if (chunk_it == version->replaced_chunks.end()) {
+    // the chunk is current and cannot be replaced while the version is locked
+    return Chunk_NS::Chunk::getChunk(
+        cd, data_mgr, key, memory_level, device_id, num_bytes, num_elems);
+  }
+  const auto& chunk = chunk_it->second;
+  if (memory_level == Data_Namespace::CPU_LEVEL) {
+    return chunk;
+  }
+  // replaced chunks are only kept in CPU memory, copy them to the device per query
+  const auto cpu_buffer = chunk->getBuffer();
+  auto buffer = data_mgr->alloc(memory_level, device_id, cpu_buffer->size());
+  buffer->write(
+      cpu_buffer->getMemoryPtr(), cpu_buffer->size(), 0, Data_Namespace::CPU_LEVEL, 0);
+  return std::shared_ptr<Chunk_NS::Chunk>(
+      new Chunk_NS::Chunk(buffer, nullptr, cd, false),
+      [data_mgr](Chunk_NS::Chunk* device_chunk) {
+        data_mgr->free(device_chunk->getBuffer());
+        delete device_chunk;
+      });
+}
+
 void InsertOrderFragmenter::updateColumn(const Catalog_Namespace::Catalog* catalog,
                                          const TableDescriptor* td,
                                          const ColumnDescriptor* cd,
@@ -645,6 +678,8 @@ std::optional<ChunkUpdateStats> InsertOrderFragmenter::updateColumn(
   updel_roll.catalog = catalog;
   updel_roll.logicalTableId = catalog->getLogicalTableId(td->tableId);
   updel_roll.memoryLevel = memory_level;
+  // rows updated in place no longer hold the values their index entries refer to
+  dropUniqueKeyIndex(cd->columnId);
 
   const size_t ncore = cpu_threads();
   const auto nrow = frag_offsets.size();
@@ -660,13 +695,10 @@ std::optional<ChunkUpdateStats> InsertOrderFragmenter::updateColumn(
   CHECK(chunk_meta_it != fragment.getChunkMetadataMapPhysical().end());
   ChunkKey chunk_key{
       catalog->getCurrentDB().dbId, td->tableId, cd->columnId, fragment.fragmentId};
-  auto chunk = Chunk_NS::Chunk::getChunk(cd,
-                                         &catalog->getDataMgr(),
-                                         chunk_key,
-                                         Data_Namespace::CPU_LEVEL,
-                                         0,
-                                         chunk_meta_it->second->numBytes,
-                                         chunk_meta_it->second->numElements);
+  auto chunk = updel_roll.getChunkToUpdate(cd,
+                                           chunk_key,
+                                           chunk_meta_it->second->numBytes,
+                                           chunk_meta_it->second->numElements);
 
   std::vector<ChunkUpdateStats> update_stats_per_thread(ncore);
 
@@ -894,7 +926,8 @@ std::optional<ChunkUpdateStats> InsertOrderFragmenter::updateColumn(
   wait_cleanup_threads(threads);
 
   // for unit test
-  if (Fragmenter_Namespace::FragmentInfo::unconditionalVacuum_) {
+  if (Fragmenter_Namespace::FragmentInfo::unconditionalVacuum_ &&
+      !updel_roll.updatesChunkCopies()) {
     if (cd->isDeletedCol) {
       const auto deleted_offsets = getVacuumOffsets(chunk);
       if (deleted_offsets.size() > 0) {
@@ -975,6 +1008,35 @@ void InsertOrderFragmenter::updateMetadata(const Catalog_Namespace::Catalog* cat
   mapd_unique_lock<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
   const auto chunk_metadata_map = updel_roll.getChunkMetadataMap(key);
   auto& fragmentInfo = *key.second;
+  const auto chunk_replacements = updel_roll.getChunkReplacements(key);
+  if (!chunk_replacements.empty()) {
+    // queries holding copies of the fragment info keep reading the replaced chunks,
+    // while the updated copies take their place for the queries to come. a version only
+    // keeps the chunks that were current when it was, not those of later versions.
+    auto new_version = std::make_shared<FragmentVersion>();
+    std::vector<std::shared_ptr<FragmentVersion>> versions{fragmentInfo.version};
+    for (const auto& previous_version : fragmentInfo.version->previous_versions) {
+      if (auto version = previous_version.lock()) {
+        versions.push_back(std::move(version));
+      }
+    }
+    for (const auto& version : versions) {
+      mapd_unique_lock<mapd_shared_mutex> version_lock(version->mutex);
+      for (const auto& [chunk, updated_chunk] : chunk_replacements) {
+        // a version already holding an older chunk of the column keeps that one
+        version->replaced_chunks.emplace(chunk->getColumnDesc()->columnId, chunk);
+      }
+      new_version->previous_versions.push_back(version);
+    }
+    for (const auto& [chunk, updated_chunk] : chunk_replacements) {
+      auto chunk_key = chunkKeyPrefix_;
+      chunk_key.push_back(chunk->getColumnDesc()->columnId);
+      chunk_key.push_back(fragmentInfo.fragmentId);
+      dataMgr_->replaceChunkBuffer(chunk_key, updated_chunk->getBuffer());
+      dataMgr_->deleteChunksWithPrefix(chunk_key, Data_Namespace::MemoryLevel::GPU_LEVEL);
+    }
+    fragmentInfo.version = new_version;
+  }
   fragmentInfo.setChunkMetadataMap(chunk_metadata_map);
   fragmentInfo.shadowChunkMetadataMap = fragmentInfo.getChunkMetadataMapPhysicalCopy();
   fragmentInfo.shadowNumTuples = updel_roll.getNumTuple(key);
@@ -1276,6 +1338,8 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
                                         const std::vector<uint64_t>& frag_offsets,
                                         const Data_Namespace::MemoryLevel memory_level,
                                         UpdelRoll& updel_roll) {
+  // vacuuming moves the rows the index refers to
+  dropUniqueKeyIndex();
   auto fragment_ptr = getFragmentInfo(fragment_id);
   auto& fragment = *fragment_ptr;
   auto chunks = getChunksForAllColumns(td, fragment, memory_level);
@@ -1403,6 +1467,24 @@ bool UpdelRoll::commitUpdate() {
   }
   const auto td = catalog->getMetadataForTable(logicalTableId);
   CHECK(td);
+  if (updatesChunkCopies()) {
+    // the updated chunk copies are not visible to running queries, so there is no need
+    // to wait for them. the copies are written to storage under the keys of the chunks
+    // they replace, hence the fragmenter is updated first.
+    CHECK_EQ(td->persistenceLevel, Data_Namespace::MemoryLevel::DISK_LEVEL);
+    auto table_epochs = catalog->getTableEpochs(catalog->getDatabaseId(), logicalTableId);
+    try {
+      updateFragmenter();
+      catalog->checkpoint(logicalTableId);
+    } catch (...) {
+      dirty_chunks.clear();
+      replaced_chunks.clear();
+      catalog->setTableEpochsLogExceptions(catalog->getDatabaseId(), table_epochs);
+      throw;
+    }
+    cleanupChunks();
+    return true;
+  }
   ChunkKey chunk_key{catalog->getDatabaseId(), td->tableId};
   const auto table_lock = lockmgr::TableDataLockMgr::getWriteLockForTable(chunk_key);
 
@@ -1419,7 +1501,8 @@ bool UpdelRoll::commitUpdate() {
       throw;
     }
   }
-  updateFragmenterAndCleanupChunks();
+  updateFragmenter();
+  cleanupChunks();
   return true;
 }
 
@@ -1430,21 +1513,31 @@ void UpdelRoll::stageUpdate() {
   auto table_id = table_descriptor->tableId;
   CHECK_EQ(memoryLevel, Data_Namespace::MemoryLevel::CPU_LEVEL);
   CHECK_EQ(table_descriptor->persistenceLevel, Data_Namespace::MemoryLevel::DISK_LEVEL);
+  const bool updates_chunk_copies = updatesChunkCopies();
   try {
+    if (updates_chunk_copies) {
+      updateFragmenter();
+    }
     catalog->getDataMgr().checkpoint(db_id, table_id, memoryLevel);
   } catch (...) {
     dirty_chunks.clear();
+    replaced_chunks.clear();
     throw;
   }
-  updateFragmenterAndCleanupChunks();
+  if (!updates_chunk_copies) {
+    updateFragmenter();
+  }
+  cleanupChunks();
 }
 
-void UpdelRoll::updateFragmenterAndCleanupChunks() {
+void UpdelRoll::updateFragmenter() {
   // for each dirty fragment
   for (auto& cm : chunk_metadata_map_per_fragment) {
     cm.first.first->fragmenter->updateMetadata(catalog, cm.first, *this);
   }
+}
 
+void UpdelRoll::cleanupChunks() {
   // flush gpu dirty chunks if update was not on gpu
   if (memoryLevel != Data_Namespace::MemoryLevel::GPU_LEVEL) {
     for (const auto& [chunk_key, chunk] : dirty_chunks) {
@@ -1453,6 +1546,7 @@ void UpdelRoll::updateFragmenterAndCleanupChunks() {
     }
   }
   dirty_chunks.clear();
+  replaced_chunks.clear();
 }
 
 void UpdelRoll::cancelUpdate() {
@@ -1460,6 +1554,17 @@ void UpdelRoll::cancelUpdate() {
     return;
   }
 
+  if (updatesChunkCopies()) {
+    // the updated chunk copies were never visible to queries, just drop them
+    for (const auto& [chunk_key, chunk] : dirty_chunks) {
+      catalog->getDataMgr().free(chunk->getBuffer());
+      chunk->setBuffer(nullptr);
+    }
+    dirty_chunks.clear();
+    replaced_chunks.clear();
+    return;
+  }
+
   // TODO: needed?
   ChunkKey chunk_key{catalog->getDatabaseId(), logicalTableId};
   const auto table_lock = lockmgr::TableDataLockMgr::getWriteLockForTable(chunk_key);
@@ -1492,6 +1597,46 @@ void UpdelRoll::addDirtyChunk(std::shared_ptr<Chunk_NS::Chunk> chunk,
   dirty_chunks[chunk_key] = chunk;
 }
 
+std::shared_ptr<Chunk_NS::Chunk> UpdelRoll::getChunkToUpdate(const ColumnDescriptor* cd,
+                                                             const ChunkKey& chunk_key,
+                                                             const size_t num_bytes,
+                                                             const size_t num_elems) {
+  CHECK(catalog);
+  auto& data_mgr = catalog->getDataMgr();
+  auto chunk = Chunk_NS::Chunk::getChunk(
+      cd, &data_mgr, chunk_key, Data_Namespace::CPU_LEVEL, 0, num_bytes, num_elems);
+  const auto td = catalog->getMetadataForTable(chunk_key[CHUNK_KEY_TABLE_IDX]);
+  CHECK(td);
+  if (!g_enable_snapshot_reads || is_varlen_update ||
+      td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL) {
+    return chunk;
+  }
+  mapd_unique_lock<mapd_shared_mutex> lock(chunk_update_tracker_mutex);
+  if (auto chunk_it = dirty_chunks.find(chunk_key); chunk_it != dirty_chunks.end()) {
+    return chunk_it->second;
+  }
+  const auto buffer = chunk->getBuffer();
+  auto buffer_copy = data_mgr.alloc(Data_Namespace::CPU_LEVEL, 0, buffer->size());
+  buffer->copyTo(buffer_copy);
+  replaced_chunks[chunk_key] = chunk;
+  return std::make_shared<Chunk_NS::Chunk>(buffer_copy, nullptr, cd);
+}
+
+std::vector<ChunkReplacement> UpdelRoll::getChunkReplacements(
+    const MetaDataKey& key) const {
+  mapd_shared_lock<mapd_shared_mutex> lock(chunk_update_tracker_mutex);
+  std::vector<ChunkReplacement> chunk_replacements;
+  for (const auto& [chunk_key, chunk] : replaced_chunks) {
+    if (chunk_key[CHUNK_KEY_TABLE_IDX] == key.first->tableId &&
+        chunk_key[CHUNK_KEY_FRAGMENT_IDX] == key.second->fragmentId) {
+      auto dirty_chunk_it = dirty_chunks.find(chunk_key);
+      CHECK(dirty_chunk_it != dirty_chunks.end());
+      chunk_replacements.emplace_back(chunk, dirty_chunk_it->second);
+    }
+  }
+  return chunk_replacements;
+}
+
 void UpdelRoll::initializeUnsetMetadata(
     const TableDescriptor* td,
     Fragmenter_Namespace::FragmentInfo& fragment_info) {
@@ -22,13 +22,93 @@
 
 #include "ImportExport/DelimitedParserUtils.h"
 
+#include <algorithm>
+#include <array>
+#include <initializer_list>
 #include <string_view>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "ImportExport/CopyParams.h"
 #include "Logger/Logger.h"
 #include "StringDictionary/StringDictionary.h"
 
 namespace {
+/**
+ * Finds the next structural character, i.e. delimiter, quote, escape or line ending, of
+ * a buffer. Where the target supports it, 32 (AVX2) or 16 (SSE2) bytes are compared
+ * against all the characters at once, so parsers only look at the bytes returned.
+ */
+class StructuralCharFinder {
+ public:
+  StructuralCharFinder(std::initializer_list<char> chars) {
+    for (const auto c : chars) {
+      if (std::find(chars_.begin(), chars_.begin() + num_chars_, c) !=
+          chars_.begin() + num_chars_) {
+        continue;
+      }
+      CHECK_LT(num_chars_, kMaxChars);
+#if defined(__AVX2__)
+      patterns_[num_chars_] = _mm256_set1_epi8(c);
+#elif defined(__SSE2__)
+      patterns_[num_chars_] = _mm_set1_epi8(c);
+#endif
+      chars_[num_chars_++] = c;
+    }
+  }
+
+  // Returns the position of the first structural character in [begin, end), end if
+  // there is none.
+  const char* find(const char* begin, const char* end) const {
+    const char* p = begin;
+#if defined(__AVX2__)
+    for (; end - p >= 32; p += 32) {
+      const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      auto matches = _mm256_cmpeq_epi8(block, patterns_[0]);
+      for (size_t i = 1; i < num_chars_; ++i) {
+        matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, patterns_[i]));
+      }
+      if (const uint32_t mask = _mm256_movemask_epi8(matches)) {
+        return p + __builtin_ctz(mask);
+      }
+    }
+#elif defined(__SSE2__)
+    for (; end - p >= 16; p += 16) {
+      const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      auto matches = _mm_cmpeq_epi8(block, patterns_[0]);
+      for (size_t i = 1; i < num_chars_; ++i) {
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, patterns_[i]));
+      }
+      if (const uint32_t mask = _mm_movemask_epi8(matches)) {
+        return p + __builtin_ctz(mask);
+      }
+    }
+#endif
+    for (; p < end; ++p) {
+      for (size_t i = 0; i < num_chars_; ++i) {
+        if (*p == chars_[i]) {
+          return p;
+        }
+      }
+    }
+    return end;
+  }
+
+ private:
+  static constexpr size_t kMaxChars{8};
+  std::array<char, kMaxChars> chars_;
+#if defined(__AVX2__)
+  __m256i patterns_[kMaxChars];
+#elif defined(__SSE2__)
+  __m128i patterns_[kMaxChars];
+#endif
+  size_t num_chars_{0};
+};
+
 inline bool is_eol(const char& c, const import_export::CopyParams& copy_params) {
   return c == copy_params.line_delim || c == '\n' || c == '\r';
 }
@@ -86,10 +166,17 @@ size_t find_end(const char* buffer,
                 size_t offset) {
   size_t last_line_delim_pos = 0;
   const char* current = buffer + offset;
+  const char* buffer_end = buffer + size;
   if (copy_params.quoted) {
-    while (current < buffer + size) {
-      while (!in_quote && current < buffer + size) {
+    const StructuralCharFinder unquoted_chars{copy_params.line_delim, copy_params.quote};
+    const StructuralCharFinder quoted_chars{copy_params.escape, copy_params.quote};
+    while (current < buffer_end) {
+      while (!in_quote && current < buffer_end) {
         // We are outside of quotes. We have to find the last possible line delimiter.
+        current = unquoted_chars.find(current, buffer_end);
+        if (current == buffer_end) {
+          break;
+        }
         if (*current == copy_params.line_delim) {
           last_line_delim_pos = current - buffer;
           ++num_rows_this_buffer;
@@ -99,9 +186,13 @@ size_t find_end(const char* buffer,
         ++current;
       }
 
-      while (in_quote && current < buffer + size) {
+      while (in_quote && current < buffer_end) {
         // We are in a quoted field. We have to find the ending quote.
-        if ((*current == copy_params.escape) && (current < buffer + size - 1) &&
+        current = quoted_chars.find(current, buffer_end);
+        if (current == buffer_end) {
+          break;
+        }
+        if ((*current == copy_params.escape) && (current < buffer_end - 1) &&
             (*(current + 1) == copy_params.quote)) {
           ++current;
         } else if (*current == copy_params.quote) {
@@ -111,11 +202,14 @@ size_t find_end(const char* buffer,
       }
     }
   } else {
-    while (current < buffer + size) {
-      if (*current == copy_params.line_delim) {
-        last_line_delim_pos = current - buffer;
-        ++num_rows_this_buffer;
+    const StructuralCharFinder line_delims{copy_params.line_delim};
+    while (current < buffer_end) {
+      current = line_delims.find(current, buffer_end);
+      if (current == buffer_end) {
+        break;
       }
+      last_line_delim_pos = current - buffer;
+      ++num_rows_this_buffer;
       ++current;
     }
   }
@@ -201,7 +295,20 @@ const char* get_row(const char* buf,
   bool has_escape = false;
   bool strip_quotes = false;
   try_single_thread = false;
+  const StructuralCharFinder structural_chars{
+      copy_params.escape,
+      copy_params.quote,
+      copy_params.delimiter,
+      copy_params.line_delim,
+      '\n',
+      '\r',
+      is_array ? copy_params.array_begin : copy_params.delimiter};
   for (p = buf; p < entire_buf_end; ++p) {
+    // the bytes in between structural characters do not change the state of the parser
+    p = structural_chars.find(p, entire_buf_end);
+    if (p == entire_buf_end) {
+      break;
+    }
     if (*p == copy_params.escape && p < entire_buf_end - 1 &&
         *(p + 1) == copy_params.quote) {
       p++;
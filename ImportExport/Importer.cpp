@@ -2038,11 +2038,11 @@ static ImportStatus import_thread_delimited(
   auto query_session = session_info ? session_info->get_session_id() : "";
   CHECK(scratch_buffer);
   auto buffer = scratch_buffer.get();
-  auto load_ms = measure<>::execution([]() {});
+  int64_t load_us = 0;
 
   thread_import_status.thread_id = thread_id;
 
-  auto ms = measure<>::execution([&]() {
+  auto total_us = measure<std::chrono::microseconds>::execution([&]() {
     const CopyParams& copy_params = importer->get_copy_params();
     const std::list<const ColumnDescriptor*>& col_descs = importer->get_column_descs();
     size_t begin =
@@ -2370,17 +2370,20 @@ static ImportStatus import_thread_delimited(
     }  // end thread
     total_str_to_val_time_us += us;
     if (!thread_import_status.load_failed && thread_import_status.rows_completed > 0) {
-      load_ms = measure<>::execution([&]() {
+      load_us = measure<std::chrono::microseconds>::execution([&]() {
         importer->load(import_buffers, thread_import_status.rows_completed, session_info);
       });
     }
   });  // end execution
+  thread_import_status.parse_time = std::chrono::microseconds(total_us - load_us);
+  thread_import_status.load_time = std::chrono::microseconds(load_us);
 
   if (DEBUG_TIMING && !thread_import_status.load_failed &&
       thread_import_status.rows_completed > 0) {
     LOG(INFO) << "Thread" << std::this_thread::get_id() << ":"
               << thread_import_status.rows_completed << " rows inserted in "
-              << (double)ms / 1000.0 << "sec, Insert Time: " << (double)load_ms / 1000.0
+              << (double)total_us / 1000000.0
+              << "sec, Insert Time: " << (double)load_us / 1000000.0
               << "sec, get_row: " << (double)total_get_row_time_us / 1000000.0
               << "sec, str_to_val: " << (double)total_str_to_val_time_us / 1000000.0
               << "sec" << std::endl;
@@ -3094,11 +3097,12 @@ bool Loader::loadToShard(
     const TableDescriptor* shard_table,
     bool checkpoint,
     const Catalog_Namespace::SessionInfo* session_info) {
-  std::unique_lock<std::mutex> loader_lock(loader_mutex_);
   Fragmenter_Namespace::InsertData ins_data(insert_data_);
   ins_data.numRows = row_count;
   bool success = false;
   try {
+    // String dictionaries are thread safe, so import threads encode their batches
+    // concurrently instead of one after the other under the loader lock.
     ins_data.data = TypedImportBuffer::get_data_block_pointers(import_buffers);
   } catch (std::exception& e) {
     std::ostringstream oss;
@@ -3106,9 +3110,11 @@ bool Loader::loadToShard(
         << e.what();
 
     LOG(ERROR) << oss.str();
+    std::lock_guard<std::mutex> loader_lock(loader_mutex_);
     error_msg_ = oss.str();
     return success;
   }
+  std::unique_lock<std::mutex> loader_lock(loader_mutex_);
   if (isAddingColumns()) {
     // when Adding columns we omit any columns except the ones being added
     ins_data.columnIds.clear();
@@ -4477,8 +4483,11 @@ ImportStatus Importer::importDelimited(
   size_t begin_pos = 0;
 
   (void)fseek(p_file, current_pos, SEEK_SET);
-  size_t size =
-      fread(reinterpret_cast<void*>(scratch_buffer.get()), 1, alloc_size, p_file);
+  size_t size{0};
+  // only the raw reads, finding the end of the last row of a buffer is not counted
+  auto read_us = measure<std::chrono::microseconds>::execution([&]() {
+    size = fread(reinterpret_cast<void*>(scratch_buffer.get()), 1, alloc_size, p_file);
+  });
 
   // make render group analyzers for each poly column
   ColumnIdToRenderGroupAnalyzerMapType columnIdToRenderGroupAnalyzerMap;
@@ -4556,8 +4565,12 @@ ImportStatus Importer::importDelimited(
       scratch_buffer = std::make_unique<char[]>(alloc_size);
       CHECK(scratch_buffer);
       memcpy(scratch_buffer.get(), unbuf.get(), nresidual);
-      size = nresidual +
-             fread(scratch_buffer.get() + nresidual, 1, alloc_size - nresidual, p_file);
+      read_us += measure<std::chrono::microseconds>::execution([&]() {
+        size = nresidual + fread(scratch_buffer.get() + nresidual,
+                                 1,
+                                 alloc_size - nresidual,
+                                 p_file);
+      });
 
       begin_pos = 0;
       while (threads.size() > 0) {
@@ -4643,6 +4656,16 @@ ImportStatus Importer::importDelimited(
     }
   }
 
+  {
+    mapd_lock_guard<mapd_shared_mutex> write_lock(import_mutex_);
+    import_status_.read_time = std::chrono::microseconds(read_us);
+    import_status_.bytes_read = current_pos;
+    set_import_status(import_id, import_status_);
+    LOG(INFO) << "Delimited import read " << import_status_.bytes_read << " bytes in "
+              << import_status_.read_time.count() << "us, threads spent "
+              << import_status_.parse_time.count() << "us parsing and "
+              << import_status_.load_time.count() << "us loading";
+  }
   checkpoint(table_epochs);
 
   fclose(p_file);
@@ -657,6 +657,13 @@ struct ImportStatus {
   bool load_failed = false;
   std::string load_msg;
   int thread_id;  // to recall thread_id after thread exit
+  // Time spent in each stage of a delimited import. Reading runs on the importing
+  // thread, while parsing and loading (dictionary encoding and appending to the
+  // fragmenter) run on the import threads and add up over them.
+  std::chrono::duration<size_t, std::micro> read_time{0};
+  std::chrono::duration<size_t, std::micro> parse_time{0};
+  std::chrono::duration<size_t, std::micro> load_time{0};
+  size_t bytes_read{0};
   ImportStatus()
       : start(std::chrono::steady_clock::now())
       , rows_completed(0)
@@ -668,6 +675,10 @@ struct ImportStatus {
   ImportStatus& operator+=(const ImportStatus& is) {
     rows_completed += is.rows_completed;
     rows_rejected += is.rows_rejected;
+    read_time += is.read_time;
+    parse_time += is.parse_time;
+    load_time += is.load_time;
+    bytes_read += is.bytes_read;
     if (is.load_failed) {
       load_failed = true;
       load_msg = is.load_msg;
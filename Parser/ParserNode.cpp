@@ -2425,6 +2425,15 @@ InsertValuesStmt::InsertValuesStmt(const rapidjson::Value& payload)
     }
     values_lists_.push_back(std::move(values_list));
   }
+
+  if (payload.HasMember("on_conflict")) {
+    const auto& on_conflict = payload["on_conflict"];
+    CHECK(on_conflict.HasMember("column") && on_conflict.HasMember("action"));
+    on_conflict_column_ = std::make_unique<std::string>(json_str(on_conflict["column"]));
+    const auto action = json_str(on_conflict["action"]);
+    CHECK(action == "UPDATE" || action == "NOTHING") << action;
+    on_conflict_do_update_ = action == "UPDATE";
+  }
 }
 
 void InsertValuesStmt::analyze(const Catalog_Namespace::Catalog& catalog,
@@ -2677,6 +2686,10 @@ void InsertValuesStmt::execute(const Catalog_Namespace::SessionInfo& session) {
     throw std::runtime_error("Singleton inserts on views is not supported.");
   }
   foreign_storage::validate_non_foreign_table_write(td);
+  if (on_conflict_column_ && leafs_connector_) {
+    throw std::runtime_error(
+        "INSERT ... ON CONFLICT is not supported in distributed mode.");
+  }
 
   auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
   RelAlgExecutor ra_executor(executor.get(), catalog);
@@ -2687,7 +2700,11 @@ void InsertValuesStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   }
   Fragmenter_Namespace::InsertDataLoader insert_data_loader(*leafs_connector_);
   try {
-    ra_executor.executeSimpleInsert(query, insert_data_loader, session);
+    // The rows replaced by the insert are deleted in the same epoch, a failed insert
+    // rolls the deletes back as well
+    if (!on_conflict_column_ || applyOnConflict(catalog, td, query)) {
+      ra_executor.executeSimpleInsert(query, insert_data_loader, session);
+    }
   } catch (...) {
     try {
       leafs_connector_->rollback(session, td->tableId);
@@ -2702,6 +2719,145 @@ void InsertValuesStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   }
 }
 
+bool InsertValuesStmt::applyOnConflict(const Catalog_Namespace::Catalog& catalog,
+                                       const TableDescriptor* td,
+                                       Analyzer::Query& query) const {
+  CHECK(on_conflict_column_);
+  const auto& column_name = *on_conflict_column_;
+  const auto key_cd = catalog.getMetadataForColumn(td->tableId, column_name);
+  if (!key_cd) {
+    throw std::runtime_error("Column " + column_name + " does not exist.");
+  }
+  const auto& key_ti = key_cd->columnType;
+  if (!Fragmenter_Namespace::UniqueKeyIndex::isSupportedType(key_ti)) {
+    throw std::runtime_error("ON CONFLICT column " + column_name +
+                             " must be an integer or a dictionary encoded text column.");
+  }
+  if (on_conflict_do_update_ && !td->hasDeletedCol) {
+    throw std::runtime_error(
+        "ON CONFLICT DO UPDATE is only supported on tables with the vacuum attribute "
+        "set to 'delayed'.");
+  }
+  const auto& result_col_list = query.get_result_col_list();
+  const auto key_col_it =
+      std::find(result_col_list.begin(), result_col_list.end(), key_cd->columnId);
+  if (key_col_it == result_col_list.end()) {
+    throw std::runtime_error("ON CONFLICT column " + column_name +
+                             " must be one of the inserted columns.");
+  }
+  const auto key_col_idx = std::distance(result_col_list.begin(), key_col_it);
+
+  StringDictionary* string_dict{nullptr};
+  if (key_ti.is_string()) {
+    const auto dd = catalog.getMetadataForDict(key_ti.get_comp_param());
+    CHECK(dd);
+    string_dict = dd->stringDict.get();
+    CHECK(string_dict);
+  }
+
+  // Keys of the inserted rows, dictionary encoded strings are keyed on their ids. Rows
+  // with a NULL key never conflict.
+  auto& values_lists = query.get_values_lists();
+  std::vector<std::optional<int64_t>> row_keys(values_lists.size());
+  std::vector<int64_t> keys;
+  std::unordered_set<int64_t> distinct_keys;
+  std::vector<bool> is_duplicate_row(values_lists.size(), false);
+  for (size_t row = 0; row < values_lists.size(); ++row) {
+    auto expr = values_lists[row][key_col_idx]->get_expr();
+    if (const auto cast = dynamic_cast<const Analyzer::UOper*>(expr);
+        cast && cast->get_optype() == kCAST) {
+      expr = cast->get_operand();
+    }
+    const auto constant = dynamic_cast<const Analyzer::Constant*>(expr);
+    CHECK(constant);
+    if (constant->get_is_null()) {
+      continue;
+    }
+    const int64_t key =
+        string_dict ? string_dict->getOrAdd(*constant->get_constval().stringval)
+                    : extract_int_type_from_datum(constant->get_constval(),
+                                                  constant->get_type_info());
+    row_keys[row] = key;
+    if (!distinct_keys.insert(key).second) {
+      if (on_conflict_do_update_) {
+        throw std::runtime_error(
+            "ON CONFLICT DO UPDATE command cannot affect a row a second time, the "
+            "inserted rows contain duplicate values of " +
+            column_name + ".");
+      }
+      // DO NOTHING keeps the first of the rows
+      is_duplicate_row[row] = true;
+      continue;
+    }
+    keys.push_back(key);
+  }
+
+  std::unordered_set<int64_t> conflicting_keys;
+  std::map<const TableDescriptor*, std::map<int, std::vector<uint64_t>>>
+      conflicting_offsets;
+  for (const auto physical_td : catalog.getPhysicalTablesDescriptors(td)) {
+    CHECK(physical_td->fragmenter);
+    for (const auto& [key, position] :
+         physical_td->fragmenter->lookupUniqueKeys(key_cd, keys)) {
+      conflicting_keys.insert(key);
+      conflicting_offsets[physical_td][position.fragment_id].push_back(position.offset);
+    }
+  }
+  VLOG(1) << "INSERT ... ON CONFLICT (" << column_name << ") into " << td->tableName
+          << " conflicts with " << conflicting_keys.size() << " existing rows";
+
+  if (!on_conflict_do_update_) {
+    std::vector<std::vector<std::shared_ptr<Analyzer::TargetEntry>>> remaining_lists;
+    for (size_t row = 0; row < values_lists.size(); ++row) {
+      if (is_duplicate_row[row] ||
+          (row_keys[row] && conflicting_keys.count(*row_keys[row]))) {
+        continue;
+      }
+      remaining_lists.push_back(std::move(values_lists[row]));
+    }
+    values_lists = std::move(remaining_lists);
+    return !values_lists.empty();
+  }
+
+  // DO UPDATE replaces the conflicting rows: they are deleted and the new rows appended,
+  // as UPDATE does for variable length columns. The deletes are staged without a
+  // checkpoint, the checkpoint after the insert commits both.
+  if (conflicting_offsets.empty()) {
+    return true;
+  }
+  const auto deleted_cd = catalog.getDeletedColumn(td);
+  CHECK(deleted_cd);
+  for (const auto& [physical_td, offsets_per_fragment] : conflicting_offsets) {
+    UpdelRoll updel_roll;
+    updel_roll.catalog = &catalog;
+    updel_roll.logicalTableId = td->tableId;
+    updel_roll.memoryLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
+    updel_roll.table_descriptor = physical_td;
+    {
+      const ChunkKey table_key{catalog.getDatabaseId(), td->tableId};
+      const auto table_lock = lockmgr::TableDataLockMgr::getWriteLockForTable(table_key);
+      for (const auto& [fragment_id, offsets] : offsets_per_fragment) {
+        physical_td->fragmenter->updateColumn(&catalog,
+                                              physical_td,
+                                              deleted_cd,
+                                              fragment_id,
+                                              offsets,
+                                              ScalarTargetValue(int64_t(1)),
+                                              deleted_cd->columnType,
+                                              updel_roll.memoryLevel,
+                                              updel_roll);
+      }
+    }
+    if (physical_td->persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
+      updel_roll.stageUpdate();
+    } else {
+      updel_roll.commitUpdate();
+    }
+  }
+  Executor::clearExternalCaches(true, td, catalog.getDatabaseId());
+  return true;
+}
+
 void UpdateStmt::analyze(const Catalog_Namespace::Catalog& catalog,
                          Analyzer::Query& query) const {
   throw std::runtime_error("UPDATE statement not supported yet.");
@@ -4148,7 +4304,7 @@ void InsertIntoTableAsSelectStmt::execute(const Catalog_Namespace::SessionInfo&
       catalog, select_query_, query_state->createQueryStateProxy(), table_name_);
   const TableDescriptor* td = catalog.getMetadataForTable(table_name_);
 
-  Executor::clearExternalCaches(true, td, catalog.getCurrentDB().dbId);
+  Executor::clearExternalCachesForAppend(td, catalog.getCurrentDB().dbId);
 
   try {
     populateData(query_state->createQueryStateProxy(), td, true, false);
@@ -4533,6 +4689,19 @@ OptimizeTableStmt::OptimizeTableStmt(const rapidjson::Value& payload) {
   parse_options(payload, options_);
 }
 
+bool OptimizeTableStmt::shouldMergeFragments() const {
+  for (const auto& e : options_) {
+    if (boost::iequals(*(e->get_name()), "MERGE_FRAGMENTS")) {
+      const auto str_literal = dynamic_cast<const StringLiteral*>(e->get_value());
+      if (!str_literal) {
+        throw std::runtime_error("MERGE_FRAGMENTS option must be a boolean string.");
+      }
+      return bool_from_string_literal(str_literal);
+    }
+  }
+  return false;
+}
+
 namespace {
 bool user_can_access_table(const Catalog_Namespace::SessionInfo& session_info,
                            const TableDescriptor* td,
@@ -4578,6 +4747,9 @@ void OptimizeTableStmt::execute(const Catalog_Namespace::SessionInfo& session) {
   if (shouldVacuumDeletedRows()) {
     optimizer.vacuumDeletedRows();
   }
+  if (shouldMergeFragments()) {
+    optimizer.mergeUnderfilledFragments();
+  }
   optimizer.recomputeMetadata();
 }
 
@@ -5314,7 +5486,7 @@ void CopyTableStmt::execute(
     }
 
     // invalidate cached item
-    Executor::clearExternalCaches(true, td, catalog.getCurrentDB().dbId);
+    Executor::clearExternalCachesForAppend(td, catalog.getCurrentDB().dbId);
   }
 
   import_export::CopyParams copy_params;
@@ -1268,6 +1268,8 @@ class OptimizeTableStmt : public DDLStmt {
     return false;
   }
 
+  bool shouldMergeFragments() const;
+
   void execute(const Catalog_Namespace::SessionInfo& session) override;
 
  private:
@@ -2120,7 +2122,17 @@ class InsertValuesStmt : public InsertStmt {
   Fragmenter_Namespace::InsertDataLoader::InsertConnector* leafs_connector_ = nullptr;
 
  private:
+  // Handles the rows conflicting with existing rows on the ON CONFLICT column. Returns
+  // false if no rows are left to insert.
+  bool applyOnConflict(const Catalog_Namespace::Catalog& catalog,
+                       const TableDescriptor* td,
+                       Analyzer::Query& query) const;
+
   std::vector<std::unique_ptr<ValuesList>> values_lists_;
+  // ON CONFLICT (column) DO UPDATE replaces the conflicting rows, DO NOTHING skips the
+  // inserted rows instead
+  std::unique_ptr<std::string> on_conflict_column_;
+  bool on_conflict_do_update_{false};
 };
 
 /*
@@ -68,6 +68,7 @@ const std::string explain_str = {"explain"};
 const std::string calcite_explain_str = {"explain calcite"};
 const std::string optimized_explain_str = {"explain optimized"};
 const std::string plan_explain_str = {"explain plan"};
+const std::string analyze_explain_str = {"explain analyze"};
 const std::string optimize_str = {"optimize"};
 const std::string validate_str = {"validate"};
 
@@ -177,6 +178,15 @@ void ParserWrapper::initExplainType(std::string query_string) {
       explain_type_ = ExplainType::ExecutionPlan;
     }
 
+  } else if (boost::istarts_with(query_string, analyze_explain_str)) {
+    actual_query_ = boost::trim_copy(query_string.substr(analyze_explain_str.size()));
+    ParserWrapper inner{actual_query_};
+    if (inner.isDdl() || inner.is_update_dml) {
+      explain_type_ = ExplainType::Other;
+    } else {
+      explain_type_ = ExplainType::Analyze;
+    }
+
   } else if (boost::istarts_with(query_string, explain_str)) {
     actual_query_ = boost::trim_copy(query_string.substr(explain_str.size()));
     ParserWrapper inner{actual_query_};
@@ -192,5 +202,6 @@ ExplainInfo ParserWrapper::getExplainInfo() const {
   return {explain_type_ == ExplainType::IR,
           explain_type_ == ExplainType::OptimizedIR,
           explain_type_ == ExplainType::ExecutionPlan,
-          explain_type_ == ExplainType::Calcite};
+          explain_type_ == ExplainType::Calcite,
+          explain_type_ == ExplainType::Analyze};
 }
@@ -34,8 +34,11 @@ struct ExplainInfo {
   bool explain_optimized;
   bool explain_plan;
   bool calcite_explain;
+  bool explain_analyze;
 
-  static ExplainInfo defaults() { return ExplainInfo{false, false, false, false}; }
+  static ExplainInfo defaults() {
+    return ExplainInfo{false, false, false, false, false};
+  }
 
   bool justExplain() const { return explain || explain_plan || explain_optimized; }
 
@@ -47,7 +50,15 @@ class ParserWrapper {
   // HACK:  This needs to go away as calcite takes over parsing
   enum class DMLType : int { Insert = 0, Delete, Update, Upsert, NotDML };
 
-  enum class ExplainType { None, IR, OptimizedIR, Calcite, ExecutionPlan, Other };
+  enum class ExplainType {
+    None,
+    IR,
+    OptimizedIR,
+    Calcite,
+    ExecutionPlan,
+    Analyze,
+    Other
+  };
 
   enum class QueryType { Unknown, Read, Write, SchemaRead, SchemaWrite };
 
@@ -85,10 +96,14 @@ class ParserWrapper {
 
   bool isPlanExplain() const { return explain_type_ == ExplainType::ExecutionPlan; }
 
+  // EXPLAIN ANALYZE executes the query, unlike the other kinds of explain.
+  bool isAnalyzeExplain() const { return explain_type_ == ExplainType::Analyze; }
+
   bool isSelectExplain() const {
     return explain_type_ == ExplainType::Calcite || explain_type_ == ExplainType::IR ||
            explain_type_ == ExplainType::OptimizedIR ||
-           explain_type_ == ExplainType::ExecutionPlan;
+           explain_type_ == ExplainType::ExecutionPlan ||
+           explain_type_ == ExplainType::Analyze;
   }
 
   bool isIRExplain() const {
@@ -23,6 +23,7 @@
 #include "TargetMetaInfo.h"
 #include "TargetValue.h"
 
+#include <optional>
 #include <type_traits>
 
 #include "arrow/api.h"
@@ -307,9 +308,22 @@ class ArrowResultSetConverter {
 
   std::shared_ptr<arrow::RecordBatch> convertToArrow() const;
 
+  // Converts the result set entries in [start_entry, end_entry) only, which bounds the
+  // memory needed to convert large results. Empty entries are skipped, so the batch has
+  // at most end_entry - start_entry rows.
+  std::shared_ptr<arrow::RecordBatch> convertToArrow(const size_t start_entry,
+                                                     const size_t end_entry) const;
+
+  std::shared_ptr<arrow::Schema> getArrowSchema() const;
+
  private:
+  // Number of entries converted by convertToArrow(), limited by first_n.
+  size_t getConvertedEntryCount() const;
+
   std::shared_ptr<arrow::RecordBatch> getArrowBatch(
-      const std::shared_ptr<arrow::Schema>& schema) const;
+      const std::shared_ptr<arrow::Schema>& schema,
+      const size_t start_entry,
+      const size_t end_entry) const;
 
   std::shared_ptr<arrow::Field> makeField(const std::string name,
                                           const SQLTypeInfo& target_type) const;
@@ -321,10 +335,14 @@ class ArrowResultSetConverter {
   SerializedArrowOutput getSerializedArrowOutput(
       arrow::ipc::DictionaryFieldMapper* mapper) const;
 
-  void initializeColumnBuilder(ColumnBuilder& column_builder,
-                               const SQLTypeInfo& col_type,
-                               const size_t result_col_idx,
-                               const std::shared_ptr<arrow::Field>& field) const;
+  // Builds the dictionary of a dict encoded string column from the strings of the given
+  // range of entries only, if any, or else from those of the whole result.
+  void initializeColumnBuilder(
+      ColumnBuilder& column_builder,
+      const SQLTypeInfo& col_type,
+      const size_t result_col_idx,
+      const std::shared_ptr<arrow::Field>& field,
+      const std::optional<std::pair<size_t, size_t>>& entry_range = std::nullopt) const;
 
   void append(ColumnBuilder& column_builder,
               const ValueArray& values,
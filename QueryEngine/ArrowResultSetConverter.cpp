@@ -609,8 +609,7 @@ ArrowResultSetConverter::getSerializedArrowOutput(
   return {serialized_schema, serialized_records};
 }
 
-std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::convertToArrow() const {
-  auto timer = DEBUG_TIMER(__func__);
+std::shared_ptr<arrow::Schema> ArrowResultSetConverter::getArrowSchema() const {
   const auto col_count = results_->colCount();
   std::vector<std::shared_ptr<arrow::Field>> fields;
   CHECK(col_names_.empty() || col_names_.size() == col_count);
@@ -624,11 +623,32 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::convertToArrow() co
     VLOG(1) << "\t" << f->ToString(true);
   }
 #endif
-  return getArrowBatch(arrow::schema(fields));
+  return arrow::schema(fields);
+}
+
+size_t ArrowResultSetConverter::getConvertedEntryCount() const {
+  return top_n_ < 0 ? results_->entryCount()
+                    : std::min(size_t(top_n_), results_->entryCount());
+}
+
+std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::convertToArrow() const {
+  auto timer = DEBUG_TIMER(__func__);
+  return getArrowBatch(getArrowSchema(), 0, getConvertedEntryCount());
+}
+
+std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::convertToArrow(
+    const size_t start_entry,
+    const size_t end_entry) const {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK_LE(start_entry, end_entry);
+  CHECK_LE(end_entry, results_->entryCount());
+  return getArrowBatch(getArrowSchema(), start_entry, end_entry);
 }
 
 std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
-    const std::shared_ptr<arrow::Schema>& schema) const {
+    const std::shared_ptr<arrow::Schema>& schema,
+    const size_t start_entry,
+    const size_t end_entry) const {
   std::vector<std::shared_ptr<arrow::Array>> result_columns;
 
   // First, check if the result set is empty.
@@ -638,9 +658,7 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
     return ARROW_RECORDBATCH_MAKE(schema, 0, result_columns);
   }
 
-  const size_t entry_count = top_n_ < 0
-                                 ? results_->entryCount()
-                                 : std::min(size_t(top_n_), results_->entryCount());
+  const size_t entry_count = end_entry - start_entry;
 
   const auto col_count = results_->colCount();
   size_t row_count = 0;
@@ -648,9 +666,17 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
   result_columns.resize(col_count);
   std::vector<ColumnBuilder> builders(col_count);
 
-  // Create array builders
+  // Create array builders. When converting a range of the entries only, the string
+  // dictionaries only hold the strings of that range.
+  const bool is_partial_conversion =
+      start_entry != 0 || end_entry != getConvertedEntryCount();
+  const auto entry_range =
+      is_partial_conversion
+          ? std::make_optional(std::make_pair(start_entry, end_entry))
+          : std::nullopt;
   for (size_t i = 0; i < col_count; ++i) {
-    initializeColumnBuilder(builders[i], results_->getColType(i), i, schema->field(i));
+    initializeColumnBuilder(
+        builders[i], results_->getColType(i), i, schema->field(i), entry_range);
   }
 
   // TODO(miyu): speed up for columnar buffers
@@ -804,6 +830,7 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
                                      QueryDescriptionType::Projection ||
                                  results_->getQueryMemDesc().getQueryDescriptionType() ==
                                      QueryDescriptionType::TableFunction) &&
+                                start_entry == 0 &&
                                 entry_count == results_->entryCount();
   std::vector<bool> non_lazy_cols;
   if (use_columnar_converter) {
@@ -882,16 +909,16 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
       std::vector<std::vector<std::shared_ptr<std::vector<bool>>>> null_bitmap_segs(
           cpu_count, std::vector<std::shared_ptr<std::vector<bool>>>(col_count, nullptr));
       const auto stride = (entry_count + cpu_count - 1) / cpu_count;
-      for (size_t i = 0, start_entry = 0; start_entry < entry_count;
-           ++i, start_entry += stride) {
-        const auto end_entry = std::min(entry_count, start_entry + stride);
+      for (size_t i = 0, seg_start_entry = start_entry; seg_start_entry < end_entry;
+           ++i, seg_start_entry += stride) {
+        const auto seg_end_entry = std::min(end_entry, seg_start_entry + stride);
         child_threads.push_back(std::async(std::launch::async,
                                            fetch,
                                            std::ref(column_value_segs[i]),
                                            std::ref(null_bitmap_segs[i]),
                                            non_lazy_cols,
-                                           start_entry,
-                                           end_entry));
+                                           seg_start_entry,
+                                           seg_end_entry));
       }
       for (auto& child : child_threads) {
         row_count += child.get();
@@ -913,11 +940,12 @@ std::shared_ptr<arrow::RecordBatch> ArrowResultSetConverter::getArrowBatch(
       }
     } else {
       row_count =
-          fetch(column_values, null_bitmaps, non_lazy_cols, size_t(0), entry_count);
+          fetch(column_values, null_bitmaps, non_lazy_cols, start_entry, end_entry);
       {
         auto timer = DEBUG_TIMER("append rows to arrow single thread");
         for (int i = 0; i < schema->num_fields(); ++i) {
-          if (!non_lazy_cols.empty() && non_lazy_cols[i]) {
+          if ((!non_lazy_cols.empty() && non_lazy_cols[i]) || !column_values[i]) {
+            // no rows in the converted entries
             continue;
           }
 
@@ -1061,7 +1089,8 @@ void ArrowResultSetConverter::initializeColumnBuilder(
     ColumnBuilder& column_builder,
     const SQLTypeInfo& col_type,
     const size_t results_col_slot_idx,
-    const std::shared_ptr<arrow::Field>& field) const {
+    const std::shared_ptr<arrow::Field>& field,
+    const std::optional<std::pair<size_t, size_t>>& entry_range) const {
   column_builder.field = field;
   column_builder.col_type = col_type;
   column_builder.physical_type = col_type.is_dict_encoded_string()
@@ -1077,10 +1106,12 @@ void ArrowResultSetConverter::initializeColumnBuilder(
 
     // ResultSet::rowCount(), unlike ResultSet::entryCount(), will return
     // the actual number of rows in the result set, taking into account
-    // things like any limit and offset set
-    const size_t result_set_rows = results_->rowCount();
-    // result_set_rows guaranteed > 0 by parent
-    CHECK_GT(result_set_rows, 0UL);
+    // things like any limit and offset set. For a range of entries, the number of
+    // entries bounds the number of rows.
+    const size_t result_set_rows =
+        entry_range ? entry_range->second - entry_range->first : results_->rowCount();
+    // result_set_rows guaranteed > 0 by parent for the whole result
+    CHECK(entry_range || result_set_rows > 0UL);
 
     auto sdp = results_->getStringDictionaryProxy(dict_id);
     const size_t dictionary_proxy_entries = sdp->entryCount();
@@ -1101,8 +1132,10 @@ void ArrowResultSetConverter::initializeColumnBuilder(
     // for clients (which often is a web browser with a lot less compute and memory
     // resources than our server.)
 
+    // A range of entries, e.g. one batch of a streaming reader, never copies the whole
+    // dictionary, the batches would otherwise each hold a copy of it.
     const bool do_dictionary_bulk_fetch =
-        result_set_rows > min_result_size_for_bulk_dictionary_fetch_ &&
+        !entry_range && result_set_rows > min_result_size_for_bulk_dictionary_fetch_ &&
         dictionary_to_result_size_ratio <=
             max_dictionary_to_result_size_ratio_for_bulk_dictionary_fetch_;
 
@@ -1149,7 +1182,10 @@ void ArrowResultSetConverter::initializeColumnBuilder(
       // placed at the same offset in their respective vectors
 
       auto unique_ids_and_strings =
-          results_->getUniqueStringsForDictEncodedTargetCol(results_col_slot_idx);
+          entry_range ? results_->getUniqueStringsForDictEncodedTargetCol(
+                            results_col_slot_idx, entry_range->first, entry_range->second)
+                      : results_->getUniqueStringsForDictEncodedTargetCol(
+                            results_col_slot_idx);
       const auto& unique_ids = unique_ids_and_strings.first;
       const auto& unique_strings = unique_ids_and_strings.second;
       ARROW_THROW_NOT_OK(str_array_builder.AppendValues(unique_strings));
@@ -51,6 +51,21 @@ void CodeCacheAccessor<CompilationContext>::put(const CodeCacheKey& key,
   }
 }
 
+template <typename CompilationContext>
+bool CodeCacheAccessor<CompilationContext>::overwrite(
+    const CodeCacheKey& key,
+    CodeCacheVal<CompilationContext>& value) {
+  std::lock_guard<std::mutex> lock(code_cache_mutex_);
+  auto cached_code = code_cache_.get(key);
+  // do not replace the placeholder inserted by get_or_wait, its waiters expect swap
+  if (!cached_code || !cached_code->get()) {
+    return false;
+  }
+  overwrite_count_++;
+  *cached_code = value;
+  return true;
+}
+
 template <typename CompilationContext>
 CodeCacheVal<CompilationContext>* CodeCacheAccessor<CompilationContext>::get_or_wait(
     const CodeCacheKey& key) {
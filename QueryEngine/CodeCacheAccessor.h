@@ -37,12 +37,21 @@ class CodeCacheAccessor {
   // TODO: replace get_value/put with get_or_wait/swap workflow.
   CodeCacheVal<CompilationContext> get_value(const CodeCacheKey& key);
   void put(const CodeCacheKey& key, CodeCacheVal<CompilationContext>& value);
+  // Replaces the code cached for the given key, e.g. by a better optimized version of
+  // the same code. No-op if the key has been evicted in the meantime. Returns true if
+  // the code was replaced.
+  bool overwrite(const CodeCacheKey& key, CodeCacheVal<CompilationContext>& value);
 
   // get_or_wait and swap should be used in pair.
   CodeCacheVal<CompilationContext>* get_or_wait(const CodeCacheKey& key);
   void swap(const CodeCacheKey& key, CodeCacheVal<CompilationContext>&& value);
   void clear();
 
+  int64_t getOverwriteCount() {
+    std::lock_guard<std::mutex> lock(code_cache_mutex_);
+    return overwrite_count_;
+  }
+
   void evictFractionEntries(const float fraction) {
     std::lock_guard<std::mutex> lock(code_cache_mutex_);
     evict_count_++;
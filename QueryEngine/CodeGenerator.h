@@ -78,10 +78,13 @@ class CodeGenerator {
       const std::vector<llvm::Function*>& roots,
       const std::vector<llvm::Function*>& leaves);
 
+  // If a persistent code cache entry holding the object code is given, the IR
+  // optimization and native codegen are skipped and the cached object is loaded.
   static ExecutionEngineWrapper generateNativeCPUCode(
       llvm::Function* func,
       const std::unordered_set<llvm::Function*>& live_funcs,
-      const CompilationOptions& co);
+      const CompilationOptions& co,
+      PersistentCodeCache::Entry* persistent_cache_entry = nullptr);
 
   static std::string generatePTX(const std::string& cuda_llir,
                                  llvm::TargetMachine* nvptx_target_machine,
@@ -97,7 +97,7 @@ std::pair<const int8_t*, size_t> ColumnFetcher::getOneColumnFragment(
                        fragment.physicalTableId,
                        hash_col.get_column_id(),
                        fragment.fragmentId};
-    const auto chunk = Chunk_NS::Chunk::getChunk(
+    const auto chunk = fragment.getChunk(
         cd,
         &catalog.getDataMgr(),
         chunk_key,
@@ -245,7 +245,7 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
     if (is_varlen) {
       varlen_chunk_lock.reset(new std::lock_guard<std::mutex>(varlen_chunk_fetch_mutex_));
     }
-    chunk = Chunk_NS::Chunk::getChunk(
+    chunk = fragment.getChunk(
         cd,
         &cat.getDataMgr(),
         chunk_key,
@@ -256,6 +256,9 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
     std::lock_guard<std::mutex> chunk_list_lock(chunk_list_mutex_);
     chunk_holder.push_back(chunk);
   }
+  if (auto execution_stats = executor_->getExecutionStats()) {
+    execution_stats->addFetchedBytes(memory_level, chunk_meta_it->second->numBytes);
+  }
   if (is_varlen) {
     CHECK_GT(table_id, 0);
     CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
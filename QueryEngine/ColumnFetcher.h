@@ -39,9 +39,20 @@ struct hash<std::pair<int, int>> {
 }  // namespace std
 
 struct FetchResult {
+  // A lazily fetched column whose buffer was left null in col_buffers, to be loaded
+  // only if the query kernel produces rows, see g_enable_late_materialization.
+  struct DeferredColumn {
+    size_t frag_idx;  // index into col_buffers
+    int local_col_id;
+    int table_id;
+    int frag_id;
+    int col_id;
+  };
+
   std::vector<std::vector<const int8_t*>> col_buffers;
   std::vector<std::vector<int64_t>> num_rows;
   std::vector<std::vector<uint64_t>> frag_offsets;
+  std::vector<DeferredColumn> deferred_columns;
 };
 
 using MergedChunk = std::pair<AbstractBuffer*, AbstractBuffer*>;
@@ -0,0 +1,312 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/ColumnStatistics.h"
+
+#include <algorithm>
+
+#include "DataMgr/ChunkMetadata.h"
+
+namespace {
+
+bool is_integral_column(const SQLTypeInfo& ti) {
+  return ti.is_integer() || ti.is_decimal() || ti.is_time() || ti.is_boolean() ||
+         ti.is_dict_encoded_string();
+}
+
+// Fraction of the rows of the bucket below value, assuming uniformly distributed values.
+double bucket_fraction_below(const ColumnStatistics::Bucket& bucket,
+                             const double value,
+                             const bool inclusive) {
+  if (value < bucket.min) {
+    return 0;
+  }
+  if (value > bucket.max) {
+    return 1;
+  }
+  if (bucket.max == bucket.min) {
+    return inclusive ? 1 : 0;
+  }
+  return (value - bucket.min) / (bucket.max - bucket.min);
+}
+
+SQLOps commute_comparison(const SQLOps op) {
+  switch (op) {
+    case kLT:
+      return kGT;
+    case kLE:
+      return kGE;
+    case kGT:
+      return kLT;
+    case kGE:
+      return kLE;
+    default:
+      return op;
+  }
+}
+
+const Analyzer::ColumnVar* get_column_var(const Analyzer::Expr* expr,
+                                          const bool allow_casts) {
+  const auto uoper = dynamic_cast<const Analyzer::UOper*>(expr);
+  if (allow_casts && uoper && uoper->get_optype() == kCAST) {
+    return get_column_var(uoper->get_operand(), allow_casts);
+  }
+  return dynamic_cast<const Analyzer::ColumnVar*>(expr);
+}
+
+// Returns the value of the literal in the representation of the column's chunk
+// metadata, if the types allow comparing them directly.
+std::optional<double> get_literal_value(const Analyzer::Constant* literal,
+                                        const SQLTypeInfo& column_ti) {
+  if (!literal || literal->get_is_null()) {
+    return std::nullopt;
+  }
+  const auto& literal_ti = literal->get_type_info();
+  if (column_ti.is_fp() && literal_ti.is_fp()) {
+    return extract_fp_type_from_datum(literal->get_constval(), literal_ti);
+  }
+  const bool same_representation =
+      (column_ti.is_integer() && literal_ti.is_integer()) ||
+      (column_ti.is_decimal() && literal_ti.is_decimal() &&
+       column_ti.get_scale() == literal_ti.get_scale()) ||
+      (column_ti.is_time() && literal_ti.get_type() == column_ti.get_type() &&
+       literal_ti.get_dimension() == column_ti.get_dimension());
+  if (!same_representation) {
+    return std::nullopt;
+  }
+  return extract_int_type_from_datum(literal->get_constval(), literal_ti);
+}
+
+}  // namespace
+
+double ColumnStatistics::estimateComparisonSelectivity(const SQLOps op,
+                                                       const double value) const {
+  if (!has_range || histogram.empty()) {
+    return op == kEQ ? kDefaultEqualitySelectivity
+                     : op == kNE ? 1 - kDefaultEqualitySelectivity
+                                 : kDefaultRangeSelectivity;
+  }
+  size_t num_range_rows{0};
+  for (const auto& bucket : histogram) {
+    num_range_rows += bucket.num_rows;
+  }
+  CHECK_GT(num_range_rows, size_t(0));
+  auto fraction_below = [this, num_range_rows](const double value, const bool inclusive) {
+    double num_rows_below{0};
+    for (const auto& bucket : histogram) {
+      num_rows_below += bucket.num_rows * bucket_fraction_below(bucket, value, inclusive);
+    }
+    return num_rows_below / num_range_rows;
+  };
+  switch (op) {
+    case kEQ:
+      return value < min || value > max ? 0 : estimateEqualitySelectivity();
+    case kNE:
+      return value < min || value > max ? 1 : 1 - estimateEqualitySelectivity();
+    case kLT:
+      return fraction_below(value, false);
+    case kLE:
+      return fraction_below(value, true);
+    case kGT:
+      return 1 - fraction_below(value, true);
+    case kGE:
+      return 1 - fraction_below(value, false);
+    default:
+      return kDefaultSelectivity;
+  }
+}
+
+double ColumnStatistics::estimateEqualitySelectivity() const {
+  return num_distinct_values > 0 ? 1 / num_distinct_values : kDefaultEqualitySelectivity;
+}
+
+ColumnStatistics compute_column_statistics(
+    const Fragmenter_Namespace::TableInfo& table_info,
+    const int column_id,
+    const SQLTypeInfo& column_ti) {
+  ColumnStatistics stats;
+  stats.num_rows = table_info.getNumTuplesUpperBound();
+  stats.num_distinct_values = std::max(stats.num_rows, size_t(1));
+  const bool is_integral = is_integral_column(column_ti);
+  if (!is_integral && !column_ti.is_fp()) {
+    return stats;
+  }
+  for (const auto& fragment : table_info.fragments) {
+    if (fragment.resultSet) {
+      // intermediate results have no chunk metadata until it is synthesized
+      return stats;
+    }
+    const auto& chunk_metadata_map = fragment.getChunkMetadataMapPhysical();
+    const auto chunk_metadata_it = chunk_metadata_map.find(column_id);
+    if (chunk_metadata_it == chunk_metadata_map.end() ||
+        chunk_metadata_it->second->numElements == 0) {
+      continue;
+    }
+    const auto& chunk_stats = chunk_metadata_it->second->chunkStats;
+    stats.has_nulls |= chunk_stats.has_nulls;
+    const double chunk_min = is_integral
+                                 ? extract_min_stat_int_type(chunk_stats, column_ti)
+                                 : extract_min_stat_fp_type(chunk_stats, column_ti);
+    const double chunk_max = is_integral
+                                 ? extract_max_stat_int_type(chunk_stats, column_ti)
+                                 : extract_max_stat_fp_type(chunk_stats, column_ti);
+    if (chunk_min > chunk_max) {
+      // only nulls in the chunk
+      continue;
+    }
+    stats.histogram.push_back(
+        {chunk_min, chunk_max, chunk_metadata_it->second->numElements});
+  }
+  if (stats.histogram.empty()) {
+    return stats;
+  }
+  stats.has_range = true;
+  stats.min = stats.histogram.front().min;
+  stats.max = stats.histogram.front().max;
+  for (const auto& bucket : stats.histogram) {
+    stats.min = std::min(stats.min, bucket.min);
+    stats.max = std::max(stats.max, bucket.max);
+  }
+  if (is_integral) {
+    stats.num_distinct_values =
+        std::min(stats.num_distinct_values, stats.max - stats.min + 1);
+  }
+  return stats;
+}
+
+const ColumnStatistics* ColumnStatisticsProvider::getColumnStatistics(
+    const Analyzer::ColumnVar* col_var) {
+  CHECK(col_var);
+  const auto rte_idx = col_var->get_rte_idx();
+  if (rte_idx < 0 || static_cast<size_t>(rte_idx) >= table_infos_.size()) {
+    return nullptr;
+  }
+  const auto key = std::make_pair(rte_idx, col_var->get_column_id());
+  auto it = column_statistics_.find(key);
+  if (it == column_statistics_.end()) {
+    std::optional<ColumnStatistics> column_statistics;
+    if (table_infos_[rte_idx].table_id >= 0) {
+      column_statistics = compute_column_statistics(
+          table_infos_[rte_idx].info, col_var->get_column_id(), col_var->get_type_info());
+    }
+    it = column_statistics_.emplace(key, std::move(column_statistics)).first;
+  }
+  return it->second ? &*it->second : nullptr;
+}
+
+double ColumnStatisticsProvider::estimateSelectivity(const Analyzer::Expr* qual) {
+  if (const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual)) {
+    const auto op = bin_oper->get_optype();
+    if (op == kAND || op == kOR) {
+      const auto lhs_selectivity = estimateSelectivity(bin_oper->get_left_operand());
+      const auto rhs_selectivity = estimateSelectivity(bin_oper->get_right_operand());
+      return op == kAND ? lhs_selectivity * rhs_selectivity
+                        : lhs_selectivity + rhs_selectivity -
+                              lhs_selectivity * rhs_selectivity;
+    }
+    if (IS_COMPARISON(op)) {
+      return std::clamp(estimateComparisonSelectivity(bin_oper), 0., 1.);
+    }
+    return kDefaultSelectivity;
+  }
+  if (const auto uoper = dynamic_cast<const Analyzer::UOper*>(qual)) {
+    if (uoper->get_optype() == kNOT) {
+      return 1 - estimateSelectivity(uoper->get_operand());
+    }
+    if (uoper->get_optype() == kISNULL) {
+      const auto col_var = get_column_var(uoper->get_operand(), true);
+      const auto stats = col_var ? getColumnStatistics(col_var) : nullptr;
+      return stats && !stats->has_nulls ? 0 : kDefaultEqualitySelectivity;
+    }
+    return kDefaultSelectivity;
+  }
+  if (const auto in_values = dynamic_cast<const Analyzer::InValues*>(qual)) {
+    const auto col_var = get_column_var(in_values->get_arg(), true);
+    const auto stats = col_var ? getColumnStatistics(col_var) : nullptr;
+    const auto equality_selectivity =
+        stats ? stats->estimateEqualitySelectivity() : kDefaultEqualitySelectivity;
+    return std::min(1., in_values->get_value_list().size() * equality_selectivity);
+  }
+  return kDefaultSelectivity;
+}
+
+double ColumnStatisticsProvider::estimateComparisonSelectivity(
+    const Analyzer::BinOper* bin_oper) {
+  auto op = bin_oper->get_optype();
+  auto col_var = get_column_var(bin_oper->get_left_operand(), false);
+  auto literal = dynamic_cast<const Analyzer::Constant*>(bin_oper->get_right_operand());
+  if (!col_var) {
+    col_var = get_column_var(bin_oper->get_right_operand(), false);
+    literal = dynamic_cast<const Analyzer::Constant*>(bin_oper->get_left_operand());
+    op = commute_comparison(op);
+  }
+  const auto stats = col_var && literal ? getColumnStatistics(col_var) : nullptr;
+  if (stats) {
+    if (const auto value = get_literal_value(literal, col_var->get_type_info())) {
+      return stats->estimateComparisonSelectivity(op, *value);
+    }
+    // dictionary-encoded strings compared to a string literal
+    if (op == kEQ || op == kBW_EQ) {
+      return stats->estimateEqualitySelectivity();
+    }
+    if (op == kNE) {
+      return 1 - stats->estimateEqualitySelectivity();
+    }
+  }
+  return op == kEQ || op == kBW_EQ ? kDefaultEqualitySelectivity
+         : op == kNE               ? 1 - kDefaultEqualitySelectivity
+                                   : kDefaultRangeSelectivity;
+}
+
+double ColumnStatisticsProvider::estimateJoinSelectivity(
+    const Analyzer::BinOper* join_qual) {
+  CHECK(join_qual);
+  const auto lhs_tuple =
+      dynamic_cast<const Analyzer::ExpressionTuple*>(join_qual->get_left_operand());
+  const auto rhs_tuple =
+      dynamic_cast<const Analyzer::ExpressionTuple*>(join_qual->get_right_operand());
+  if (lhs_tuple && rhs_tuple) {
+    // the composite key is at least as selective as each of its components
+    double selectivity{1};
+    CHECK_EQ(lhs_tuple->getTuple().size(), rhs_tuple->getTuple().size());
+    for (size_t i = 0; i < lhs_tuple->getTuple().size(); ++i) {
+      selectivity = std::min(
+          selectivity,
+          1 / std::max(estimateDistinctValues(lhs_tuple->getTuple()[i].get()),
+                       estimateDistinctValues(rhs_tuple->getTuple()[i].get())));
+    }
+    return selectivity;
+  }
+  return 1 / std::max(estimateDistinctValues(join_qual->get_left_operand()),
+                      estimateDistinctValues(join_qual->get_right_operand()));
+}
+
+double ColumnStatisticsProvider::estimateDistinctValues(const Analyzer::Expr* expr) {
+  const auto col_var = get_column_var(expr, true);
+  if (!col_var) {
+    return 1 / kDefaultEqualitySelectivity;
+  }
+  if (const auto stats = getColumnStatistics(col_var)) {
+    return std::max(stats->num_distinct_values, 1.);
+  }
+  const auto rte_idx = col_var->get_rte_idx();
+  if (rte_idx < 0 || static_cast<size_t>(rte_idx) >= table_infos_.size()) {
+    return 1 / kDefaultEqualitySelectivity;
+  }
+  // no statistics for intermediate results, assume the column is a key
+  return std::max(
+      static_cast<double>(table_infos_[rte_idx].info.getNumTuplesUpperBound()), 1.);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ColumnStatistics.h
+ * @brief   Column statistics and selectivity estimates used for costing query plans.
+ *
+ * The statistics are derived from the per-fragment chunk metadata, which the encoders
+ * maintain incrementally on every append and TableOptimizer::recomputeMetadata narrows
+ * after updates and deletes. Every fragment contributes one bucket, covering its
+ * [min, max] range, to a histogram of the column. The number of distinct values is
+ * estimated from the row count and the width of the value range, which makes it exact
+ * for dense keys and dictionary-encoded strings.
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "Analyzer/Analyzer.h"
+#include "QueryEngine/InputMetadata.h"
+
+// Selectivities used when a qualifier cannot be estimated from the statistics.
+constexpr double kDefaultEqualitySelectivity{0.1};
+constexpr double kDefaultRangeSelectivity{1. / 3};
+constexpr double kDefaultSelectivity{0.25};
+
+struct ColumnStatistics {
+  struct Bucket {
+    double min;
+    double max;
+    size_t num_rows;
+  };
+
+  size_t num_rows{0};
+  bool has_nulls{false};
+  // Set for the types whose chunk metadata holds a value range.
+  bool has_range{false};
+  double min{0};
+  double max{0};
+  double num_distinct_values{0};
+  std::vector<Bucket> histogram;
+
+  // Estimated fraction of the rows for which `column op value` holds.
+  double estimateComparisonSelectivity(const SQLOps op, const double value) const;
+
+  double estimateEqualitySelectivity() const;
+};
+
+ColumnStatistics compute_column_statistics(
+    const Fragmenter_Namespace::TableInfo& table_info,
+    const int column_id,
+    const SQLTypeInfo& column_ti);
+
+// Computes the statistics of the columns of a set of tables on first use. Tables are
+// indexed by their nest level, as in the query infos of an execution unit.
+class ColumnStatisticsProvider {
+ public:
+  ColumnStatisticsProvider(const std::vector<InputTableInfo>& table_infos)
+      : table_infos_(table_infos) {}
+
+  // Returns nullptr if no statistics are available for the column, e.g. for the
+  // columns of intermediate results.
+  const ColumnStatistics* getColumnStatistics(const Analyzer::ColumnVar* col_var);
+
+  // Estimated fraction of the rows of the column's table the qualifier keeps. The
+  // qualifier must only reference a single nest level.
+  double estimateSelectivity(const Analyzer::Expr* qual);
+
+  // Estimated fraction of the cross product of two tables an equi-join qualifier
+  // between them keeps.
+  double estimateJoinSelectivity(const Analyzer::BinOper* join_qual);
+
+ private:
+  double estimateComparisonSelectivity(const Analyzer::BinOper* bin_oper);
+  double estimateDistinctValues(const Analyzer::Expr* expr);
+
+  const std::vector<InputTableInfo>& table_infos_;
+  std::map<std::pair<int, int>, std::optional<ColumnStatistics>> column_statistics_;
+};
@@ -18,6 +18,7 @@
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/JITEventListener.h>
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
 #include <memory>
@@ -63,6 +64,13 @@ class CpuCompilationContext : public CompilationContext {
   CpuCompilationContext(ExecutionEngineWrapper&& execution_engine)
       : execution_engine_(std::move(execution_engine)) {}
 
+  // Used when the code was generated in a dedicated LLVM context, e.g. by a background
+  // compilation, which has to outlive the execution engine.
+  CpuCompilationContext(ExecutionEngineWrapper&& execution_engine,
+                        std::unique_ptr<llvm::LLVMContext> llvm_context)
+      : llvm_context_(std::move(llvm_context))
+      , execution_engine_(std::move(execution_engine)) {}
+
   void setFunctionPointer(llvm::Function* function) {
     func_ = execution_engine_->getPointerToFunction(function);
     CHECK(func_);
@@ -84,5 +92,7 @@ class CpuCompilationContext : public CompilationContext {
 
  private:
   void* func_{nullptr};
+  // declared before the execution engine, so that it is destroyed after it
+  std::unique_ptr<llvm::LLVMContext> llvm_context_;
   ExecutionEngineWrapper execution_engine_;
 };
@@ -30,7 +30,9 @@ inline std::ostream& operator<<(std::ostream& os, ExecutorDeviceType const dt) {
 }
 #endif
 
-enum class ExecutorOptLevel { Default, ReductionJIT };
+// Unoptimized skips most IR optimizations and uses the fastest native codegen, for
+// code which is replaced by a fully optimized version once it is available.
+enum class ExecutorOptLevel { Default, ReductionJIT, Unoptimized };
 
 enum class ExecutorExplainType { Default, Optimized };
 
@@ -44,6 +44,8 @@ enum CacheItemType {
   OVERLAPS_AUTO_TUNER_PARAM,  // Hashtable auto tuner's params for overlaps join
   QUERY_RESULTSET,            // query resultset
   CHUNK_METADATA,             // query resultset's chunk metadata
+  PARTIAL_QUERY_RESULTSET,    // query resultset of a subset of the input fragments
+  GROUP_BY_LAYOUT_STATS,      // Group by layout and # groups of a query step
   // TODO (yoonmin): support the following items for recycling
   // COUNTALL_CARD_EST,  Cardinality of query result
   // NDV_CARD_EST,       # Non-distinct value
@@ -60,7 +62,9 @@ inline std::ostream& operator<<(std::ostream& os, CacheItemType const item_type)
       "Baseline Join Hashtable's Approximated Cardinality",
       "Overlaps Join Hashtable's Auto Tuner's Parameters",
       "Query ResultSet",
-      "Chunk Metadata"};
+      "Chunk Metadata",
+      "Partial Query ResultSet",
+      "Group By Layout Stats"};
   static_assert(sizeof(cache_item_type_str) / sizeof(*cache_item_type_str) ==
                 NUM_CACHE_ITEM_TYPE);
   return os << cache_item_type_str[item_type];
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GroupByLayoutRecycler.h"
+
+std::optional<GroupByLayoutMetaInfo> GroupByLayoutRecycler::getItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::optional<EMPTY_META_INFO> meta_info) {
+  if (!g_enable_data_recycler || !g_enable_adaptive_group_by_layout ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return std::nullopt;
+  }
+  CHECK_EQ(item_type, CacheItemType::GROUP_BY_LAYOUT_STATS);
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto layout_cache = getCachedItemContainer(item_type, device_identifier);
+  auto cached_layout = getCachedItemWithoutConsideringMetaInfo(
+      key, item_type, device_identifier, *layout_cache, lock);
+  if (cached_layout) {
+    CHECK(!cached_layout->isDirty());
+    VLOG(1) << "[" << item_type << ", "
+            << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+            << "] Recycle group by layout stats in cache (key: " << key << ")";
+    return cached_layout->cached_item;
+  }
+  return std::nullopt;
+}
+
+void GroupByLayoutRecycler::putItemToCache(QueryPlanHash key,
+                                           std::optional<GroupByLayoutMetaInfo> item,
+                                           CacheItemType item_type,
+                                           DeviceIdentifier device_identifier,
+                                           size_t item_size,
+                                           size_t compute_time,
+                                           std::optional<EMPTY_META_INFO> meta_info) {
+  if (!g_enable_data_recycler || !g_enable_adaptive_group_by_layout ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return;
+  }
+  CHECK_EQ(item_type, CacheItemType::GROUP_BY_LAYOUT_STATS);
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto layout_cache = getCachedItemContainer(item_type, device_identifier);
+  auto candidate_it = std::find_if(
+      layout_cache->begin(), layout_cache->end(), [&key](const auto& cached_item) {
+        return cached_item.key == key;
+      });
+  if (candidate_it != layout_cache->end()) {
+    auto& cached_item = candidate_it->cached_item;
+    if (!candidate_it->isDirty() && cached_item && item &&
+        cached_item->layout == QueryDescriptionType::GroupByPerfectHash &&
+        item->layout == QueryDescriptionType::GroupByBaselineHash) {
+      // keep the sparse perfect hash stats which made us switch to the baseline layout
+      cached_item->num_groups = item->num_groups;
+      return;
+    }
+    cached_item = item;
+    candidate_it->dirty = false;
+    VLOG(1) << "[" << item_type << ", "
+            << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+            << "] Update group by layout stats in cache (key: " << key << ")";
+    return;
+  }
+  if (layout_cache->size() >= GROUP_BY_LAYOUT_CACHE_MAX_NUM_ITEMS) {
+    cleanupCacheForInsertion(item_type, device_identifier, 1, lock);
+  }
+  layout_cache->emplace_back(key, item, nullptr, meta_info);
+  VLOG(1) << "[" << item_type << ", "
+          << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+          << "] Put group by layout stats to cache (key: " << key << ")";
+}
+
+bool GroupByLayoutRecycler::hasItemInCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<EMPTY_META_INFO> meta_info) const {
+  if (!g_enable_data_recycler || !g_enable_adaptive_group_by_layout ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return false;
+  }
+  CHECK_EQ(item_type, CacheItemType::GROUP_BY_LAYOUT_STATS);
+  auto layout_cache = getCachedItemContainer(item_type, device_identifier);
+  auto candidate_it = std::find_if(
+      layout_cache->begin(), layout_cache->end(), [&key](const auto& cached_item) {
+        return cached_item.key == key;
+      });
+  return candidate_it != layout_cache->end();
+}
+
+void GroupByLayoutRecycler::removeItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<EMPTY_META_INFO> meta_info) {
+  auto layout_cache = getCachedItemContainer(item_type, device_identifier);
+  auto filter = [key](auto const& item) { return item.key == key; };
+  auto itr = std::find_if(layout_cache->cbegin(), layout_cache->cend(), filter);
+  if (itr == layout_cache->cend()) {
+    return;
+  } else {
+    VLOG(1) << "[" << item_type << ", "
+            << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+            << "] remove cached item from cache (key: " << key << ")";
+    layout_cache->erase(itr);
+  }
+}
+
+void GroupByLayoutRecycler::cleanupCacheForInsertion(
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    size_t required_size,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<EMPTY_META_INFO> meta_info) {
+  CHECK_LE(required_size, GROUP_BY_LAYOUT_CACHE_MAX_NUM_ITEMS);
+  auto layout_cache = getCachedItemContainer(item_type, device_identifier);
+  const auto max_num_items = GROUP_BY_LAYOUT_CACHE_MAX_NUM_ITEMS - required_size;
+  if (layout_cache->size() <= max_num_items) {
+    return;
+  }
+  // items are appended on insertion, so the front of the container is the oldest
+  const auto num_evicted_items = layout_cache->size() - max_num_items;
+  auto evicted_end = layout_cache->begin() + num_evicted_items;
+  for (auto it = layout_cache->begin(); it != evicted_end; ++it) {
+    for (auto& kv : table_key_to_query_plan_dag_map_) {
+      kv.second.erase(it->key);
+    }
+  }
+  layout_cache->erase(layout_cache->begin(), evicted_end);
+  VLOG(1) << "[" << item_type << ", "
+          << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+          << "] Evict " << num_evicted_items << " group by layout stats from cache";
+}
+
+void GroupByLayoutRecycler::clearCache() {
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto layout_cache = getCachedItemContainer(CacheItemType::GROUP_BY_LAYOUT_STATS,
+                                             GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER);
+  VLOG(1) << "[" << CacheItemType::GROUP_BY_LAYOUT_STATS << ", "
+          << DataRecyclerUtil::getDeviceIdentifierString(
+                 GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER)
+          << "] clear cache (# items: " << layout_cache->size() << ")";
+  layout_cache->clear();
+  table_key_to_query_plan_dag_map_.clear();
+}
+
+void GroupByLayoutRecycler::markCachedItemAsDirty(
+    size_t table_key,
+    std::unordered_set<QueryPlanHash>& key_set,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier) {
+  if (!g_enable_data_recycler || !g_enable_adaptive_group_by_layout ||
+      key_set.empty()) {
+    return;
+  }
+  CHECK_EQ(item_type, CacheItemType::GROUP_BY_LAYOUT_STATS);
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto layout_cache = getCachedItemContainer(item_type, device_identifier);
+  for (auto key : key_set) {
+    markCachedItemAsDirtyImpl(key, *layout_cache);
+  }
+  removeTableKeyInfoFromQueryPlanDagMap(table_key);
+}
+
+std::string GroupByLayoutRecycler::toString() const {
+  std::ostringstream oss;
+  oss << "A current status of the Group By Layout Recycler:\n";
+  oss << "\t# cached layout stats:\n";
+  oss << "\t\tDevice" << GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER << "\n";
+  auto layout_cache = getCachedItemContainer(CacheItemType::GROUP_BY_LAYOUT_STATS,
+                                             GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER);
+  for (auto& cache_container : *layout_cache) {
+    oss << "\t\t\tCache_key: " << cache_container.key;
+    if (cache_container.cached_item.has_value()) {
+      oss << ", Layout: "
+          << (cache_container.cached_item->layout ==
+                      QueryDescriptionType::GroupByPerfectHash
+                  ? "perfect hash"
+                  : "baseline hash")
+          << ", Entry_count: " << cache_container.cached_item->entry_count
+          << ", Num_groups: " << cache_container.cached_item->num_groups << "\n";
+    } else {
+      oss << ", Layout info is not available\n";
+    }
+  }
+  return oss.str();
+}
+
+void GroupByLayoutRecycler::addQueryPlanDagForTableKeys(
+    size_t hashed_query_plan_dag,
+    const std::unordered_set<size_t>& table_keys) {
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  for (auto table_key : table_keys) {
+    auto itr = table_key_to_query_plan_dag_map_.try_emplace(table_key).first;
+    itr->second.insert(hashed_query_plan_dag);
+  }
+}
+
+std::optional<std::unordered_set<size_t>>
+GroupByLayoutRecycler::getMappedQueryPlanDagsWithTableKey(size_t table_key) const {
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto it = table_key_to_query_plan_dag_map_.find(table_key);
+  return it != table_key_to_query_plan_dag_map_.end() ? std::make_optional(it->second)
+                                                      : std::nullopt;
+}
+
+void GroupByLayoutRecycler::removeTableKeyInfoFromQueryPlanDagMap(size_t table_key) {
+  // this function is called when marking cached item for the given table_key as dirty
+  // and when we do that we already acquire the cache lock so we skip to lock in this func
+  table_key_to_query_plan_dag_map_.erase(table_key);
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "DataRecycler.h"
+#include "QueryEngine/Descriptors/Types.h"
+
+#include <numeric>
+
+extern bool g_enable_adaptive_group_by_layout;
+
+constexpr DeviceIdentifier GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER =
+    DataRecyclerUtil::CPU_DEVICE_IDENTIFIER;
+
+// the oldest layout stats are evicted once this many query steps have been recorded
+constexpr size_t GROUP_BY_LAYOUT_CACHE_MAX_NUM_ITEMS = 4096;
+
+// group by layout and buffer size observed at the end of the previous execution of a
+// query step
+struct GroupByLayoutMetaInfo {
+  QueryDescriptionType layout;
+  size_t entry_count;  // # entries of the (reduced) groups buffer
+  size_t num_groups;   // # non-empty entries of the (reduced) groups buffer
+
+  double getFillRatio() const {
+    return entry_count ? static_cast<double>(num_groups) / entry_count : 1.0;
+  }
+};
+
+class GroupByLayoutRecycler
+    : public DataRecycler<std::optional<GroupByLayoutMetaInfo>, EMPTY_META_INFO> {
+ public:
+  // group by layout recycler caches a few counters per query step instead of actual
+  // data so we limit the number of cached items rather than their size
+  GroupByLayoutRecycler()
+      : DataRecycler({CacheItemType::GROUP_BY_LAYOUT_STATS},
+                     std::numeric_limits<size_t>::max(),
+                     std::numeric_limits<size_t>::max(),
+                     0) {}
+
+  std::optional<GroupByLayoutMetaInfo> getItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::optional<EMPTY_META_INFO> meta_info = std::nullopt) override;
+
+  // unlike other recyclers, we overwrite an already cached item since the number of
+  // groups of a query step changes as its input tables change
+  // a baseline hash item never replaces the layout and entry count of a clean perfect
+  // hash item, since the perfect hash stats are what made us pick the baseline layout;
+  // replacing them would flip the layout back to perfect hash on the next execution
+  void putItemToCache(QueryPlanHash key,
+                      std::optional<GroupByLayoutMetaInfo> item,
+                      CacheItemType item_type,
+                      DeviceIdentifier device_identifier,
+                      size_t item_size,
+                      size_t compute_time,
+                      std::optional<EMPTY_META_INFO> meta_info = std::nullopt) override;
+
+  // nothing to do with group by layout recycler
+  void initCache() override {}
+
+  void clearCache() override;
+
+  void markCachedItemAsDirty(size_t table_key,
+                             std::unordered_set<QueryPlanHash>& key_set,
+                             CacheItemType item_type,
+                             DeviceIdentifier device_identifier) override;
+
+  std::string toString() const override;
+
+  void addQueryPlanDagForTableKeys(size_t hashed_query_plan_dag,
+                                   const std::unordered_set<size_t>& table_keys);
+
+  std::optional<std::unordered_set<size_t>> getMappedQueryPlanDagsWithTableKey(
+      size_t table_key) const;
+
+  void removeTableKeyInfoFromQueryPlanDagMap(size_t table_key);
+
+ private:
+  bool hasItemInCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<EMPTY_META_INFO> meta_info = std::nullopt) const override;
+
+  void removeItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<EMPTY_META_INFO> meta_info = std::nullopt) override;
+
+  // evict the oldest cached items to make room for `required_size` more items
+  void cleanupCacheForInsertion(
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      size_t required_size,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<EMPTY_META_INFO> meta_info = std::nullopt) override;
+
+  // a map btw. a table key and the query plan dags of the query steps reading it
+  std::unordered_map<size_t, std::unordered_set<size_t>> table_key_to_query_plan_dag_map_;
+};
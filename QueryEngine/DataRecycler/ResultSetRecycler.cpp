@@ -68,27 +68,66 @@ ResultSetPtr ResultSetRecycler::getItemFromCache(
           key, item_type, device_identifier, lock, candidate_resultset_it->meta_info);
       return nullptr;
     }
-    auto candidate_resultset = candidate_resultset_it->cached_item;
-    decltype(std::chrono::steady_clock::now()) ts1, ts2;
-    ts1 = std::chrono::steady_clock::now();
-    // we need to copy cached resultset to support resultset recycler with concurrency
-    auto copied_rs = candidate_resultset->copy();
-    CHECK(copied_rs);
-    copied_rs->setCached(true);
-    copied_rs->initStatus();
-    candidate_resultset_it->item_metric->incRefCount();
-    ts2 = std::chrono::steady_clock::now();
-    VLOG(1) << "[" << item_type << ", "
-            << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
-            << "] Get cached query resultset from cache (key: " << key
-            << ", copying it takes "
-            << std::chrono::duration_cast<std::chrono::milliseconds>(ts2 - ts1).count()
-            << "ms)";
-    return copied_rs;
+    return copyCachedItem(*candidate_resultset_it, item_type, device_identifier);
   }
   return nullptr;
 }
 
+std::optional<std::pair<ResultSetPtr, FragmentTupleCountMap>>
+ResultSetRecycler::getPartialItemFromCache(QueryPlanHash key) {
+  if (!g_enable_data_recycler || !g_use_query_resultset_cache ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return std::nullopt;
+  }
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto resultset_cache = getCachedItemContainer(CacheItemType::PARTIAL_QUERY_RESULTSET,
+                                                DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+  CHECK(resultset_cache);
+  auto candidate_resultset_it = std::find_if(
+      resultset_cache->begin(), resultset_cache->end(), [&key](const auto& cached_item) {
+        return cached_item.key == key;
+      });
+  if (candidate_resultset_it == resultset_cache->end()) {
+    return std::nullopt;
+  }
+  CHECK(candidate_resultset_it->meta_info);
+  if (candidate_resultset_it->isDirty()) {
+    removeItemFromCache(key,
+                        CacheItemType::PARTIAL_QUERY_RESULTSET,
+                        DataRecyclerUtil::CPU_DEVICE_IDENTIFIER,
+                        lock,
+                        candidate_resultset_it->meta_info);
+    return std::nullopt;
+  }
+  auto covered_fragments = candidate_resultset_it->meta_info->covered_fragments;
+  return std::make_pair(copyCachedItem(*candidate_resultset_it,
+                                       CacheItemType::PARTIAL_QUERY_RESULTSET,
+                                       DataRecyclerUtil::CPU_DEVICE_IDENTIFIER),
+                        std::move(covered_fragments));
+}
+
+ResultSetPtr ResultSetRecycler::copyCachedItem(
+    const CachedItem<ResultSetPtr, ResultSetMetaInfo>& cached_item,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier) {
+  decltype(std::chrono::steady_clock::now()) ts1, ts2;
+  ts1 = std::chrono::steady_clock::now();
+  // we need to copy cached resultset to support resultset recycler with concurrency
+  auto copied_rs = cached_item.cached_item->copy();
+  CHECK(copied_rs);
+  copied_rs->setCached(true);
+  copied_rs->initStatus();
+  cached_item.item_metric->incRefCount();
+  ts2 = std::chrono::steady_clock::now();
+  VLOG(1) << "[" << item_type << ", "
+          << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+          << "] Get cached query resultset from cache (key: " << cached_item.key
+          << ", copying it takes "
+          << std::chrono::duration_cast<std::chrono::milliseconds>(ts2 - ts1).count()
+          << "ms)";
+  return copied_rs;
+}
+
 std::optional<std::vector<TargetMetaInfo>> ResultSetRecycler::getOutputMetaInfo(
     QueryPlanHash key) {
   if (!g_enable_data_recycler || !g_use_query_resultset_cache ||
@@ -145,6 +184,9 @@ void ResultSetRecycler::putItemToCache(QueryPlanHash key,
     CHECK(candidate_resultset_it->meta_info);
     if (candidate_resultset_it->isDirty()) {
       need_to_cleanup = true;
+    } else if (item_type == CacheItemType::PARTIAL_QUERY_RESULTSET) {
+      // a new partial resultset covers more fragments than the cached one
+      need_to_cleanup = true;
     } else if (candidate_resultset_it->cached_item->didOutputColumnar() !=
                item_ptr->didOutputColumnar()) {
       // we already have a cached resultset for the given query plan dag but
@@ -300,6 +342,42 @@ void ResultSetRecycler::markCachedItemAsDirty(size_t table_key,
   removeTableKeyInfoFromQueryPlanDagMap(table_key);
 }
 
+void ResultSetRecycler::markCachedItemAsDirtyForAppend(
+    size_t table_key,
+    std::unordered_set<QueryPlanHash>& key_set) {
+  if (!g_enable_data_recycler || !g_use_query_resultset_cache || key_set.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  for (auto key : key_set) {
+    removeItemFromCache(key,
+                        CacheItemType::QUERY_RESULTSET,
+                        DataRecyclerUtil::CPU_DEVICE_IDENTIFIER,
+                        lock,
+                        std::nullopt);
+  }
+  // keep the table key info only for the remaining partial resultsets
+  auto partial_resultset_cache = getCachedItemContainer(
+      CacheItemType::PARTIAL_QUERY_RESULTSET, DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+  auto it = table_key_to_query_plan_dag_map_.find(table_key);
+  if (it == table_key_to_query_plan_dag_map_.end()) {
+    return;
+  }
+  for (auto key_it = it->second.begin(); key_it != it->second.end();) {
+    const auto key = *key_it;
+    if (std::none_of(partial_resultset_cache->begin(),
+                     partial_resultset_cache->end(),
+                     [key](const auto& cached_item) { return cached_item.key == key; })) {
+      key_it = it->second.erase(key_it);
+    } else {
+      ++key_it;
+    }
+  }
+  if (it->second.empty()) {
+    removeTableKeyInfoFromQueryPlanDagMap(table_key);
+  }
+}
+
 std::string ResultSetRecycler::toString() const {
   std::ostringstream oss;
   oss << "A current status of the query resultSet Recycler:\n";
@@ -20,6 +20,9 @@
 #include "QueryEngine/QueryHint.h"
 #include "QueryEngine/RelAlgExecutionUnit.h"
 
+// fragment id -> # tuples of the fragment when its rows were aggregated
+using FragmentTupleCountMap = std::map<int, size_t>;
+
 struct ResultSetMetaInfo {
   ResultSetMetaInfo(const std::unordered_set<size_t> input_table_infos) {
     input_table_keys.insert(input_table_infos.begin(), input_table_infos.end());
@@ -35,12 +38,15 @@ struct ResultSetMetaInfo {
 
   std::unordered_set<size_t> input_table_keys;
   std::vector<std::shared_ptr<Analyzer::Expr>> target_exprs;
+  // fragments of the input table whose rows a partial query resultset aggregates
+  FragmentTupleCountMap covered_fragments;
 };
 
 class ResultSetRecycler : public DataRecycler<ResultSetPtr, ResultSetMetaInfo> {
  public:
   ResultSetRecycler()
-      : DataRecycler({CacheItemType::QUERY_RESULTSET},
+      : DataRecycler({CacheItemType::QUERY_RESULTSET,
+                      CacheItemType::PARTIAL_QUERY_RESULTSET},
                      g_query_resultset_cache_total_bytes,
                      g_max_cacheable_query_resultset_size_bytes,
                      0) {}
@@ -53,6 +59,11 @@ class ResultSetRecycler : public DataRecycler<ResultSetPtr, ResultSetMetaInfo> {
 
   std::optional<std::vector<TargetMetaInfo>> getOutputMetaInfo(QueryPlanHash key);
 
+  // returns a copy of the partial query resultset cached for the given query plan dag
+  // along with the fragments it covers
+  std::optional<std::pair<ResultSetPtr, FragmentTupleCountMap>> getPartialItemFromCache(
+      QueryPlanHash key);
+
   void putItemToCache(QueryPlanHash key,
                       ResultSetPtr item_ptr,
                       CacheItemType item_type,
@@ -71,6 +82,11 @@ class ResultSetRecycler : public DataRecycler<ResultSetPtr, ResultSetMetaInfo> {
                              CacheItemType item_type,
                              DeviceIdentifier device_identifier) override;
 
+  // rows appended to a table never land in a fragment covered by a partial query
+  // resultset, so we only remove complete query resultsets computed from the table
+  void markCachedItemAsDirtyForAppend(size_t table_key,
+                                      std::unordered_set<QueryPlanHash>& key_set);
+
   std::string toString() const override;
 
   std::tuple<QueryPlanHash, ResultSetPtr, std::optional<ResultSetMetaInfo>>
@@ -109,6 +125,11 @@ class ResultSetRecycler : public DataRecycler<ResultSetPtr, ResultSetMetaInfo> {
       std::lock_guard<std::mutex>& lock,
       std::optional<ResultSetMetaInfo> meta_info = std::nullopt) override;
 
+  ResultSetPtr copyCachedItem(
+      const CachedItem<ResultSetPtr, ResultSetMetaInfo>& cached_item,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier);
+
   void cleanupCacheForInsertion(
       CacheItemType item_type,
       DeviceIdentifier device_identifier,
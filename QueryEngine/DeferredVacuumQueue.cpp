@@ -0,0 +1,150 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/DeferredVacuumQueue.h"
+
+#include <algorithm>
+
+#include "Catalog/SysCatalog.h"
+#include "LockMgr/LegacyLockMgr.h"
+#include "LockMgr/LockMgr.h"
+#include "Logger/Logger.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/TableOptimizer.h"
+#include "Shared/misc.h"
+
+bool g_enable_deferred_vacuum{false};
+// Merge the under-filled fragments of a table after vacuuming it in the background
+bool g_enable_auto_fragment_merge{false};
+
+DeferredVacuumQueue& DeferredVacuumQueue::instance() {
+  static DeferredVacuumQueue queue;
+  return queue;
+}
+
+DeferredVacuumQueue::~DeferredVacuumQueue() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_ = true;
+    // deleted rows are still filtered on the deleted column, pending jobs can be dropped
+    // and the fragments vacuumed by a later delete or OPTIMIZE command
+    jobs_.clear();
+  }
+  jobs_cv_.notify_all();
+  if (worker_thread_.joinable()) {
+    worker_thread_.join();
+  }
+}
+
+void DeferredVacuumQueue::enqueue(const int db_id,
+                                  const int logical_table_id,
+                                  const int physical_table_id,
+                                  const std::set<int>& fragment_ids) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (stop_) {
+      return;
+    }
+    auto it = std::find_if(jobs_.begin(), jobs_.end(), [&](const Job& job) {
+      return job.db_id == db_id && job.physical_table_id == physical_table_id;
+    });
+    if (it != jobs_.end()) {
+      it->fragment_ids.insert(fragment_ids.begin(), fragment_ids.end());
+      return;
+    }
+    jobs_.push_back({db_id, logical_table_id, physical_table_id, fragment_ids});
+    if (!worker_thread_.joinable()) {
+      worker_thread_ = std::thread([this] { worker(); });
+    }
+  }
+  jobs_cv_.notify_one();
+}
+
+void DeferredVacuumQueue::waitForPendingJobs() {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  idle_cv_.wait(lock, [this] { return jobs_.empty() && !job_running_; });
+}
+
+size_t DeferredVacuumQueue::getCompletedJobCount() const {
+  std::lock_guard<std::mutex> lock(queue_mutex_);
+  return completed_job_count_;
+}
+
+void DeferredVacuumQueue::worker() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      jobs_cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+      if (stop_) {
+        idle_cv_.notify_all();
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+      job_running_ = true;
+    }
+    try {
+      vacuum(job);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Deferred vacuum of table " << job.physical_table_id
+                   << " failed: " << e.what();
+    }
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      job_running_ = false;
+      completed_job_count_++;
+    }
+    idle_cv_.notify_all();
+  }
+}
+
+void DeferredVacuumQueue::vacuum(const Job& job) {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto catalog = Catalog_Namespace::SysCatalog::instance().getCatalog(job.db_id);
+  if (!catalog) {
+    // the database was dropped
+    return;
+  }
+  const auto execute_read_lock = mapd_shared_lock<mapd_shared_mutex>(
+      *legacylockmgr::LockMgr<mapd_shared_mutex, bool>::getMutex(
+          legacylockmgr::ExecutorOuterLock, true));
+  if (!catalog->getMetadataForTable(job.logical_table_id, false)) {
+    // the table was dropped
+    return;
+  }
+  const auto td_with_lock =
+      lockmgr::TableSchemaLockContainer<lockmgr::ReadLock>::acquireTableDescriptor(
+          *catalog, job.logical_table_id);
+  const auto td = td_with_lock();
+  CHECK(td);
+  // Inserts do not take the table data lock and checkpoint the table themselves, so
+  // they must not append to the fragments being compacted or merged, nor persist or
+  // roll back a half done job. Block them for the whole job, the fragment merge
+  // included, as OPTIMIZE does with its schema write lock.
+  const auto insert_data_lock =
+      lockmgr::InsertDataLockMgr::getWriteLockForTable(*catalog, td->tableName);
+  const auto physical_td = catalog->getMetadataForTable(job.physical_table_id);
+  CHECK(physical_td);
+  auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID).get();
+  const TableOptimizer optimizer(td, executor, *catalog);
+  optimizer.vacuumFragmentsIncrementally(physical_td, job.fragment_ids);
+  VLOG(1) << "Deferred vacuum of fragments: " << shared::printContainer(job.fragment_ids)
+          << ", table id: " << job.physical_table_id;
+  if (g_enable_auto_fragment_merge) {
+    optimizer.mergeUnderfilledFragments();
+  }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    DeferredVacuumQueue.h
+ * @brief   Background thread vacuuming the fragments DELETE queries left deleted rows in.
+ *
+ * Automatic vacuuming compacts every column of a fragment, which DELETE otherwise does
+ * while holding the table data write lock. With deferred vacuuming, DELETE only marks
+ * the rows in the deleted column and the fragments are compacted later by this queue,
+ * one fragment per lock acquisition. Queries keep filtering deleted rows on the deleted
+ * column in the meantime.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+
+extern bool g_enable_deferred_vacuum;
+extern bool g_enable_auto_fragment_merge;
+
+class DeferredVacuumQueue {
+ public:
+  static DeferredVacuumQueue& instance();
+
+  ~DeferredVacuumQueue();
+
+  // Schedules vacuuming the given fragments of a physical table. The fragments are
+  // merged into the pending job of the table, if there is one.
+  void enqueue(const int db_id,
+               const int logical_table_id,
+               const int physical_table_id,
+               const std::set<int>& fragment_ids);
+
+  // Blocks until all the jobs scheduled so far have completed.
+  void waitForPendingJobs();
+
+  size_t getCompletedJobCount() const;
+
+ private:
+  struct Job {
+    int db_id;
+    int logical_table_id;
+    int physical_table_id;
+    std::set<int> fragment_ids;
+  };
+
+  DeferredVacuumQueue() {}
+
+  void worker();
+
+  static void vacuum(const Job& job);
+
+  std::deque<Job> jobs_;
+  bool job_running_{false};
+  size_t completed_job_count_{0};
+  bool stop_{false};
+  std::thread worker_thread_;
+  mutable std::mutex queue_mutex_;
+  std::condition_variable jobs_cv_;
+  std::condition_variable idle_cv_;
+};
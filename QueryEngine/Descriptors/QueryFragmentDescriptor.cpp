@@ -154,7 +154,14 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     const auto& fragment = (*fragments)[i];
     const auto skip_frag = executor->skipFragment(
         table_desc, fragment, ra_exe_unit.simple_quals, frag_offsets, i);
-    if (skip_frag.first) {
+    const bool skip =
+        skip_frag.first ||
+        (skip_frag.second == -1 &&
+         executor->skipForeignTableFragment(table_desc, ra_exe_unit, fragment));
+    if (auto execution_stats = executor->getExecutionStats()) {
+      execution_stats->addFragments(skip ? 0 : 1, skip ? 1 : 0);
+    }
+    if (skip) {
       continue;
     }
     rowid_lookup_key_ = std::max(rowid_lookup_key_, skip_frag.second);
@@ -387,7 +394,13 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
       skip_frag = executor->skipFragmentInnerJoins(
           outer_table_desc, ra_exe_unit, fragment, frag_offsets, outer_frag_id);
     }
-    if (skip_frag.first) {
+    const bool skip = skip_frag.first || (skip_frag.second == -1 &&
+                                          executor->skipForeignTableFragment(
+                                              outer_table_desc, ra_exe_unit, fragment));
+    if (auto execution_stats = executor->getExecutionStats()) {
+      execution_stats->addFragments(skip ? 0 : 1, skip ? 1 : 0);
+    }
+    if (skip) {
       continue;
     }
     const int device_id =
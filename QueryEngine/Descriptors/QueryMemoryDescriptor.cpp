@@ -26,6 +26,7 @@
 #include <boost/algorithm/cxx11/any_of.hpp>
 
 bool g_enable_smem_group_by{true};
+bool g_enable_hot_group_cache{false};
 extern bool g_enable_columnar_output;
 extern size_t g_streaming_topn_max;
 
@@ -1132,6 +1133,12 @@ bool QueryMemoryDescriptor::interleavedBins(const ExecutorDeviceType device_type
   return interleaved_bins_on_gpu_ && device_type == ExecutorDeviceType::GPU;
 }
 
+bool QueryMemoryDescriptor::hasHotGroupCache(const ExecutorDeviceType device_type) const {
+  return g_enable_hot_group_cache && device_type == ExecutorDeviceType::CPU &&
+         query_desc_type_ == QueryDescriptionType::GroupByBaselineHash &&
+         !output_columnar_ && !use_streaming_top_n_ && !render_output_;
+}
+
 // TODO(Saman): an implementation detail, so move this out of QMD
 bool QueryMemoryDescriptor::isWarpSyncRequired(
     const ExecutorDeviceType device_type) const {
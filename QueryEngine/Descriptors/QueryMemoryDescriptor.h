@@ -303,6 +303,10 @@ class QueryMemoryDescriptor {
 
   bool interleavedBins(const ExecutorDeviceType) const;
 
+  // CPU baseline hash groups buffers end with a cache of the entries of their most
+  // frequent keys, see get_group_value_with_hot_cache
+  bool hasHotGroupCache(const ExecutorDeviceType) const;
+
   size_t getColOffInBytes(const size_t col_idx) const;
   size_t getColOffInBytesInNextBin(const size_t col_idx) const;
   size_t getNextColOffInBytes(const int8_t* col_ptr,
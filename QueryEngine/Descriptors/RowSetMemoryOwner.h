@@ -30,6 +30,7 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/CountDistinct.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
+#include "QueryEngine/StringTranslationMapCache.h"
 #include "Shared/quantile.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 #include "StringOps/StringOps.h"
@@ -165,8 +166,15 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     if (it == str_proxy_intersection_translation_maps_owned_.end()) {
       it = str_proxy_intersection_translation_maps_owned_
                .emplace(map_key,
-                        source_proxy->buildIntersectionTranslationMapToOtherProxy(
-                            dest_proxy, string_op_infos))
+                        StringTranslationMapCache::instance().getOrBuildIntersection(
+                            source_proxy,
+                            dest_proxy,
+                            string_op_infos,
+                            [source_proxy, dest_proxy, &string_op_infos] {
+                              return source_proxy
+                                  ->buildIntersectionTranslationMapToOtherProxy(
+                                      dest_proxy, string_op_infos);
+                            }))
                .first;
     }
     return &it->second;
@@ -185,8 +193,14 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     if (it == str_proxy_union_translation_maps_owned_.end()) {
       it = str_proxy_union_translation_maps_owned_
                .emplace(map_key,
-                        source_proxy->buildUnionTranslationMapToOtherProxy(
-                            dest_proxy, string_op_infos))
+                        StringTranslationMapCache::instance().getOrBuildUnion(
+                            source_proxy,
+                            dest_proxy,
+                            string_op_infos,
+                            [source_proxy, dest_proxy, &string_op_infos] {
+                              return source_proxy->buildUnionTranslationMapToOtherProxy(
+                                  dest_proxy, string_op_infos);
+                            }))
                .first;
     }
     return &it->second;
@@ -36,6 +36,7 @@
 #include "Catalog/Catalog.h"
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
+#include "DataMgr/ForeignStorage/ForeignStorageMgr.h"
 #include "DataMgr/ForeignStorage/FsiChunkUtils.h"
 #include "DataMgr/ForeignStorage/MetadataPlaceholder.h"
 #include "OSDependent/omnisci_path.h"
@@ -64,6 +65,7 @@
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryEngine/SpeculativeTopN.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
+#include "QueryEngine/StringTranslationMapCache.h"
 #include "QueryEngine/TableFunctions/TableFunctionCompilationContext.h"
 #include "QueryEngine/TableFunctions/TableFunctionExecutionContext.h"
 #include "QueryEngine/Visitors/TransientStringLiteralsVisitor.h"
@@ -76,6 +78,11 @@
 #include "Shared/shard_key.h"
 #include "Shared/threading.h"
 
+#if ENABLE_TBB && !DISABLE_CONCURRENCY && TBB_INTERFACE_VERSION >= 12000
+#include <tbb/info.h>
+#define HAVE_TBB_NUMA_ARENAS
+#endif
+
 bool g_enable_watchdog{false};
 bool g_enable_dynamic_watchdog{false};
 size_t g_watchdog_none_encoded_string_translation_limit{1000000UL};
@@ -89,7 +96,9 @@ bool g_null_div_by_zero{false};
 unsigned g_trivial_loop_join_threshold{1000};
 bool g_from_table_reordering{true};
 bool g_inner_join_fragment_skipping{true};
+bool g_enable_foreign_table_filter_pushdown{false};
 extern bool g_enable_smem_group_by;
+extern bool g_enable_numa_aware_cpu_buffer_pool;
 extern std::unique_ptr<llvm::Module> udf_gpu_module;
 extern std::unique_ptr<llvm::Module> udf_cpu_module;
 bool g_enable_filter_push_down{false};
@@ -122,6 +131,8 @@ double g_bump_allocator_step_reduction{0.75};
 bool g_enable_direct_columnarization{true};
 extern bool g_enable_string_functions;
 bool g_enable_lazy_fetch{true};
+bool g_enable_late_materialization{false};
+bool g_enable_query_step_fusion{false};
 bool g_enable_runtime_query_interrupt{true};
 bool g_enable_non_kernel_time_query_interrupt{true};
 bool g_use_estimator_result_cache{true};
@@ -148,6 +159,7 @@ bool g_use_hashtable_cache{true};
 bool g_use_query_resultset_cache{true};
 bool g_use_chunk_metadata_cache{true};
 bool g_allow_auto_resultset_caching{false};
+bool g_enable_incremental_resultset_cache{false};
 bool g_allow_query_step_skipping{true};
 size_t g_hashtable_cache_total_bytes{size_t(1) << 32};
 size_t g_max_cacheable_hashtable_size_bytes{size_t(1) << 31};
@@ -197,6 +209,9 @@ CodeCacheAccessor<GpuCompilationContext> Executor::gpu_code_accessor(
 CodeCacheAccessor<CompilationContext> Executor::tf_code_accessor(
     Executor::code_cache_size,
     "tf_code_cache");
+PersistentCodeCache Executor::cpu_persistent_code_cache("cpu_persistent_code_cache");
+// declared last so that the background compilation stops before the caches go away
+TieredCompilationQueue Executor::tiered_compilation_queue;
 
 namespace {
 // This function is notably different from that in RelAlgExecutor because it already
@@ -517,6 +532,7 @@ void Executor::clearMemory(const Data_Namespace::MemoryLevel memory_level) {
         // For now, assume the user wants to purge the hash table cache when they clear
         // CPU memory (currently used in ExecuteTest to lower memory pressure)
         JoinHashTableCacheInvalidator::invalidateCaches();
+        StringTranslationMapCache::instance().clear();
       }
       ResultSetCacheInvalidator::invalidateCaches();
       Catalog_Namespace::SysCatalog::instance().getDataMgr().clearMemory(memory_level);
@@ -1290,7 +1306,8 @@ ResultSetPtr Executor::resultsUnion(SharedKernelContext& shared_context,
                                        gridSize());
   }
   using IndexedResultSet = std::pair<ResultSetPtr, std::vector<size_t>>;
-  std::sort(results_per_device.begin(),
+  // stable, since the CPU sub-tasks of a fragment add their results in row order
+  std::stable_sort(results_per_device.begin(),
             results_per_device.end(),
             [](const IndexedResultSet& lhs, const IndexedResultSet& rhs) {
               CHECK_GE(lhs.second.size(), size_t(1));
@@ -1850,6 +1867,7 @@ ResultSetPtr Executor::executeWorkUnitImpl(
     if (eo.executor_type == ExecutorType::Native) {
       try {
         INJECT_TIMER(query_step_compilation);
+        auto clock_begin = timer_start();
         query_mem_desc_owned =
             query_comp_desc_owned->compile(max_groups_buffer_entry_guess,
                                            crt_min_byte_width,
@@ -1870,6 +1888,9 @@ ResultSetPtr Executor::executeWorkUnitImpl(
                                            render_info,
                                            this);
         CHECK(query_mem_desc_owned);
+        if (execution_stats_) {
+          execution_stats_->addCompilation(timer_stop(clock_begin));
+        }
         crt_min_byte_width = query_comp_desc_owned->getMinByteWidth();
       } catch (CompilationRetryNoCompaction&) {
         crt_min_byte_width = MAX_BYTE_WIDTH_SUPPORTED;
@@ -1949,11 +1970,16 @@ ResultSetPtr Executor::executeWorkUnitImpl(
         }
       }
       try {
-        return collectAllDeviceResults(shared_context,
-                                       ra_exe_unit,
-                                       *query_mem_desc_owned,
-                                       query_comp_desc_owned->getDeviceType(),
-                                       row_set_mem_owner);
+        auto clock_begin = timer_start();
+        auto results = collectAllDeviceResults(shared_context,
+                                               ra_exe_unit,
+                                               *query_mem_desc_owned,
+                                               query_comp_desc_owned->getDeviceType(),
+                                               row_set_mem_owner);
+        if (execution_stats_) {
+          execution_stats_->addReduction(timer_stop(clock_begin));
+        }
+        return results;
       } catch (ReductionRanOutOfSlots&) {
         throw QueryExecutionError(ERR_OUT_OF_SLOTS);
       } catch (OverflowOrUnderflow&) {
@@ -2649,6 +2675,74 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
   return execution_kernels;
 }
 
+#ifdef HAVE_TBB_NUMA_ARENAS
+namespace {
+
+// Arenas whose threads are constrained to the CPUs of one NUMA node each, by node. Empty
+// on single node hosts, or if TBB cannot bind its threads, i.e. without tbbbind.
+const std::map<int32_t, std::unique_ptr<tbb::task_arena>>& get_numa_node_arenas() {
+  static const auto numa_node_arenas = [] {
+    std::map<int32_t, std::unique_ptr<tbb::task_arena>> numa_node_arenas;
+    const auto numa_nodes = tbb::info::numa_nodes();
+    if (numa_nodes.size() > 1) {
+      for (const auto numa_node : numa_nodes) {
+        numa_node_arenas.emplace(
+            numa_node,
+            std::make_unique<tbb::task_arena>(tbb::task_arena::constraints(numa_node)));
+      }
+    }
+    return numa_node_arenas;
+  }();
+  return numa_node_arenas;
+}
+
+// Returns the NUMA node holding the first outer fragment of each kernel in the CPU
+// buffer pool, or -1 if the fragment is not there or its node is unknown.
+std::vector<int32_t> get_kernel_numa_nodes(
+    const std::vector<std::unique_ptr<ExecutionKernel>>& kernels,
+    const std::vector<InputTableInfo>& query_infos,
+    Data_Namespace::DataMgr& data_mgr,
+    const int db_id) {
+  std::vector<int32_t> kernel_numa_nodes(kernels.size(), -1);
+  std::map<int, std::map<int, int32_t>> fragment_numa_nodes_per_table;
+  for (size_t kernel_idx = 0; kernel_idx < kernels.size(); ++kernel_idx) {
+    const auto& frag_list = kernels[kernel_idx]->frag_list;
+    if (frag_list.empty() || frag_list.front().table_id <= 0 ||
+        frag_list.front().fragment_ids.empty()) {
+      continue;
+    }
+    const auto& outer_fragments = frag_list.front();
+    const auto query_info_it =
+        std::find_if(query_infos.begin(),
+                     query_infos.end(),
+                     [&outer_fragments](const InputTableInfo& query_info) {
+                       return query_info.table_id == outer_fragments.table_id;
+                     });
+    if (query_info_it == query_infos.end() ||
+        outer_fragments.fragment_ids.front() >= query_info_it->info.fragments.size()) {
+      continue;
+    }
+    const auto& fragment =
+        query_info_it->info.fragments[outer_fragments.fragment_ids.front()];
+    auto table_it = fragment_numa_nodes_per_table.find(fragment.physicalTableId);
+    if (table_it == fragment_numa_nodes_per_table.end()) {
+      table_it = fragment_numa_nodes_per_table
+                     .emplace(fragment.physicalTableId,
+                              data_mgr.getCpuFragmentNumaNodes(
+                                  {db_id, fragment.physicalTableId}))
+                     .first;
+    }
+    const auto numa_node_it = table_it->second.find(fragment.fragmentId);
+    if (numa_node_it != table_it->second.end()) {
+      kernel_numa_nodes[kernel_idx] = numa_node_it->second;
+    }
+  }
+  return kernel_numa_nodes;
+}
+
+}  // namespace
+#endif  // HAVE_TBB_NUMA_ARENAS
+
 void Executor::launchKernels(SharedKernelContext& shared_context,
                              std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
                              const ExecutorDeviceType device_type) {
@@ -2670,19 +2764,54 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
 
   VLOG(1) << "Launching " << kernels.size() << " kernels for query on "
           << (device_type == ExecutorDeviceType::CPU ? "CPU"s : "GPU"s) << ".";
+#ifdef HAVE_TBB_NUMA_ARENAS
+  // the kernel of a fragment placed on a NUMA node runs on the threads of that node, so
+  // that it reads the chunks of the fragment from local memory
+  const auto& numa_node_arenas = get_numa_node_arenas();
+  std::vector<int32_t> kernel_numa_nodes;
+  if (g_enable_numa_aware_cpu_buffer_pool && device_type == ExecutorDeviceType::CPU &&
+      !numa_node_arenas.empty()) {
+    kernel_numa_nodes = get_kernel_numa_nodes(kernels,
+                                              shared_context.getQueryInfos(),
+                                              *getDataMgr(),
+                                              getCatalog()->getDatabaseId());
+  }
+  std::map<int32_t, threading::task_group> numa_node_task_groups;
+#endif  // HAVE_TBB_NUMA_ARENAS
   size_t kernel_idx = 1;
   for (auto& kernel : kernels) {
     CHECK(kernel.get());
-    tg.run([this,
-            &kernel,
-            &shared_context,
-            parent_thread_id = logger::thread_id(),
-            crt_kernel_idx = kernel_idx++] {
+#ifdef HAVE_TBB_NUMA_ARENAS
+    const auto numa_node =
+        kernel_numa_nodes.empty() ? -1 : kernel_numa_nodes[kernel_idx - 1];
+#endif  // HAVE_TBB_NUMA_ARENAS
+    auto run_kernel = [this,
+                       &kernel,
+                       &shared_context,
+                       parent_thread_id = logger::thread_id(),
+                       crt_kernel_idx = kernel_idx++] {
       DEBUG_TIMER_NEW_THREAD(parent_thread_id);
       const size_t thread_i = crt_kernel_idx % cpu_threads();
       kernel->run(this, thread_i, shared_context);
-    });
+    };
+#ifdef HAVE_TBB_NUMA_ARENAS
+    if (const auto arena_it = numa_node_arenas.find(numa_node);
+        arena_it != numa_node_arenas.end()) {
+      auto& numa_node_task_group = numa_node_task_groups[numa_node];
+      arena_it->second->execute(
+          [&numa_node_task_group, &run_kernel] { numa_node_task_group.run(run_kernel); });
+      continue;
+    }
+#endif  // HAVE_TBB_NUMA_ARENAS
+    tg.run(run_kernel);
+  }
+#ifdef HAVE_TBB_NUMA_ARENAS
+  // kernels may add sub tasks to the default task group, so wait for them first
+  for (auto& [numa_node, numa_node_task_group] : numa_node_task_groups) {
+    numa_node_arenas.at(numa_node)->execute(
+        [&numa_node_task_group = numa_node_task_group] { numa_node_task_group.wait(); });
   }
+#endif  // HAVE_TBB_NUMA_ARENAS
   tg.wait();
 
   for (auto& exec_ctx : shared_context.getTlsExecutionContext()) {
@@ -2954,6 +3083,7 @@ FetchResult Executor::fetchChunks(
   std::vector<std::vector<const int8_t*>> all_frag_col_buffers;
   std::vector<std::vector<int64_t>> all_num_rows;
   std::vector<std::vector<uint64_t>> all_frag_offsets;
+  std::vector<FetchResult::DeferredColumn> deferred_columns;
   for (const auto& selected_frag_ids : frag_ids_crossjoin) {
     std::vector<const int8_t*> frag_col_buffers(
         plan_state_->global_to_local_col_ids_.size());
@@ -2995,6 +3125,11 @@ FetchResult Executor::fetchChunks(
       auto memory_level_for_column = memory_level;
       auto tbl_col_ids =
           std::make_pair(col_id->getScanDesc().getTableId(), col_id->getColId());
+      const bool is_lazy_fetch_only =
+          plan_state_->columns_to_fetch_.find(tbl_col_ids) ==
+              plan_state_->columns_to_fetch_.end() &&
+          plan_state_->columns_to_not_fetch_.find(tbl_col_ids) !=
+              plan_state_->columns_to_not_fetch_.end();
       if (plan_state_->columns_to_fetch_.find(tbl_col_ids) ==
           plan_state_->columns_to_fetch_.end()) {
         memory_level_for_column = Data_Namespace::CPU_LEVEL;
@@ -3041,6 +3176,15 @@ FetchResult Executor::fetchChunks(
                                                           device_allocator,
                                                           thread_idx);
           }
+        } else if (g_enable_late_materialization &&
+                   memory_level == Data_Namespace::CPU_LEVEL && is_lazy_fetch_only) {
+          // The kernel only emits row positions for this column, so its chunk is
+          // loaded by fetchDeferredChunks() once we know the fragment has output rows.
+          deferred_columns.push_back({all_frag_col_buffers.size(),
+                                      it->second,
+                                      table_id,
+                                      static_cast<int>(frag_id),
+                                      col_id->getColId()});
         } else {
           frag_col_buffers[it->second] =
               column_fetcher.getOneTableColumnFragment(table_id,
@@ -3059,7 +3203,40 @@ FetchResult Executor::fetchChunks(
   }
   std::tie(all_num_rows, all_frag_offsets) = getRowCountAndOffsetForAllFrags(
       ra_exe_unit, frag_ids_crossjoin, ra_exe_unit.input_descs, all_tables_fragments);
-  return {all_frag_col_buffers, all_num_rows, all_frag_offsets};
+  return {all_frag_col_buffers, all_num_rows, all_frag_offsets, deferred_columns};
+}
+
+void Executor::fetchDeferredChunks(
+    const ColumnFetcher& column_fetcher,
+    FetchResult& fetch_result,
+    ResultSet* results,
+    const std::map<int, const TableFragments*>& all_tables_fragments,
+    std::list<ChunkIter>& chunk_iterators,
+    std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
+    const int device_id,
+    DeviceAllocator* device_allocator) {
+  auto timer = DEBUG_TIMER(__func__);
+  for (const auto& deferred_column : fetch_result.deferred_columns) {
+    CHECK_LT(deferred_column.frag_idx, fetch_result.col_buffers.size());
+    auto& frag_col_buffers = fetch_result.col_buffers[deferred_column.frag_idx];
+    CHECK_LT(static_cast<size_t>(deferred_column.local_col_id), frag_col_buffers.size());
+    const auto col_buffer =
+        column_fetcher.getOneTableColumnFragment(deferred_column.table_id,
+                                                 deferred_column.frag_id,
+                                                 deferred_column.col_id,
+                                                 all_tables_fragments,
+                                                 chunks,
+                                                 chunk_iterators,
+                                                 Data_Namespace::CPU_LEVEL,
+                                                 device_id,
+                                                 device_allocator);
+    frag_col_buffers[deferred_column.local_col_id] = col_buffer;
+    if (results) {
+      results->setLazyFetchColumnBuffer(
+          deferred_column.frag_idx, deferred_column.local_col_id, col_buffer);
+    }
+  }
+  fetch_result.deferred_columns.clear();
 }
 
 // fetchChunks() is written under the assumption that multiple inputs implies a JOIN.
@@ -3820,6 +3997,7 @@ Executor::JoinHashTableOrError Executor::buildHashTableForQualifier(
     throw QueryExecutionError(ERR_INTERRUPTED);
   }
   try {
+    auto clock_begin = timer_start();
     auto tbl = HashJoin::getInstance(qual_bin_oper,
                                      query_infos,
                                      memory_level,
@@ -3831,6 +4009,17 @@ Executor::JoinHashTableOrError Executor::buildHashTableForQualifier(
                                      hashtable_build_dag_map,
                                      query_hint,
                                      table_id_to_node_map);
+    if (execution_stats_ && tbl) {
+      const auto device_type = memory_level == Data_Namespace::GPU_LEVEL
+                                   ? ExecutorDeviceType::GPU
+                                   : ExecutorDeviceType::CPU;
+      size_t hash_table_bytes{0};
+      for (int device_id = 0; device_id < deviceCountForMemoryLevel(memory_level);
+           ++device_id) {
+        hash_table_bytes += tbl->getJoinHashBufferSize(device_type, device_id);
+      }
+      execution_stats_->addHashTable(timer_stop(clock_begin), hash_table_bytes);
+    }
     return {tbl, ""};
   } catch (const HashJoinFail& e) {
     return {nullptr, e.what()};
@@ -4353,6 +4542,102 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
   return skip_frag;
 }
 
+namespace {
+
+// Translates a qualifier of the form `column <op> literal` on the given table into a
+// filter that data wrappers can evaluate against statistics of the source files.
+std::optional<foreign_storage::ColumnFilter> get_foreign_table_column_filter(
+    const Analyzer::Expr* qual,
+    const InputDescriptor& table_desc) {
+  const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual);
+  if (!bin_oper || bin_oper->get_qualifier() != kONE) {
+    return std::nullopt;
+  }
+  const auto optype = bin_oper->get_optype();
+  if (optype != kEQ && optype != kLT && optype != kLE && optype != kGT &&
+      optype != kGE) {
+    return std::nullopt;
+  }
+  const auto col_var =
+      dynamic_cast<const Analyzer::ColumnVar*>(bin_oper->get_left_operand());
+  if (!col_var || dynamic_cast<const Analyzer::Var*>(col_var) ||
+      col_var->get_table_id() != table_desc.getTableId() ||
+      col_var->get_rte_idx() != table_desc.getNestLevel()) {
+    return std::nullopt;
+  }
+  const auto& col_ti = col_var->get_type_info();
+  auto rhs = bin_oper->get_right_operand();
+  if (col_ti.is_string()) {
+    // String literals compared to dictionary encoded columns are cast to the dictionary
+    const auto cast_expr = dynamic_cast<const Analyzer::UOper*>(rhs);
+    if (cast_expr && cast_expr->get_optype() == kCAST) {
+      rhs = cast_expr->get_operand();
+    }
+  }
+  const auto rhs_const = dynamic_cast<const Analyzer::Constant*>(rhs);
+  if (!rhs_const || rhs_const->get_is_null()) {
+    return std::nullopt;
+  }
+  const auto& literal_ti = rhs_const->get_type_info();
+  const auto literal = rhs_const->get_constval();
+  const int column_id = col_var->get_column_id();
+  if (col_ti.is_integer() && literal_ti.is_integer()) {
+    return foreign_storage::ColumnFilter{
+        column_id, optype, extract_int_type_from_datum(literal, literal_ti)};
+  }
+  if (col_ti.is_fp() && literal_ti.is_fp()) {
+    return foreign_storage::ColumnFilter{
+        column_id, optype, extract_fp_type_from_datum(literal, literal_ti)};
+  }
+  if (col_ti.is_string() && literal_ti.is_string() && optype == kEQ &&
+      literal.stringval) {
+    return foreign_storage::ColumnFilter{column_id, optype, *literal.stringval};
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+bool Executor::skipForeignTableFragment(
+    const InputDescriptor& table_desc,
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const Fragmenter_Namespace::FragmentInfo& fragment) {
+  if (!g_enable_foreign_table_filter_pushdown ||
+      table_desc.getSourceType() != InputSourceType::TABLE) {
+    return false;
+  }
+  CHECK(catalog_);
+  const auto td = catalog_->getMetadataForTable(table_desc.getTableId(), false);
+  if (!td || td->storageType != StorageType::FOREIGN_TABLE || td->is_system_table) {
+    return false;
+  }
+  foreign_storage::ColumnFilters filters;
+  for (const auto quals : {&ra_exe_unit.simple_quals, &ra_exe_unit.quals}) {
+    for (const auto& qual : *quals) {
+      if (auto filter = get_foreign_table_column_filter(qual.get(), table_desc)) {
+        filters.emplace_back(std::move(*filter));
+      }
+    }
+  }
+  if (filters.empty()) {
+    return false;
+  }
+  auto foreign_storage_mgr =
+      catalog_->getDataMgr().getPersistentStorageMgr()->getForeignStorageMgr();
+  if (!foreign_storage_mgr) {
+    return false;
+  }
+  if (foreign_storage_mgr->canSkipFragment(
+          {catalog_->getDatabaseId(), table_desc.getTableId()},
+          fragment.fragmentId,
+          filters)) {
+    VLOG(2) << "Skipping foreign table fragment with table id: "
+            << table_desc.getTableId() << ", fragment id: " << fragment.fragmentId;
+    return true;
+  }
+  return false;
+}
+
 AggregatedColRange Executor::computeColRangesCache(
     const std::unordered_set<PhysicalInput>& phys_inputs) {
   AggregatedColRange agg_col_range_cache;
@@ -55,7 +55,9 @@
 #include "QueryEngine/JoinHashTable/HashJoin.h"
 #include "QueryEngine/LoopControlFlow/JoinLoop.h"
 #include "QueryEngine/NvidiaKernel.h"
+#include "QueryEngine/PersistentCodeCache.h"
 #include "QueryEngine/PlanState.h"
+#include "QueryEngine/QueryExecutionStats.h"
 #include "QueryEngine/QueryPlanDagCache.h"
 #include "QueryEngine/RelAlgExecutionUnit.h"
 #include "QueryEngine/RelAlgTranslator.h"
@@ -63,6 +65,7 @@
 #include "QueryEngine/StringDictionaryGenerations.h"
 #include "QueryEngine/TableGenerations.h"
 #include "QueryEngine/TargetMetaInfo.h"
+#include "QueryEngine/TieredCompilationQueue.h"
 #include "QueryEngine/WindowContext.h"
 
 #include "DataMgr/Chunk/Chunk.h"
@@ -415,6 +418,22 @@ class Executor {
     }
   }
 
+  // Unlike other modifications, appending rows to a table keeps the partial query
+  // resultsets of its existing fragments valid.
+  static void clearExternalCachesForAppend(const TableDescriptor* td,
+                                           const int current_db_id) {
+    if (td) {
+      const auto& table_chunk_key_prefix = td->getTableChunkKey(current_db_id);
+      if (!table_chunk_key_prefix.empty()) {
+        auto table_key = boost::hash_value(table_chunk_key_prefix);
+        ResultSetRecyclerHolder::markCachedItemAsDirtyForAppend(table_key);
+        UpdateTriggeredCacheInvalidator::invalidateCachesByTable(table_key);
+        return;
+      }
+    }
+    clearExternalCaches(true, td, current_db_id);
+  }
+
   void reset(bool discard_runtime_modules_only = false);
 
   template <typename F>
@@ -523,6 +542,16 @@ class Executor {
    */
   const TemporaryTables* getTemporaryTables() { return temporary_tables_; }
 
+  /**
+   * Returns the collector of the runtime statistics of the query currently executed by
+   * this executor, or nullptr if the query is not run by EXPLAIN ANALYZE.
+   */
+  QueryExecutionStats* getExecutionStats() const { return execution_stats_; }
+
+  void setExecutionStats(QueryExecutionStats* execution_stats) {
+    execution_stats_ = execution_stats;
+  }
+
   /**
    * Returns a string dictionary proxy using the currently active row set memory owner.
    */
@@ -796,6 +825,17 @@ class Executor {
                           const size_t thread_idx,
                           const bool allow_runtime_interrupt);
 
+  // Loads the chunks of the lazily fetched columns fetchChunks() deferred and fills in
+  // their buffers, both in the fetch result and in the results of the kernel, if any.
+  void fetchDeferredChunks(const ColumnFetcher&,
+                           FetchResult&,
+                           ResultSet* results,
+                           const std::map<int, const TableFragments*>&,
+                           std::list<ChunkIter>&,
+                           std::list<std::shared_ptr<Chunk_NS::Chunk>>&,
+                           const int device_id,
+                           DeviceAllocator* device_allocator);
+
   FetchResult fetchUnionChunks(const ColumnFetcher&,
                                const RelAlgExecutionUnit& ra_exe_unit,
                                const int device_id,
@@ -1083,6 +1123,13 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  // Pushes the simple conjunctive qualifiers of the execution unit down to the data
+  // wrapper of a foreign table, which can rule out fragments using statistics that are
+  // more precise than the chunk metadata, e.g. per Parquet row group.
+  bool skipForeignTableFragment(const InputDescriptor& table_desc,
+                                const RelAlgExecutionUnit& ra_exe_unit,
+                                const Fragmenter_Namespace::FragmentInfo& fragment);
+
   AggregatedColRange computeColRangesCache(
       const std::unordered_set<PhysicalInput>& phys_inputs);
   StringDictionaryGenerations computeStringDictionaryGenerations(
@@ -1271,6 +1318,8 @@ class Executor {
   static CodeCacheAccessor<CpuCompilationContext> cpu_code_accessor;
   static CodeCacheAccessor<GpuCompilationContext> gpu_code_accessor;
   static CodeCacheAccessor<CompilationContext> tf_code_accessor;
+  static PersistentCodeCache cpu_persistent_code_cache;
+  static TieredCompilationQueue tiered_compilation_queue;
 
  private:
   static const size_t baseline_threshold{
@@ -1286,6 +1335,7 @@ class Executor {
   const Catalog_Namespace::Catalog* catalog_;
   Data_Namespace::DataMgr* data_mgr_;
   const TemporaryTables* temporary_tables_;
+  QueryExecutionStats* execution_stats_{nullptr};
   TableIdToNodeMap table_id_to_node_map_;
 
   int64_t kernel_queue_time_ms_ = 0;
@@ -24,6 +24,7 @@
 #include "QueryEngine/TableOptimizer.h"
 
 extern bool g_enable_auto_metadata_update;
+extern bool g_enable_snapshot_reads;
 
 UpdateLogForFragment::UpdateLogForFragment(FragmentInfoType const& fragment_info,
                                            size_t const fragment_index,
@@ -184,7 +185,9 @@ TableUpdateMetadata Executor::executeUpdate(
        table_update_metadata);
   }
 
-  if (g_enable_auto_metadata_update) {
+  // with snapshot reads, the stored chunks are only replaced by their updated copies on
+  // commit, so there is nothing to recompute the metadata from yet
+  if (g_enable_auto_metadata_update && !g_enable_snapshot_reads) {
     auto td = cat.getMetadataForTable(table_desc_for_update->tableId);
     TableOptimizer table_optimizer{td, this, cat};
     table_optimizer.recomputeMetadataUnlocked(table_update_metadata);
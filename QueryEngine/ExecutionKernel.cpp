@@ -26,6 +26,7 @@
 #include "QueryEngine/ExternalExecutor.h"
 #include "QueryEngine/QueryEngine.h"
 #include "QueryEngine/SerializeToSql.h"
+#include "Shared/scope.h"
 
 namespace {
 
@@ -173,6 +174,14 @@ void ExecutionKernel::runImpl(Executor* executor,
   CHECK_GE(chosen_device_id, 0);
   CHECK_LT(chosen_device_id, Executor::max_gpu_count);
 
+  auto clock_begin = timer_start();
+  size_t num_input_rows{0};
+  ScopeGuard record_execution_stats = [executor, clock_begin, &num_input_rows] {
+    if (auto execution_stats = executor->getExecutionStats()) {
+      execution_stats->addKernel(num_input_rows, timer_stop(clock_begin));
+    }
+  };
+
   auto catalog = executor->getCatalog();
   CHECK(catalog);
 
@@ -190,8 +199,8 @@ void ExecutionKernel::runImpl(Executor* executor,
         data_mgr, chosen_device_id, getQueryEngineCudaStreamForDevice(chosen_device_id));
   }
   std::shared_ptr<FetchResult> fetch_result(new FetchResult);
+  std::map<int, const TableFragments*> all_tables_fragments;
   try {
-    std::map<int, const TableFragments*> all_tables_fragments;
     QueryFragmentDescriptor::computeAllTablesFragments(
         all_tables_fragments, ra_exe_unit_, shared_context.getQueryInfos());
 
@@ -223,6 +232,9 @@ void ExecutionKernel::runImpl(Executor* executor,
     if (fetch_result->num_rows.empty()) {
       return;
     }
+    for (const auto& frag_num_rows : fetch_result->num_rows) {
+      num_input_rows += frag_num_rows.empty() ? 0 : frag_num_rows.front();
+    }
     if (eo.with_dynamic_watchdog &&
         !shared_context.dynamic_watchdog_set.test_and_set(std::memory_order_acquire)) {
       CHECK_GT(eo.dynamic_watchdog_time_limit, 0u);
@@ -254,6 +266,14 @@ void ExecutionKernel::runImpl(Executor* executor,
                                                std::nullopt);
     const auto query_mem_desc =
         group_by_and_aggregate.initQueryMemoryDescriptor(false, 0, 8, nullptr, false);
+    executor->fetchDeferredChunks(column_fetcher,
+                                  *fetch_result,
+                                  nullptr,
+                                  all_tables_fragments,
+                                  *chunk_iterators_ptr,
+                                  chunks,
+                                  chosen_device_id,
+                                  device_allocator.get());
     device_results_ = run_query_external(
         query,
         *fetch_result,
@@ -305,31 +325,61 @@ void ExecutionKernel::runImpl(Executor* executor,
 #ifdef HAVE_TBB
   bool can_run_subkernels = shared_context.getThreadPool() != nullptr;
 
-  // Sub-tasks are supported for groupby queries and estimators only for now.
+  // Group by queries and estimators accumulate the sub-tasks output into a per-thread
+  // execution context. Non-grouped aggregates and row-wise projections get an output
+  // buffer per sub-task instead, since their buffers cannot be appended to.
   bool is_groupby =
       (ra_exe_unit_.groupby_exprs.size() > 1) ||
       (ra_exe_unit_.groupby_exprs.size() == 1 && ra_exe_unit_.groupby_exprs.front());
-  can_run_subkernels = can_run_subkernels && (is_groupby || ra_exe_unit_.estimator);
+  const bool is_non_grouped_agg =
+      ra_exe_unit_.groupby_exprs.empty() && !ra_exe_unit_.estimator;
+  // A projection sub-task buffer is sized to the rows of the sub-task, which bounds its
+  // output only without joins. Window functions and streaming top-n bake the buffer
+  // entry count into the generated code.
+  const bool is_projection =
+      query_mem_desc.getQueryDescriptionType() == QueryDescriptionType::Projection &&
+      !query_mem_desc.didOutputColumnar() && !query_mem_desc.useStreamingTopN() &&
+      !ra_exe_unit_.use_bump_allocator && !ra_exe_unit_.union_all &&
+      ra_exe_unit_.join_quals.empty() && rowid_lookup_key < 0 &&
+      std::none_of(ra_exe_unit_.target_exprs.begin(),
+                   ra_exe_unit_.target_exprs.end(),
+                   [](const Analyzer::Expr* expr) {
+                     return dynamic_cast<const Analyzer::WindowFunction*>(expr);
+                   });
+  const bool use_subtask_results = is_non_grouped_agg || is_projection;
+  can_run_subkernels = can_run_subkernels && !do_render &&
+                       (is_groupby || ra_exe_unit_.estimator || use_subtask_results);
 
   // In case some column is lazily fetched, we cannot mix different fragments in a single
   // ResultSet.
-  can_run_subkernels =
-      can_run_subkernels && !executor->hasLazyFetchColumns(ra_exe_unit_.target_exprs);
+  can_run_subkernels = can_run_subkernels &&
+                       !executor->hasLazyFetchColumns(ra_exe_unit_.target_exprs) &&
+                       fetch_result->deferred_columns.empty();
 
   // TODO: Use another structure to hold chunks. Currently, ResultSet holds them, but with
   // sub-tasks chunk can be referenced by many ResultSets. So, some outer structure to
-  // hold all ResultSets and all chunks is required.
+  // hold all ResultSets and all chunks is required. Sub-tasks with their own results
+  // make each of them hold all the chunks of the kernel.
   can_run_subkernels =
       can_run_subkernels &&
-      !need_to_hold_chunk(
-          chunks, ra_exe_unit_, std::vector<ColumnLazyFetchInfo>(), chosen_device_type);
+      (use_subtask_results ||
+       !need_to_hold_chunk(
+           chunks, ra_exe_unit_, std::vector<ColumnLazyFetchInfo>(), chosen_device_type));
 
   // TODO: check for literals? We serialize literals before execution and hold them in
   // result sets. Can we simply do it once and holdin an outer structure?
   if (can_run_subkernels) {
     size_t total_rows = fetch_result->num_rows[0][0];
     size_t sub_size = g_cpu_sub_task_size;
+    CHECK_GT(sub_size, size_t(0));
 
+    std::shared_ptr<KernelSubtaskResults> subtask_results;
+    if (use_subtask_results && total_rows > start_rowid) {
+      subtask_results = std::make_shared<KernelSubtaskResults>(
+          (total_rows - start_rowid + sub_size - 1) / sub_size, chunks);
+    }
+
+    size_t subtask_idx = 0;
     for (size_t sub_start = start_rowid; sub_start < total_rows; sub_start += sub_size) {
       sub_size = (sub_start + sub_size > total_rows) ? total_rows - sub_start : sub_size;
       auto subtask = std::make_shared<KernelSubtask>(*this,
@@ -339,7 +389,9 @@ void ExecutionKernel::runImpl(Executor* executor,
                                                      total_num_input_rows,
                                                      sub_start,
                                                      sub_size,
-                                                     thread_idx);
+                                                     thread_idx,
+                                                     subtask_results,
+                                                     subtask_idx++);
       shared_context.getThreadPool()->run(
           [subtask, executor] { subtask->run(executor); });
     }
@@ -348,6 +400,18 @@ void ExecutionKernel::runImpl(Executor* executor,
   }
 #endif  // HAVE_TBB
 
+  if (do_render) {
+    // The renderer reads the column buffers directly.
+    executor->fetchDeferredChunks(column_fetcher,
+                                  *fetch_result,
+                                  nullptr,
+                                  all_tables_fragments,
+                                  *chunk_iterators_ptr,
+                                  chunks,
+                                  chosen_device_id,
+                                  device_allocator.get());
+  }
+
   if (eo.executor_type == ExecutorType::Native) {
     try {
       // std::unique_ptr<QueryExecutionContext> query_exe_context_owned
@@ -419,6 +483,23 @@ void ExecutionKernel::runImpl(Executor* executor,
                                            eo.allow_runtime_query_interrupt,
                                            do_render ? render_info_ : nullptr);
   }
+  if (device_results_ && !err && !fetch_result->deferred_columns.empty()) {
+    // Late materialization: the chunks of the lazily fetched columns are only needed
+    // if some rows of the fragments survived the filters and joins.
+    if (device_results_->isEmpty()) {
+      VLOG(1) << "Skipping " << fetch_result->deferred_columns.size()
+              << " deferred column chunk(s) of fragments without output rows.";
+    } else {
+      executor->fetchDeferredChunks(column_fetcher,
+                                    *fetch_result,
+                                    device_results_.get(),
+                                    all_tables_fragments,
+                                    *chunk_iterators_ptr,
+                                    chunks,
+                                    chosen_device_id,
+                                    device_allocator.get());
+    }
+  }
   if (device_results_) {
     std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_to_hold;
     for (const auto& chunk : chunks) {
@@ -470,7 +551,10 @@ void KernelSubtask::run(Executor* executor) {
 }
 
 void KernelSubtask::runImpl(Executor* executor) {
-  auto& query_exe_context_owned = shared_context_.getTlsExecutionContext().local();
+  std::unique_ptr<QueryExecutionContext> subtask_exe_context;
+  auto& query_exe_context_owned = subtask_results_
+                                      ? subtask_exe_context
+                                      : shared_context_.getTlsExecutionContext().local();
   const bool do_render =
       kernel_.render_info_ && kernel_.render_info_->isPotentialInSituRender();
   const CompilationResult& compilation_result =
@@ -489,7 +573,14 @@ void KernelSubtask::runImpl(Executor* executor) {
       std::vector<std::vector<uint64_t>> frag_offsets(
           fetch_result_->frag_offsets.size(),
           std::vector<uint64_t>(fetch_result_->frag_offsets[0].size()));
-      query_exe_context_owned = kernel_.query_mem_desc.getQueryExecutionContext(
+      auto query_mem_desc = kernel_.query_mem_desc;
+      if (subtask_results_ &&
+          query_mem_desc.getQueryDescriptionType() == QueryDescriptionType::Projection) {
+        // every input row of the sub-task produces at most one output row
+        query_mem_desc.setEntryCount(
+            std::min(query_mem_desc.getEntryCount(), num_rows_to_process_));
+      }
+      query_exe_context_owned = query_mem_desc.getQueryExecutionContext(
           kernel_.ra_exe_unit_,
           executor,
           kernel_.chosen_device_type,
@@ -516,12 +607,14 @@ void KernelSubtask::runImpl(Executor* executor) {
   QueryExecutionContext* query_exe_context{query_exe_context_owned.get()};
   CHECK(query_exe_context);
   int32_t err{0};
+  ResultSetPtr subtask_result;
+  ResultSetPtr* results = subtask_results_ ? &subtask_result : nullptr;
 
   if (kernel_.ra_exe_unit_.groupby_exprs.empty()) {
     err = executor->executePlanWithoutGroupBy(kernel_.ra_exe_unit_,
                                               compilation_result,
                                               kernel_.query_comp_desc.hoistLiterals(),
-                                              nullptr,
+                                              results,
                                               kernel_.ra_exe_unit_.target_exprs,
                                               kernel_.chosen_device_type,
                                               fetch_result_->col_buffers,
@@ -539,7 +632,7 @@ void KernelSubtask::runImpl(Executor* executor) {
     err = executor->executePlanWithGroupBy(kernel_.ra_exe_unit_,
                                            compilation_result,
                                            kernel_.query_comp_desc.hoistLiterals(),
-                                           nullptr,
+                                           results,
                                            kernel_.chosen_device_type,
                                            fetch_result_->col_buffers,
                                            outer_tab_frag_ids,
@@ -560,6 +653,21 @@ void KernelSubtask::runImpl(Executor* executor) {
   if (err) {
     throw QueryExecutionError(err);
   }
+
+  if (subtask_results_) {
+    if (subtask_result) {
+      subtask_result->holdChunks(subtask_results_->chunks);
+      subtask_result->holdChunkIterators(chunk_iterators_);
+    }
+    subtask_results_->results[subtask_idx_] = std::move(subtask_result);
+    if (--subtask_results_->pending == 0) {
+      for (auto& result : subtask_results_->results) {
+        if (result) {
+          shared_context_.addDeviceResults(std::move(result), outer_tab_frag_ids);
+        }
+      }
+    }
+  }
 }
 
 #endif  // HAVE_TBB
@@ -122,6 +122,20 @@ class ExecutionKernel {
 };
 
 #ifdef HAVE_TBB
+// Output of the sub-tasks of a kernel which cannot accumulate into a per-thread buffer
+// (projections and non-grouped aggregates). Each sub-task fills its own slot and the
+// last one to finish hands the results over to the shared context in row order.
+struct KernelSubtaskResults {
+  KernelSubtaskResults(const size_t num_subtasks,
+                       std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks)
+      : results(num_subtasks), pending(num_subtasks), chunks(std::move(chunks)) {}
+
+  std::vector<ResultSetPtr> results;
+  std::atomic<size_t> pending;
+  // the chunks the results may point to; every result set holds all of them
+  const std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks;
+};
+
 class KernelSubtask {
  public:
   KernelSubtask(ExecutionKernel& k,
@@ -131,7 +145,9 @@ class KernelSubtask {
                 int64_t total_num_input_rows,
                 size_t start_rowid,
                 size_t num_rows_to_process,
-                size_t thread_idx)
+                size_t thread_idx,
+                std::shared_ptr<KernelSubtaskResults> subtask_results = nullptr,
+                size_t subtask_idx = 0)
       : kernel_(k)
       , shared_context_(shared_context)
       , fetch_result_(fetch_result)
@@ -139,7 +155,9 @@ class KernelSubtask {
       , total_num_input_rows_(total_num_input_rows)
       , start_rowid_(start_rowid)
       , num_rows_to_process_(num_rows_to_process)
-      , thread_idx_(thread_idx) {}
+      , thread_idx_(thread_idx)
+      , subtask_results_(subtask_results)
+      , subtask_idx_(subtask_idx) {}
 
   void run(Executor* executor);
 
@@ -154,5 +172,8 @@ class KernelSubtask {
   size_t start_rowid_;
   size_t num_rows_to_process_;
   size_t thread_idx_;
+  // null when the sub-task accumulates into the per-thread execution context
+  std::shared_ptr<KernelSubtaskResults> subtask_results_;
+  size_t subtask_idx_;
 };
 #endif  // HAVE_TBB
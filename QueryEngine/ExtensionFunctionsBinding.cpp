@@ -467,7 +467,8 @@ std::tuple<T, std::vector<SQLTypeInfo>> bind_function(
    */
   if (!is_valid_identifier(name)) {
     throw NativeExecutionError(
-        "Cannot bind function with invalid UDF/UDTF function name: " + name);
+        "Cannot bind function with invalid UDF/UDTF function name: " + name,
+        NativeExecutionErrorReason::InvalidUdfName);
   }
 
   int minimal_score = std::numeric_limits<int>::max();
@@ -25,13 +25,16 @@
  */
 
 // Classes that are involved in needing a cache invalidated
+#include "GroupByAndAggregate.h"
 #include "JoinHashTable/BaselineJoinHashTable.h"
 #include "JoinHashTable/OverlapsJoinHashTable.h"
 #include "JoinHashTable/PerfectJoinHashTable.h"
 #include "ResultSetRecyclerHolder.h"
 
-using UpdateTriggeredCacheInvalidator =
-    CacheInvalidator<OverlapsJoinHashTable, BaselineJoinHashTable, PerfectJoinHashTable>;
+using UpdateTriggeredCacheInvalidator = CacheInvalidator<OverlapsJoinHashTable,
+                                                         BaselineJoinHashTable,
+                                                         PerfectJoinHashTable,
+                                                         GroupByAndAggregate>;
 using DeleteTriggeredCacheInvalidator = UpdateTriggeredCacheInvalidator;
 
 // Note that this is functionally the same as the above two invalidators. The
@@ -19,8 +19,12 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/OutputBufferInitialization.h"
+#include "Shared/measure.h"
 #include "SqliteConnector/SqliteConnector.h"
 
+extern bool g_enable_interop;
+extern size_t g_max_external_execution_input_rows;
+
 namespace {
 
 struct OmniSciVtab {
@@ -520,12 +524,77 @@ std::unique_ptr<ResultSet> run_query_external(
                                           create_table_schema(plan_state),
                                           sql.from_table,
                                           output_spec.executor};
+  auto clock_begin = timer_start();
   SqliteMemDatabase db(external_query_table);
   const auto create_table = "create virtual table " + sql.from_table + " using omnisci";
   db.run(create_table);
-  return db.runSelect(sql.query, output_spec);
+  auto rs = db.runSelect(sql.query, output_spec);
+  LOG(INFO) << "External execution of " << sql.query << " took "
+            << timer_stop(clock_begin) << " ms";
+  return rs;
 }
 
 bool is_supported_type_for_extern_execution(const SQLTypeInfo& ti) {
   return ti.is_integer() || ti.is_fp() || ti.is_string();
 }
+
+std::ostream& operator<<(std::ostream& os, const NativeExecutionErrorReason reason) {
+  switch (reason) {
+    case NativeExecutionErrorReason::InvalidUdfName:
+      return os << "InvalidUdfName";
+    case NativeExecutionErrorReason::WindowFunctionOutsideProjection:
+      return os << "WindowFunctionOutsideProjection";
+  }
+  UNREACHABLE();
+  return os;
+}
+
+namespace {
+
+std::mutex fallback_counts_mutex;
+std::map<NativeExecutionErrorReason, ExternalExecutionFallbackCounts> fallback_counts;
+
+void record_external_execution_fallback(const NativeExecutionErrorReason reason,
+                                        const size_t input_rows,
+                                        const bool executed) {
+  std::lock_guard<std::mutex> lock(fallback_counts_mutex);
+  auto& counts = fallback_counts[reason];
+  if (executed) {
+    ++counts.executed;
+    counts.input_rows += input_rows;
+  } else {
+    ++counts.refused;
+  }
+}
+
+}  // namespace
+
+void check_external_execution_fallback(const NativeExecutionError& e,
+                                       const size_t input_rows,
+                                       const bool is_aggregate) {
+  if (!g_enable_interop) {
+    throw e;
+  }
+  if (is_aggregate) {
+    record_external_execution_fallback(e.getReason(), input_rows, false);
+    LOG(INFO) << "Also failed to run the query using interoperability";
+    throw e;
+  }
+  if (g_max_external_execution_input_rows &&
+      input_rows > g_max_external_execution_input_rows) {
+    record_external_execution_fallback(e.getReason(), input_rows, false);
+    throw std::runtime_error("Query step cannot be executed natively (" +
+                             std::string(e.what()) + ") and its " +
+                             std::to_string(input_rows) +
+                             " input rows exceed the limit of " +
+                             std::to_string(g_max_external_execution_input_rows) +
+                             " rows for external execution.");
+  }
+  record_external_execution_fallback(e.getReason(), input_rows, true);
+}
+
+std::map<NativeExecutionErrorReason, ExternalExecutionFallbackCounts>
+get_external_execution_fallback_counts() {
+  std::lock_guard<std::mutex> lock(fallback_counts_mutex);
+  return fallback_counts;
+}
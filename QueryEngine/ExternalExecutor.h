@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <map>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -40,9 +42,21 @@ struct ExternalQueryOutputSpec {
   const Executor* executor;
 };
 
+// why the native executor could not execute a query step
+enum class NativeExecutionErrorReason { InvalidUdfName, WindowFunctionOutsideProjection };
+
+std::ostream& operator<<(std::ostream& os, const NativeExecutionErrorReason reason);
+
 class NativeExecutionError : public std::runtime_error {
  public:
-  NativeExecutionError(const std::string& message) : std::runtime_error(message) {}
+  NativeExecutionError(const std::string& message,
+                       const NativeExecutionErrorReason reason)
+      : std::runtime_error(message), reason_(reason) {}
+
+  NativeExecutionErrorReason getReason() const { return reason_; }
+
+ private:
+  NativeExecutionErrorReason reason_;
 };
 
 class SqliteMemDatabase {
@@ -67,3 +81,23 @@ std::unique_ptr<ResultSet> run_query_external(const ExecutionUnitSql& sql,
                                               const ExternalQueryOutputSpec& output_spec);
 
 bool is_supported_type_for_extern_execution(const SQLTypeInfo& ti);
+
+struct ExternalExecutionFallbackCounts {
+  // query steps executed through the external executor
+  size_t executed{0};
+  // query steps the external executor has not been allowed to or cannot execute
+  size_t refused{0};
+  // input rows of the executed query steps
+  size_t input_rows{0};
+};
+
+// Records a query step which the native executor could not execute and decides whether
+// it runs through the external executor instead. Throws the native execution error back
+// if interoperability is disabled or the step aggregates, and a runtime error if the step
+// reads more rows than --max-external-execution-input-rows.
+void check_external_execution_fallback(const NativeExecutionError& e,
+                                       const size_t input_rows,
+                                       const bool is_aggregate);
+
+std::map<NativeExecutionErrorReason, ExternalExecutionFallbackCounts>
+get_external_execution_fallback_counts();
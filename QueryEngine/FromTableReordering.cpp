@@ -16,13 +16,19 @@
 
 #include "FromTableReordering.h"
 #include "../Analyzer/Analyzer.h"
+#include "ColumnStatistics.h"
 #include "Execute.h"
 #include "RangeTableIndexVisitor.h"
 
+#include <algorithm>
+#include <limits>
 #include <numeric>
 #include <queue>
 #include <regex>
 
+bool g_enable_cost_based_join_ordering{false};
+size_t g_cost_based_join_ordering_max_dp_tables{10};
+
 namespace {
 
 using cost_t = unsigned;
@@ -459,12 +465,234 @@ std::vector<node_t> traverse_join_cost_graph(
   return input_permutation;
 }
 
+// Estimates the cost of left-deep join orders from column statistics. The first table of
+// an order is scanned, a hash table is built on every following table and probed with
+// the rows joined so far, and the filters of a table are applied once it is joined.
+class JoinOrderCostModel {
+ public:
+  JoinOrderCostModel(const JoinQualsPerNestingLevel& left_deep_join_quals,
+                     const std::vector<InputTableInfo>& table_infos,
+                     const Executor* executor)
+      : num_tables_(table_infos.size())
+      , num_rows_(num_tables_)
+      , filter_selectivity_(num_tables_, 1.)
+      , join_edges_(num_tables_) {
+    CHECK_EQ(left_deep_join_quals.size() + 1, num_tables_);
+    for (size_t i = 0; i < num_tables_; ++i) {
+      num_rows_[i] = table_infos[i].info.getNumTuplesUpperBound();
+    }
+    ColumnStatisticsProvider column_statistics(table_infos);
+    AllRangeTableIndexVisitor visitor;
+    for (const auto& current_level_join_conditions : left_deep_join_quals) {
+      if (current_level_join_conditions.type != JoinType::INNER) {
+        return;
+      }
+      for (const auto& qual : current_level_join_conditions.quals) {
+        const auto qual_nest_levels = visitor.visit(qual.get());
+        if (qual_nest_levels.size() == 1) {
+          filter_selectivity_[*qual_nest_levels.begin()] *=
+              column_statistics.estimateSelectivity(qual.get());
+          continue;
+        }
+        if (qual_nest_levels.size() != 2) {
+          continue;
+        }
+        const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual.get());
+        if (!bin_oper || bin_oper->get_optype() == kOVERLAPS) {
+          // keep the heuristic ordering of geospatial and function joins
+          return;
+        }
+        const node_t lhs_nest_level = *qual_nest_levels.begin();
+        const node_t rhs_nest_level = *qual_nest_levels.rbegin();
+        const bool is_hash_join = IS_EQUIVALENCE(bin_oper->get_optype()) &&
+                                  std::get<0>(get_join_qual_cost(bin_oper, executor)) <
+                                      200;
+        const double selectivity =
+            IS_EQUIVALENCE(bin_oper->get_optype())
+                ? column_statistics.estimateJoinSelectivity(bin_oper)
+                : kDefaultRangeSelectivity;
+        for (const auto& [from, to] : {std::make_pair(lhs_nest_level, rhs_nest_level),
+                                       std::make_pair(rhs_nest_level, lhs_nest_level)}) {
+          auto& edge = join_edges_[from].emplace(to, JoinEdge{1., false}).first->second;
+          edge.selectivity *= selectivity;
+          edge.is_hash_join |= is_hash_join;
+        }
+      }
+    }
+    is_supported_ = true;
+  }
+
+  // Returns the cheapest join order, or std::nullopt if the model does not apply or no
+  // order avoids loop joins on non-trivial tables.
+  std::optional<std::vector<node_t>> getBestOrder() const {
+    if (!is_supported_) {
+      return std::nullopt;
+    }
+    const auto max_dp_tables = std::min(g_cost_based_join_ordering_max_dp_tables,
+                                        kMaxCostBasedJoinOrderingDpTables);
+    return num_tables_ <= max_dp_tables ? getBestOrderDP() : getBestOrderGreedy();
+  }
+
+ private:
+  static constexpr double kInfeasible{std::numeric_limits<double>::infinity()};
+  // Hash tables are built from the whole inner table before the probe starts, while the
+  // kernels of a query are parallelized over the fragments of the outer table, so a row
+  // is costlier to insert into a hash table than to scan or probe with.
+  static constexpr double kHashTableBuildCostPerRow{4};
+
+  struct JoinEdge {
+    double selectivity;
+    bool is_hash_join;
+  };
+
+  double getScanCost(const node_t table) const { return num_rows_[table]; }
+
+  double getFilteredRows(const node_t table) const {
+    return std::max(num_rows_[table] * filter_selectivity_[table], 1.);
+  }
+
+  // Cost of joining the table to the joined tables, given the number of rows they
+  // produce. Returns the cost and the number of rows produced by the join.
+  std::pair<double, double> getJoinCost(const std::vector<bool>& joined_tables,
+                                        const double num_joined_rows,
+                                        const node_t table) const {
+    double selectivity{1};
+    bool is_hash_join{false};
+    for (const auto& [other_table, edge] : join_edges_[table]) {
+      if (joined_tables[other_table]) {
+        selectivity *= edge.selectivity;
+        is_hash_join |= edge.is_hash_join;
+      }
+    }
+    const double num_rows =
+        std::max(num_joined_rows * getFilteredRows(table) * selectivity, 1.);
+    if (is_hash_join) {
+      return {kHashTableBuildCostPerRow * num_rows_[table] + num_joined_rows + num_rows,
+              num_rows};
+    }
+    if (num_rows_[table] <= g_trivial_loop_join_threshold) {
+      return {num_joined_rows * std::max(num_rows_[table], 1.) + num_rows, num_rows};
+    }
+    return {kInfeasible, num_rows};
+  }
+
+  // Dynamic programming over the sets of joined tables. The number of rows produced by
+  // a set of tables does not depend on their order, so the cheapest order of a set is
+  // the cheapest order of one of its subsets followed by the remaining table.
+  std::optional<std::vector<node_t>> getBestOrderDP() const {
+    CHECK_LT(num_tables_, sizeof(size_t) * 8);
+    const size_t num_sets = size_t(1) << num_tables_;
+    std::vector<double> set_cost(num_sets, kInfeasible);
+    std::vector<double> set_rows(num_sets, 0);
+    std::vector<node_t> set_last_table(num_sets, 0);
+    for (node_t table = 0; table < num_tables_; ++table) {
+      const size_t set = size_t(1) << table;
+      set_cost[set] = getScanCost(table) + getFilteredRows(table);
+      set_rows[set] = getFilteredRows(table);
+      set_last_table[set] = table;
+    }
+    std::vector<bool> joined_tables(num_tables_);
+    for (size_t set = 1; set < num_sets; ++set) {
+      if (set_cost[set] == kInfeasible) {
+        continue;
+      }
+      for (node_t table = 0; table < num_tables_; ++table) {
+        joined_tables[table] = set & (size_t(1) << table);
+      }
+      for (node_t table = 0; table < num_tables_; ++table) {
+        if (joined_tables[table]) {
+          continue;
+        }
+        const auto [join_cost, join_rows] =
+            getJoinCost(joined_tables, set_rows[set], table);
+        const size_t next_set = set | (size_t(1) << table);
+        if (set_cost[set] + join_cost < set_cost[next_set]) {
+          set_cost[next_set] = set_cost[set] + join_cost;
+          set_rows[next_set] = join_rows;
+          set_last_table[next_set] = table;
+        }
+      }
+    }
+    size_t set = num_sets - 1;
+    if (set_cost[set] == kInfeasible) {
+      return std::nullopt;
+    }
+    VLOG(1) << "Cost-based join ordering estimated cost " << set_cost[set] << " for "
+            << set_rows[set] << " joined rows";
+    std::vector<node_t> input_permutation;
+    while (set) {
+      input_permutation.push_back(set_last_table[set]);
+      set &= ~(size_t(1) << set_last_table[set]);
+    }
+    std::reverse(input_permutation.begin(), input_permutation.end());
+    return input_permutation;
+  }
+
+  // For too many tables to enumerate the sets, starts from every table in turn and
+  // joins the table with the cheapest join next.
+  std::optional<std::vector<node_t>> getBestOrderGreedy() const {
+    std::optional<std::vector<node_t>> best_permutation;
+    double best_cost = kInfeasible;
+    for (node_t start = 0; start < num_tables_; ++start) {
+      std::vector<node_t> input_permutation{start};
+      std::vector<bool> joined_tables(num_tables_);
+      joined_tables[start] = true;
+      double cost = getScanCost(start) + getFilteredRows(start);
+      double num_rows = getFilteredRows(start);
+      while (input_permutation.size() < num_tables_ && cost < best_cost) {
+        std::optional<node_t> next_table;
+        double next_cost{kInfeasible}, next_rows{0};
+        for (node_t table = 0; table < num_tables_; ++table) {
+          if (joined_tables[table]) {
+            continue;
+          }
+          const auto [join_cost, join_rows] =
+              getJoinCost(joined_tables, num_rows, table);
+          if (join_cost < next_cost) {
+            next_table = table;
+            next_cost = join_cost;
+            next_rows = join_rows;
+          }
+        }
+        if (!next_table) {
+          cost = kInfeasible;
+          break;
+        }
+        input_permutation.push_back(*next_table);
+        joined_tables[*next_table] = true;
+        cost += next_cost;
+        num_rows = next_rows;
+      }
+      if (cost < best_cost) {
+        best_cost = cost;
+        best_permutation = std::move(input_permutation);
+      }
+    }
+    return best_permutation;
+  }
+
+  const size_t num_tables_;
+  std::vector<double> num_rows_;
+  std::vector<double> filter_selectivity_;
+  std::vector<std::map<node_t, JoinEdge>> join_edges_;
+  bool is_supported_{false};
+};
+
 }  // namespace
 
 std::vector<node_t> get_node_input_permutation(
     const JoinQualsPerNestingLevel& left_deep_join_quals,
     const std::vector<InputTableInfo>& table_infos,
     const Executor* executor) {
+  if (g_enable_cost_based_join_ordering && table_infos.size() > 2) {
+    const auto input_permutation =
+        JoinOrderCostModel(left_deep_join_quals, table_infos, executor).getBestOrder();
+    if (input_permutation) {
+      VLOG(1) << "Cost-based join ordering picked input permutation "
+              << shared::printContainer(*input_permutation);
+      return *input_permutation;
+    }
+  }
   std::vector<std::map<node_t, InnerQualDecision>> qual_normalization_res(
       table_infos.size());
   const auto join_cost_graph = build_join_cost_graph(
@@ -19,7 +19,16 @@
 #include "InputMetadata.h"
 #include "RelAlgExecutionUnit.h"
 
-// Returns a FROM permutation for the given join qualifiers and table sizes.
+extern bool g_enable_cost_based_join_ordering;
+extern size_t g_cost_based_join_ordering_max_dp_tables;
+
+// The dynamic programming join ordering keeps a state per subset of the joined tables,
+// so g_cost_based_join_ordering_max_dp_tables is capped at this many tables.
+constexpr size_t kMaxCostBasedJoinOrderingDpTables{20};
+
+// Returns a FROM permutation for the given join qualifiers and table sizes. With
+// cost-based join ordering, the permutation of inner joins with the lowest estimated cost
+// is picked using the statistics of the join and filter columns.
 std::vector<size_t> get_node_input_permutation(
     const JoinQualsPerNestingLevel& left_deep_join_quals,
     const std::vector<InputTableInfo>& table_infos,
@@ -53,8 +53,14 @@ bool g_cluster{false};
 bool g_bigint_count{false};
 int g_hll_precision_bits{11};
 size_t g_watchdog_baseline_max_groups{120000000};
+bool g_enable_adaptive_group_by_layout{false};
+double g_adaptive_group_by_min_fill_ratio{0.01};
 extern int64_t g_bitmap_memory_limit;
 extern size_t g_leaf_count;
+extern size_t g_default_max_groups_buffer_entry_guess;
+
+std::unique_ptr<GroupByLayoutRecycler> GroupByAndAggregate::group_by_layout_cache_ =
+    std::make_unique<GroupByLayoutRecycler>();
 
 namespace {
 
@@ -297,6 +303,39 @@ ColRangeInfo GroupByAndAggregate::getColRangeInfo() {
   return col_range_info;
 }
 
+ColRangeInfo GroupByAndAggregate::applyRecordedLayout(
+    const ColRangeInfo& col_range_info) const {
+  if (!g_enable_adaptive_group_by_layout ||
+      col_range_info.hash_type_ != QueryDescriptionType::GroupByPerfectHash ||
+      col_range_info.bucket || ra_exe_unit_.groupby_exprs.empty() ||
+      !ra_exe_unit_.groupby_exprs.front() ||
+      expr_is_rowid(ra_exe_unit_.groupby_exprs.front().get(), *executor_->catalog_)) {
+    return col_range_info;
+  }
+  const auto layout_stats =
+      group_by_layout_cache_->getItemFromCache(ra_exe_unit_.query_plan_dag_hash,
+                                               CacheItemType::GROUP_BY_LAYOUT_STATS,
+                                               GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER);
+  // a small perfect hash buffer is cheap to initialize and reduce, even if sparse
+  if (!layout_stats ||
+      layout_stats->layout != QueryDescriptionType::GroupByPerfectHash ||
+      layout_stats->entry_count <= g_default_max_groups_buffer_entry_guess ||
+      layout_stats->getFillRatio() >= g_adaptive_group_by_min_fill_ratio) {
+    return col_range_info;
+  }
+  VLOG(1) << "Using baseline hash layout since the previous execution filled "
+          << layout_stats->num_groups << " of " << layout_stats->entry_count
+          << " perfect hash entries";
+  if (ra_exe_unit_.groupby_exprs.size() != 1) {
+    return {QueryDescriptionType::GroupByBaselineHash, 0, 0, 0, false};
+  }
+  return {QueryDescriptionType::GroupByBaselineHash,
+          col_range_info.min,
+          col_range_info.max,
+          0,
+          col_range_info.has_nulls};
+}
+
 int64_t GroupByAndAggregate::getBucketedCardinality(const ColRangeInfo& col_range_info) {
   checked_int64_t crt_col_cardinality =
       checked_int64_t(col_range_info.max) - checked_int64_t(col_range_info.min);
@@ -725,7 +764,7 @@ std::unique_ptr<QueryMemoryDescriptor> GroupByAndAggregate::initQueryMemoryDescr
 
   const bool is_group_by{!ra_exe_unit_.groupby_exprs.empty()};
 
-  auto col_range_info_nosharding = getColRangeInfo();
+  auto col_range_info_nosharding = applyRecordedLayout(getColRangeInfo());
 
   const auto shard_count =
       device_type_ == ExecutorDeviceType::GPU
@@ -1323,6 +1362,8 @@ GroupByAndAggregate::codegenMultiColumnBaselineHash(
   }
   if (co.with_dynamic_watchdog) {
     func_name += "_with_watchdog";
+  } else if (query_mem_desc.hasHotGroupCache(co.device_type)) {
+    func_name += "_with_hot_cache";
   }
   if (query_mem_desc.didOutputColumnar()) {
     return std::make_tuple(groups_buffer, emitCall(func_name, func_args));
@@ -20,6 +20,7 @@
 #include "BufferCompaction.h"
 #include "ColumnarResults.h"
 #include "CompilationOptions.h"
+#include "DataRecycler/GroupByLayoutRecycler.h"
 #include "GpuMemUtils.h"
 #include "GpuSharedMemoryContext.h"
 #include "InputMetadata.h"
@@ -78,6 +79,29 @@ class GroupByAndAggregate {
   static size_t shard_count_for_top_groups(const RelAlgExecutionUnit& ra_exe_unit,
                                            const Catalog_Namespace::Catalog& catalog);
 
+  static void invalidateCache() {
+    CHECK(group_by_layout_cache_);
+    group_by_layout_cache_->clearCache();
+  }
+
+  static void markCachedItemAsDirty(size_t table_key) {
+    CHECK(group_by_layout_cache_);
+    auto candidate_table_keys =
+        group_by_layout_cache_->getMappedQueryPlanDagsWithTableKey(table_key);
+    if (candidate_table_keys.has_value()) {
+      group_by_layout_cache_->markCachedItemAsDirty(
+          table_key,
+          *candidate_table_keys,
+          CacheItemType::GROUP_BY_LAYOUT_STATS,
+          GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER);
+    }
+  }
+
+  static GroupByLayoutRecycler* getGroupByLayoutCache() {
+    CHECK(group_by_layout_cache_);
+    return group_by_layout_cache_.get();
+  }
+
  private:
   bool gpuCanHandleOrderEntries(const std::list<Analyzer::OrderEntry>& order_entries);
 
@@ -139,6 +163,11 @@ class GroupByAndAggregate {
 
   ColRangeInfo getColRangeInfo();
 
+  // Overrides a perfect hash layout chosen from the expression ranges by the baseline
+  // one if the previous execution of the query step filled only a small fraction of its
+  // perfect hash buffer.
+  ColRangeInfo applyRecordedLayout(const ColRangeInfo& col_range_info) const;
+
   static int64_t getBucketedCardinality(const ColRangeInfo& col_range_info);
 
   llvm::Value* convertNullIfAny(const SQLTypeInfo& arg_type,
@@ -209,6 +238,8 @@ class GroupByAndAggregate {
 
   const std::optional<int64_t> group_cardinality_estimation_;
 
+  static std::unique_ptr<GroupByLayoutRecycler> group_by_layout_cache_;
+
   friend class Executor;
   friend class QueryMemoryDescriptor;
   friend class CodeGenerator;
@@ -47,6 +47,75 @@ extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t* get_group_value(
   return NULL;
 }
 
+// Looks up the entry of the key in a small cache of the entries of the most frequent keys
+// first, which saves hashing the key and probing the groups buffer for the heavy hitters
+// of a skewed group by. The cache holds entry indices only and aggregates always go to
+// the groups buffer, so there is nothing to flush. A miss on an occupied cache slot
+// replaces the cached entry.
+extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t* get_group_value_with_hot_cache(
+    int64_t* groups_buffer,
+    const uint32_t groups_buffer_entry_count,
+    const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t key_width,
+    const uint32_t row_size_quad) {
+  int64_t* hot_cache =
+      groups_buffer + static_cast<int64_t>(groups_buffer_entry_count) * row_size_quad;
+  int64_t& lookup_count = hot_cache[0];
+  int64_t& hit_count = hot_cache[1];
+  if (lookup_count < 0) {
+    return get_group_value(groups_buffer,
+                           groups_buffer_entry_count,
+                           key,
+                           key_count,
+                           key_width,
+                           row_size_quad);
+  }
+  // a cheaper hash than key_hash is good enough for a cache of a few dozens slots
+  uint64_t cache_hash{0};
+  for (uint32_t i = 0; i < key_count; ++i) {
+    const int64_t key_component =
+        key_width == 4 ? reinterpret_cast<const int32_t*>(key)[i] : key[i];
+    cache_hash = (cache_hash ^ static_cast<uint64_t>(key_component)) *
+                 uint64_t(0x9E3779B97F4A7C15);
+  }
+  int64_t& cached_entry =
+      hot_cache[HOT_GROUP_CACHE_HEADER_QW + (cache_hash >> 32) % HOT_GROUP_CACHE_SIZE];
+  ++lookup_count;
+  int64_t* cached_group{nullptr};
+  if (cached_entry) {
+    cached_group = get_matching_group_value(groups_buffer,
+                                            static_cast<uint32_t>(cached_entry - 1),
+                                            key,
+                                            key_count,
+                                            key_width,
+                                            row_size_quad);
+    if (cached_group) {
+      ++hit_count;
+    }
+  }
+  // decided exactly once, on the last sampled lookup, whether it hits or not
+  if (lookup_count == HOT_GROUP_CACHE_SAMPLE_SIZE && 2 * hit_count < lookup_count) {
+    // the keys are not skewed enough for the cache to pay off
+    lookup_count = -1;
+  }
+  if (cached_group) {
+    return cached_group;
+  }
+  uint32_t h = key_hash(key, key_count, key_width) % groups_buffer_entry_count;
+  uint32_t h_probe = h;
+  do {
+    int64_t* matching_group = get_matching_group_value(
+        groups_buffer, h_probe, key, key_count, key_width, row_size_quad);
+    if (matching_group) {
+      cached_entry = h_probe + 1;
+      return matching_group;
+    }
+    h_probe = (h_probe + 1) % groups_buffer_entry_count;
+  } while (h_probe != h);
+  return NULL;
+}
+
 extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE bool dynamic_watchdog();
 
 extern "C" RUNTIME_EXPORT NEVER_INLINE DEVICE int64_t* get_group_value_with_watchdog(
@@ -165,7 +165,9 @@ std::vector<llvm::Value*> CodeGenerator::codegen(const Analyzer::Expr* expr,
     return {posArg(nullptr)};
   }
   if (dynamic_cast<const Analyzer::WindowFunction*>(expr)) {
-    throw NativeExecutionError("Window expression not supported in this context");
+    throw NativeExecutionError(
+        "Window expression not supported in this context",
+        NativeExecutionErrorReason::WindowFunctionOutsideProjection);
   }
   abort();
 }
@@ -16,6 +16,9 @@
 
 #include "QueryEngine/Execute.h"
 
+#include <cctype>
+#include <future>
+
 #if LLVM_VERSION_MAJOR < 9
 static_assert(false, "LLVM Version >= 9 is required.");
 #endif
@@ -70,6 +73,7 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include "QueryEngine/QueryTemplateGenerator.h"
 #include "Shared/InlineNullValues.h"
 #include "Shared/MathUtils.h"
+#include "Shared/scope.h"
 #include "StreamingTopN.h"
 
 float g_fraction_code_cache_to_evict = 0.2;
@@ -347,6 +351,20 @@ void optimize_ir(llvm::Function* query_func,
 
   eliminate_dead_self_recursive_funcs(*llvm_module, live_funcs);
 }
+
+// Only the passes which are cheap and which the code relies upon (inlining of the
+// always_inline runtime functions), plus register promotion which removes most of the
+// stack traffic of unoptimized code for little compilation time.
+void optimize_ir_minimal(llvm::Module* llvm_module,
+                         llvm::legacy::PassManager& pass_manager,
+                         const std::unordered_set<llvm::Function*>& live_funcs) {
+  auto timer = DEBUG_TIMER(__func__);
+  pass_manager.add(llvm::createAlwaysInlinerLegacyPass());
+  pass_manager.add(llvm::createPromoteMemoryToRegisterPass());
+  pass_manager.run(*llvm_module);
+
+  eliminate_dead_self_recursive_funcs(*llvm_module, live_funcs);
+}
 #endif
 
 }  // namespace
@@ -413,9 +431,11 @@ std::string assemblyForCPU(ExecutionEngineWrapper& execution_engine,
   return "Assembly for the CPU:\n" + std::string(code_str.str()) + "\nEnd of assembly";
 }
 
-ExecutionEngineWrapper create_execution_engine(llvm::Module* llvm_module,
-                                               llvm::EngineBuilder& eb,
-                                               const CompilationOptions& co) {
+ExecutionEngineWrapper create_execution_engine(
+    llvm::Module* llvm_module,
+    llvm::EngineBuilder& eb,
+    const CompilationOptions& co,
+    llvm::ObjectCache* object_cache = nullptr) {
   auto timer = DEBUG_TIMER(__func__);
   // Avoids data race in
   // llvm::sys::DynamicLibrary::getPermanentLibrary and
@@ -427,26 +447,115 @@ ExecutionEngineWrapper create_execution_engine(llvm::Module* llvm_module,
   CHECK(execution_engine.get());
   // Force the module data layout to match the layout for the selected target
   llvm_module->setDataLayout(execution_engine->getDataLayout());
+  if (object_cache) {
+    // MCJIT consults the object cache before running codegen for the module and
+    // notifies it of newly emitted objects. The cache is only used while finalizing.
+    execution_engine->setObjectCache(object_cache);
+  }
 
   LOG(ASM) << assemblyForCPU(execution_engine, llvm_module);
 
   execution_engine->finalizeObject();
+  if (object_cache) {
+    execution_engine->setObjectCache(nullptr);
+  }
   return execution_engine;
 }
 
+// Object code can be persisted across server restarts only if it does not embed
+// addresses of objects living in the current process, e.g. string dictionary proxies
+// referenced by non-hoisted literals. Such addresses show up in the IR as integer
+// constants cast to pointers.
+bool is_persistable_code(const CodeCacheKey& key) {
+  static const std::vector<std::string> patterns{"inttoptr (i64 ", "inttoptr i64 "};
+  for (const auto& ir : key) {
+    for (const auto& pattern : patterns) {
+      for (auto pos = ir.find(pattern); pos != std::string::npos;
+           pos = ir.find(pattern, pos + 1)) {
+        const auto operand_pos = pos + pattern.size();
+        if (operand_pos < ir.size() &&
+            (std::isdigit(ir[operand_pos]) || ir[operand_pos] == '-')) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+std::string serialize_module_to_bitcode(const llvm::Module& llvm_module) {
+  auto timer = DEBUG_TIMER(__func__);
+  llvm::SmallVector<char, 0> buffer;
+  llvm::raw_svector_ostream os(buffer);
+  llvm::WriteBitcodeToFile(llvm_module, os);
+  return std::string(buffer.data(), buffer.size());
+}
+
+// Optimized tier of tiered compilation, runs on the background thread of the tiered
+// compilation queue and replaces the unoptimized code in the code cache.
+void compile_optimized_cpu_code(const CodeCacheKey& key,
+                                const std::string& bitcode,
+                                const std::string& query_func_name,
+                                const std::string& multifrag_query_func_name,
+                                const std::vector<std::string>& live_func_names,
+                                const CompilationOptions& co,
+                                PersistentCodeCache::Entry* persistent_cache_entry) {
+  auto timer = DEBUG_TIMER(__func__);
+  auto llvm_context = std::make_unique<llvm::LLVMContext>();
+  auto module_or_err = llvm::parseBitcodeFile(
+      llvm::MemoryBufferRef(bitcode, "tiered_compilation_module"), *llvm_context);
+  if (!module_or_err) {
+    LOG(WARNING) << "Unable to parse the module for the optimized compilation: "
+                 << llvm::toString(module_or_err.takeError());
+    return;
+  }
+  auto llvm_module = std::move(module_or_err.get());
+  auto query_func = llvm_module->getFunction(query_func_name);
+  auto multifrag_query_func = llvm_module->getFunction(multifrag_query_func_name);
+  if (!query_func || !multifrag_query_func) {
+    // keep the unoptimized code rather than bringing the server down
+    LOG(WARNING) << "Unable to find the query functions in the module for the optimized "
+                    "compilation";
+    return;
+  }
+  std::unordered_set<llvm::Function*> live_funcs;
+  for (const auto& live_func_name : live_func_names) {
+    if (auto live_func = llvm_module->getFunction(live_func_name)) {
+      live_funcs.insert(live_func);
+    }
+  }
+  // the execution engine takes ownership of the module
+  llvm_module.release();
+  auto execution_engine = CodeGenerator::generateNativeCPUCode(
+      query_func, live_funcs, co, persistent_cache_entry);
+  auto cpu_compilation_context = std::make_shared<CpuCompilationContext>(
+      std::move(execution_engine), std::move(llvm_context));
+  cpu_compilation_context->setFunctionPointer(multifrag_query_func);
+  if (Executor::cpu_code_accessor.overwrite(key, cpu_compilation_context)) {
+    VLOG(1) << "Replaced unoptimized query code with its optimized version";
+  }
+}
+
 }  // namespace
 
 ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
     llvm::Function* func,
     const std::unordered_set<llvm::Function*>& live_funcs,
-    const CompilationOptions& co) {
+    const CompilationOptions& co,
+    PersistentCodeCache::Entry* persistent_cache_entry) {
   auto timer = DEBUG_TIMER(__func__);
   llvm::Module* llvm_module = func->getParent();
-  // run optimizations
+  // run optimizations, unless the optimized object code is already cached
 #ifndef WITH_JIT_DEBUG
-  llvm::legacy::PassManager pass_manager;
-  optimize_ir(
-      func, llvm_module, pass_manager, live_funcs, /*is_gpu_smem_used=*/false, co);
+  if (!persistent_cache_entry || !persistent_cache_entry->hasObject()) {
+    llvm::legacy::PassManager pass_manager;
+    if (co.opt_level == ExecutorOptLevel::Unoptimized) {
+      optimize_ir_minimal(llvm_module, pass_manager, live_funcs);
+    } else {
+      optimize_ir(
+          func, llvm_module, pass_manager, live_funcs, /*is_gpu_smem_used=*/false, co);
+    }
+  }
 #endif  // WITH_JIT_DEBUG
 
   auto init_err = llvm::InitializeNativeTarget();
@@ -464,11 +573,12 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
   llvm::TargetOptions to;
   to.EnableFastISel = true;
   eb.setTargetOptions(to);
-  if (co.opt_level == ExecutorOptLevel::ReductionJIT) {
+  if (co.opt_level == ExecutorOptLevel::ReductionJIT ||
+      co.opt_level == ExecutorOptLevel::Unoptimized) {
     eb.setOptLevel(llvm::CodeGenOpt::None);
   }
 
-  return create_execution_engine(llvm_module, eb, co);
+  return create_execution_engine(llvm_module, eb, co, persistent_cache_entry);
 }
 
 std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
@@ -482,10 +592,13 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
   llvm::Module* M = query_func->getParent();
   auto* flag = llvm::mdconst::extract_or_null<llvm::ConstantInt>(
       M->getModuleFlag("manage_memory_buffer"));
+  // the code is bound to this executor and cannot outlive the current process
+  bool executor_bound_code = false;
   if (flag and flag->getZExtValue() == 1 and M->getFunction("allocate_varlen_buffer") and
       M->getFunction("register_buffer_with_executor_rsm")) {
     LOG(INFO) << "including executor addr to cache key\n";
     key.push_back(std::to_string(reinterpret_cast<int64_t>(this)));
+    executor_bound_code = true;
   }
   if (cgen_state_->filter_func_) {
     key.push_back(serialize_llvm_object(cgen_state_->filter_func_));
@@ -494,6 +607,9 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
     key.push_back(serialize_llvm_object(helper));
   }
   auto cached_code = cpu_code_accessor.get_value(key);
+  if (execution_stats_) {
+    execution_stats_->addCodeCacheLookup(cached_code != nullptr);
+  }
   if (cached_code) {
     return cached_code;
   }
@@ -524,12 +640,77 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
 #endif
   }
 
-  auto execution_engine =
-      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+  // shared with the optimized compilation job of tiered compilation
+  std::shared_ptr<PersistentCodeCache::Entry> persistent_cache_entry;
+  // UDF bodies are not part of the key, so code linked against them is not persisted
+  if (g_enable_persistent_code_cache && !executor_bound_code &&
+      !cgen_state_->needs_geos_ && !has_udf_module() && !has_rt_udf_module() &&
+      is_persistable_code(key)) {
+    persistent_cache_entry = cpu_persistent_code_cache.lookup(
+        key, {std::to_string(static_cast<int>(co.opt_level))});
+  }
+
+  if (g_enable_tiered_compilation && co.opt_level == ExecutorOptLevel::Default &&
+      (!persistent_cache_entry || !persistent_cache_entry->hasObject())) {
+    // Start with unoptimized code and compile the optimized code in the background.
+    // The module is consumed by the code generation, so it is serialized beforehand
+    // and recompiled in its own LLVM context, as contexts are not thread-safe.
+    const auto bitcode = serialize_module_to_bitcode(*query_func->getParent());
+    std::vector<std::string> live_func_names;
+    for (const auto live_func : live_funcs) {
+      live_func_names.emplace_back(live_func->getName().str());
+    }
+    // the optimized code can only replace the unoptimized code once the latter is cached
+    std::promise<void> unoptimized_code_cached;
+    std::shared_future<void> unoptimized_code_cached_future =
+        unoptimized_code_cached.get_future().share();
+    const bool enqueued = tiered_compilation_queue.enqueue(
+        key,
+        [key,
+         bitcode,
+         query_func_name = query_func->getName().str(),
+         multifrag_query_func_name = multifrag_query_func->getName().str(),
+         live_func_names,
+         co,
+         persistent_cache_entry,
+         unoptimized_code_cached_future] {
+          unoptimized_code_cached_future.wait();
+          compile_optimized_cpu_code(key,
+                                     bitcode,
+                                     query_func_name,
+                                     multifrag_query_func_name,
+                                     live_func_names,
+                                     co,
+                                     persistent_cache_entry.get());
+        });
+    if (enqueued) {
+      ScopeGuard notify_optimized_compilation = [&unoptimized_code_cached] {
+        unoptimized_code_cached.set_value();
+      };
+      auto unoptimized_co = co;
+      unoptimized_co.opt_level = ExecutorOptLevel::Unoptimized;
+      auto execution_engine =
+          CodeGenerator::generateNativeCPUCode(query_func, live_funcs, unoptimized_co);
+      auto cpu_compilation_context =
+          std::make_shared<CpuCompilationContext>(std::move(execution_engine));
+      cpu_compilation_context->setFunctionPointer(multifrag_query_func);
+      cpu_code_accessor.put(key, cpu_compilation_context);
+      return std::dynamic_pointer_cast<CompilationContext>(cpu_compilation_context);
+    }
+    // the queue is full, stopped or already optimizing the same code
+    VLOG(1) << "Background compilation of optimized query code is not available, "
+               "compiling the optimized code synchronously";
+  }
+
+  auto execution_engine = CodeGenerator::generateNativeCPUCode(
+      query_func, live_funcs, co, persistent_cache_entry.get());
   auto cpu_compilation_context =
       std::make_shared<CpuCompilationContext>(std::move(execution_engine));
   cpu_compilation_context->setFunctionPointer(multifrag_query_func);
   cpu_code_accessor.put(key, cpu_compilation_context);
+  if (persistent_cache_entry) {
+    VLOG(1) << cpu_persistent_code_cache;
+  }
   return std::dynamic_pointer_cast<CompilationContext>(cpu_compilation_context);
 }
 
@@ -1344,6 +1525,9 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenGPU(
     key.push_back(serialize_llvm_object(helper));
   }
   auto cached_code = Executor::gpu_code_accessor.get_value(key);
+  if (execution_stats_) {
+    execution_stats_->addCodeCacheLookup(cached_code != nullptr);
+  }
   if (cached_code) {
     return cached_code;
   }
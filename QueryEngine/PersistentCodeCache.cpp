@@ -0,0 +1,358 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/PersistentCodeCache.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Host.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "Logger/Logger.h"
+#include "MapDRelease.h"
+#include "QueryEngine/MurmurHash.h"
+
+bool g_enable_persistent_code_cache{false};
+std::string g_persistent_code_cache_path;
+size_t g_persistent_code_cache_max_size_bytes{size_t(1) << 30};
+
+namespace {
+
+constexpr char kEntryMagic[] = "HDBJITC1";
+constexpr size_t kEntryMagicSize = sizeof(kEntryMagic) - 1;
+const std::string kEntryFileExtension{".o"};
+
+// Chains the hash over all the key parts, including their lengths so that
+// different splits of the same bytes do not collide.
+uint64_t hash_key_parts(const std::vector<const std::string*>& parts,
+                        const uint64_t seed) {
+  uint64_t hash = seed;
+  for (const auto part : parts) {
+    const uint64_t len = part->size();
+    hash = MurmurHash64A(&len, sizeof(len), hash);
+    hash = MurmurHash64A(part->data(), static_cast<int>(part->size()), hash);
+  }
+  return hash;
+}
+
+std::string to_hex(const uint64_t value) {
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0') << value;
+  return oss.str();
+}
+
+uint64_t object_checksum(const char* data, const size_t size) {
+  return MurmurHash64A(data, static_cast<int>(size), 0);
+}
+
+template <typename T>
+void write_pod(std::ostream& os, const T& value) {
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_pod(std::istream& is, T& value) {
+  is.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return is.good();
+}
+
+std::string unique_temp_suffix() {
+  static std::atomic<uint64_t> counter{0};
+  std::ostringstream oss;
+  oss << ".tmp." << std::this_thread::get_id() << "." << counter++;
+  return oss.str();
+}
+
+}  // namespace
+
+void PersistentCodeCache::Entry::notifyObjectCompiled(const llvm::Module* module,
+                                                      llvm::MemoryBufferRef obj) {
+  if (object_) {
+    // the object was loaded from the cache, nothing to persist
+    return;
+  }
+  cache_->writeEntry(file_name_, key_digest_, obj);
+}
+
+std::unique_ptr<llvm::MemoryBuffer> PersistentCodeCache::Entry::getObject(
+    const llvm::Module* module) {
+  if (!object_) {
+    return nullptr;
+  }
+  // MCJIT takes ownership of the returned buffer
+  return llvm::MemoryBuffer::getMemBufferCopy(object_->getBuffer(),
+                                              object_->getBufferIdentifier());
+}
+
+const std::string& PersistentCodeCache::getFingerprint() {
+  static const std::string fingerprint = [] {
+    std::ostringstream oss;
+    oss << "release=" << MAPD_RELEASE << ";llvm=" << LLVM_VERSION_STRING
+        << ";triple=" << llvm::sys::getProcessTriple()
+        << ";cpu=" << llvm::sys::getHostCPUName().str() << ";features=";
+    llvm::StringMap<bool> host_features;
+    if (llvm::sys::getHostCPUFeatures(host_features)) {
+      std::vector<std::string> enabled_features;
+      for (const auto& feature : host_features) {
+        if (feature.getValue()) {
+          enabled_features.emplace_back(feature.getKey().str());
+        }
+      }
+      std::sort(enabled_features.begin(), enabled_features.end());
+      for (const auto& feature : enabled_features) {
+        oss << "+" << feature;
+      }
+    }
+    return oss.str();
+  }();
+  return fingerprint;
+}
+
+bool PersistentCodeCache::initializeDirectory() {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (initialized_ && directory_ == g_persistent_code_cache_path) {
+    return true;
+  }
+  if (g_persistent_code_cache_path.empty()) {
+    return false;
+  }
+  try {
+    boost::filesystem::path path(g_persistent_code_cache_path);
+    if (!boost::filesystem::exists(path)) {
+      boost::filesystem::create_directories(path);
+    }
+    if (!boost::filesystem::is_directory(path)) {
+      LOG(ERROR) << "Persistent code cache path " << path
+                 << " is not a directory, disabling the persistent code cache.";
+      g_enable_persistent_code_cache = false;
+      return false;
+    }
+    total_size_bytes_ = 0;
+    for (const auto& file : boost::filesystem::directory_iterator(path)) {
+      if (boost::filesystem::is_regular_file(file.path()) &&
+          file.path().extension() == kEntryFileExtension) {
+        total_size_bytes_ += boost::filesystem::file_size(file.path());
+      }
+    }
+  } catch (const boost::filesystem::filesystem_error& e) {
+    LOG(ERROR) << "Unable to initialize the persistent code cache at "
+               << g_persistent_code_cache_path << ": " << e.what()
+               << ". Disabling the persistent code cache.";
+    g_enable_persistent_code_cache = false;
+    return false;
+  }
+  directory_ = g_persistent_code_cache_path;
+  initialized_ = true;
+  LOG(INFO) << "Persistent code cache initialized at " << directory_ << " ("
+            << total_size_bytes_ << " bytes in use)";
+  return true;
+}
+
+std::unique_ptr<PersistentCodeCache::Entry> PersistentCodeCache::lookup(
+    const CodeCacheKey& key,
+    const std::vector<std::string>& extra_key_parts) {
+  if (!g_enable_persistent_code_cache || !initializeDirectory()) {
+    return nullptr;
+  }
+  std::vector<const std::string*> parts{&getFingerprint()};
+  for (const auto& part : key) {
+    parts.push_back(&part);
+  }
+  for (const auto& part : extra_key_parts) {
+    parts.push_back(&part);
+  }
+  const auto key_digest = to_hex(hash_key_parts(parts, 0x9e3779b97f4a7c15ULL)) +
+                          to_hex(hash_key_parts(parts, 0xc2b2ae3d27d4eb4fULL));
+  auto file_name = key_digest + kEntryFileExtension;
+  auto object = readEntry(file_name, key_digest);
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (object) {
+      hit_count_++;
+    } else {
+      miss_count_++;
+    }
+  }
+  return std::unique_ptr<Entry>(
+      new Entry(this, std::move(file_name), key_digest, std::move(object)));
+}
+
+std::unique_ptr<llvm::MemoryBuffer> PersistentCodeCache::readEntry(
+    const std::string& file_name,
+    const std::string& key_digest) {
+  const auto file_path = boost::filesystem::path(directory_) / file_name;
+  std::ifstream in(file_path.string(), std::ios::binary);
+  if (!in) {
+    return nullptr;
+  }
+  auto invalidate = [&](const std::string& reason) {
+    LOG(WARNING) << "Dropping invalid persistent code cache entry " << file_path << ": "
+                 << reason;
+    in.close();
+    boost::system::error_code ec;
+    const auto file_size = boost::filesystem::file_size(file_path, ec);
+    boost::filesystem::remove(file_path, ec);
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    invalid_count_++;
+    if (!ec) {
+      total_size_bytes_ -= std::min(total_size_bytes_, static_cast<size_t>(file_size));
+    }
+    return nullptr;
+  };
+
+  char magic[kEntryMagicSize];
+  in.read(magic, kEntryMagicSize);
+  if (!in.good() || std::string(magic, kEntryMagicSize) != kEntryMagic) {
+    return invalidate("bad magic");
+  }
+  uint32_t fingerprint_size{0};
+  if (!read_pod(in, fingerprint_size) || fingerprint_size > (1 << 16)) {
+    return invalidate("bad fingerprint");
+  }
+  std::string fingerprint(fingerprint_size, '\0');
+  in.read(fingerprint.data(), fingerprint_size);
+  if (!in.good() || fingerprint != getFingerprint()) {
+    return invalidate("fingerprint mismatch");
+  }
+  std::string stored_key_digest(key_digest.size(), '\0');
+  in.read(stored_key_digest.data(), stored_key_digest.size());
+  if (!in.good() || stored_key_digest != key_digest) {
+    return invalidate("key mismatch");
+  }
+  uint64_t object_size{0};
+  uint64_t checksum{0};
+  if (!read_pod(in, object_size) || !read_pod(in, checksum) ||
+      object_size > g_persistent_code_cache_max_size_bytes) {
+    return invalidate("bad object header");
+  }
+  auto object =
+      llvm::WritableMemoryBuffer::getNewUninitMemBuffer(object_size, file_path.string());
+  if (!object) {
+    return nullptr;
+  }
+  in.read(object->getBufferStart(), object_size);
+  if (in.gcount() != static_cast<std::streamsize>(object_size) ||
+      object_checksum(object->getBufferStart(), object_size) != checksum) {
+    return invalidate("checksum mismatch");
+  }
+  VLOG(1) << "Loaded " << object_size << " bytes of object code from persistent code "
+          << "cache entry " << file_path;
+  return object;
+}
+
+void PersistentCodeCache::writeEntry(const std::string& file_name,
+                                     const std::string& key_digest,
+                                     llvm::MemoryBufferRef obj) {
+  const auto& fingerprint = getFingerprint();
+  const size_t entry_size = kEntryMagicSize + sizeof(uint32_t) + fingerprint.size() +
+                            key_digest.size() + 2 * sizeof(uint64_t) +
+                            obj.getBufferSize();
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    if (total_size_bytes_ + entry_size > g_persistent_code_cache_max_size_bytes) {
+      reject_count_++;
+      VLOG(1) << "Persistent code cache is full, not storing " << file_name;
+      return;
+    }
+    // reserve the space up front so that concurrent writers respect the limit
+    total_size_bytes_ += entry_size;
+  }
+  const auto file_path = boost::filesystem::path(directory_) / file_name;
+  const auto temp_path = file_path.string() + unique_temp_suffix();
+  bool success{false};
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (out) {
+      out.write(kEntryMagic, kEntryMagicSize);
+      write_pod(out, static_cast<uint32_t>(fingerprint.size()));
+      out.write(fingerprint.data(), fingerprint.size());
+      out.write(key_digest.data(), key_digest.size());
+      write_pod(out, static_cast<uint64_t>(obj.getBufferSize()));
+      write_pod(out,
+                object_checksum(obj.getBufferStart(), obj.getBufferSize()));
+      out.write(obj.getBufferStart(), obj.getBufferSize());
+      out.flush();
+      success = out.good();
+    }
+  }
+  boost::system::error_code ec;
+  if (success) {
+    // rename is atomic, so readers never observe a partially written entry
+    boost::filesystem::rename(temp_path, file_path, ec);
+    success = !ec;
+  }
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (success) {
+    store_count_++;
+  } else {
+    boost::filesystem::remove(temp_path, ec);
+    total_size_bytes_ -= std::min(total_size_bytes_, entry_size);
+    LOG(WARNING) << "Unable to write persistent code cache entry " << file_path;
+  }
+}
+
+void PersistentCodeCache::clear() {
+  if (!initializeDirectory()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  boost::system::error_code ec;
+  for (const auto& file : boost::filesystem::directory_iterator(directory_, ec)) {
+    if (file.path().extension() == kEntryFileExtension) {
+      boost::filesystem::remove(file.path(), ec);
+    }
+  }
+  total_size_bytes_ = 0;
+  hit_count_ = miss_count_ = store_count_ = invalid_count_ = reject_count_ = 0;
+}
+
+size_t PersistentCodeCache::getHitCount() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return hit_count_;
+}
+
+size_t PersistentCodeCache::getMissCount() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return miss_count_;
+}
+
+size_t PersistentCodeCache::getStoreCount() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return store_count_;
+}
+
+size_t PersistentCodeCache::getInvalidCount() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return invalid_count_;
+}
+
+std::ostream& operator<<(std::ostream& os, PersistentCodeCache& c) {
+  std::lock_guard<std::mutex> lock(c.cache_mutex_);
+  os << "PersistentCodeCache<" << c.name_ << ">[path=" << c.directory_
+     << ", size in bytes=" << c.total_size_bytes_
+     << ", total hit/miss count=" << c.hit_count_ << "/" << c.miss_count_
+     << ", total store/reject/invalid count=" << c.store_count_ << "/"
+     << c.reject_count_ << "/" << c.invalid_count_ << "]";
+  return os;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    PersistentCodeCache.h
+ * @brief   On-disk cache of compiled CPU object code, shared across server restarts.
+ *
+ * Entries are keyed on a digest of the in-memory code cache key combined with a
+ * fingerprint of the build, LLVM version and host CPU. An entry is read and validated
+ * only when it is looked up; invalid entries are dropped and recompiled.
+ */
+
+#pragma once
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "QueryEngine/CodeCache.h"
+
+extern bool g_enable_persistent_code_cache;
+extern std::string g_persistent_code_cache_path;
+extern size_t g_persistent_code_cache_max_size_bytes;
+
+class PersistentCodeCache {
+ public:
+  // A single lookup of the persistent cache, plugged into MCJIT as its object cache.
+  // If a valid object was found on disk MCJIT loads it instead of running codegen,
+  // otherwise the object emitted by MCJIT is written back to the cache directory.
+  class Entry : public llvm::ObjectCache {
+   public:
+    bool hasObject() const { return object_ != nullptr; }
+
+    void notifyObjectCompiled(const llvm::Module* module,
+                              llvm::MemoryBufferRef obj) override;
+
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+   private:
+    Entry(PersistentCodeCache* cache,
+          std::string file_name,
+          std::string key_digest,
+          std::unique_ptr<llvm::MemoryBuffer> object)
+        : cache_(cache)
+        , file_name_(std::move(file_name))
+        , key_digest_(std::move(key_digest))
+        , object_(std::move(object)) {}
+
+    PersistentCodeCache* cache_;
+    const std::string file_name_;
+    const std::string key_digest_;
+    std::unique_ptr<llvm::MemoryBuffer> object_;
+
+    friend class PersistentCodeCache;
+  };
+
+  PersistentCodeCache(std::string name) : name_(std::move(name)) {}
+
+  // Returns nullptr if the persistent cache is disabled or unusable. The extra key
+  // parts are mixed into the digest, e.g. to distinguish codegen options.
+  std::unique_ptr<Entry> lookup(const CodeCacheKey& key,
+                                const std::vector<std::string>& extra_key_parts = {});
+
+  // Removes every entry from the cache directory and resets the statistics.
+  void clear();
+
+  // Fingerprint of the code generation environment. Objects compiled in a different
+  // environment are never loaded.
+  static const std::string& getFingerprint();
+
+  size_t getHitCount() const;
+  size_t getMissCount() const;
+  size_t getStoreCount() const;
+  size_t getInvalidCount() const;
+
+  friend std::ostream& operator<<(std::ostream& os, PersistentCodeCache& c);
+
+ private:
+  bool initializeDirectory();
+  std::unique_ptr<llvm::MemoryBuffer> readEntry(const std::string& file_path,
+                                                const std::string& key_digest);
+  void writeEntry(const std::string& file_name,
+                  const std::string& key_digest,
+                  llvm::MemoryBufferRef obj);
+
+  const std::string name_;
+  std::string directory_;
+  bool initialized_{false};
+  size_t total_size_bytes_{0};
+  // cumulative statistics of persistent code cache usage
+  size_t hit_count_{0}, miss_count_{0}, store_count_{0}, invalid_count_{0},
+      reject_count_{0};
+  mutable std::mutex cache_mutex_;
+};
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/QueryExecutionStats.h"
+
+#include <algorithm>
+#include <sstream>
+
+void QueryExecutionStats::beginStep(const size_t step_idx,
+                                    const std::string& description) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = std::find_if(steps_.begin(), steps_.end(), [step_idx](const auto& step) {
+    return step.step_idx == step_idx;
+  });
+  if (it == steps_.end()) {
+    it = steps_.emplace(steps_.end());
+  }
+  *it = StepStats{};
+  it->step_idx = step_idx;
+  it->description = description;
+  current_step_ = std::distance(steps_.begin(), it);
+}
+
+void QueryExecutionStats::endStep(const int64_t wall_time_ms,
+                                  const std::optional<size_t> rows_out) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!current_step_) {
+    return;
+  }
+  auto& step = steps_[*current_step_];
+  step.wall_time_ms = wall_time_ms;
+  step.rows_out = rows_out.value_or(0);
+  current_step_ = std::nullopt;
+}
+
+void QueryExecutionStats::addKernel(const size_t rows_in, const int64_t time_ms) {
+  updateCurrentStep([rows_in, time_ms](StepStats& step) {
+    ++step.kernels;
+    step.rows_in += rows_in;
+    step.kernel_time_ms += time_ms;
+  });
+}
+
+void QueryExecutionStats::addFragments(const size_t scanned, const size_t skipped) {
+  updateCurrentStep([scanned, skipped](StepStats& step) {
+    step.fragments_scanned += scanned;
+    step.fragments_skipped += skipped;
+  });
+}
+
+void QueryExecutionStats::addFetchedBytes(const Data_Namespace::MemoryLevel memory_level,
+                                          const size_t num_bytes) {
+  updateCurrentStep([memory_level, num_bytes](StepStats& step) {
+    step.bytes_fetched[memory_level] += num_bytes;
+  });
+}
+
+void QueryExecutionStats::addHashTable(const int64_t build_time_ms,
+                                       const size_t num_bytes) {
+  updateCurrentStep([build_time_ms, num_bytes](StepStats& step) {
+    ++step.hash_tables_built;
+    step.hash_table_build_time_ms += build_time_ms;
+    step.hash_table_bytes += num_bytes;
+  });
+}
+
+void QueryExecutionStats::addCompilation(const int64_t time_ms) {
+  updateCurrentStep([time_ms](StepStats& step) { step.compilation_time_ms += time_ms; });
+}
+
+void QueryExecutionStats::addCodeCacheLookup(const bool hit) {
+  updateCurrentStep([hit](StepStats& step) {
+    if (hit) {
+      ++step.code_cache_hits;
+    } else {
+      ++step.code_cache_misses;
+    }
+  });
+}
+
+void QueryExecutionStats::addReduction(const int64_t time_ms) {
+  updateCurrentStep([time_ms](StepStats& step) { step.reduction_time_ms += time_ms; });
+}
+
+std::vector<QueryExecutionStats::StepStats> QueryExecutionStats::getSteps() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return steps_;
+}
+
+std::string QueryExecutionStats::toString() const {
+  auto steps = getSteps();
+  std::sort(steps.begin(), steps.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.step_idx < rhs.step_idx;
+  });
+  std::ostringstream oss;
+  for (const auto& step : steps) {
+    oss << step.step_idx + 1 << " : " << step.description << "\n";
+    oss << "    time: " << step.wall_time_ms << " ms, rows in: " << step.rows_in
+        << ", rows out: " << step.rows_out << "\n";
+    oss << "    kernels: " << step.kernels << " (" << step.kernel_time_ms
+        << " ms), fragments scanned: " << step.fragments_scanned
+        << ", skipped: " << step.fragments_skipped << "\n";
+    oss << "    bytes fetched: CPU "
+        << step.bytes_fetched[Data_Namespace::MemoryLevel::CPU_LEVEL] << ", GPU "
+        << step.bytes_fetched[Data_Namespace::MemoryLevel::GPU_LEVEL] << "\n";
+    if (step.hash_tables_built) {
+      oss << "    hash tables: " << step.hash_tables_built << " built in "
+          << step.hash_table_build_time_ms << " ms, " << step.hash_table_bytes
+          << " bytes\n";
+    }
+    oss << "    compilation: " << step.compilation_time_ms
+        << " ms, code cache hits: " << step.code_cache_hits
+        << ", misses: " << step.code_cache_misses << "\n";
+    oss << "    reduction: " << step.reduction_time_ms << " ms\n";
+  }
+  return oss.str();
+}
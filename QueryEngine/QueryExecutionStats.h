@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    QueryExecutionStats.h
+ * @brief   Runtime statistics of the steps of a query, reported by EXPLAIN ANALYZE.
+ *
+ * The RelAlgExecutor opens a step before executing each step of its execution sequence
+ * and closes it afterwards. While a step is open, the executor, its kernels and the
+ * column fetcher add their counters to it. Counters reported while no step is open,
+ * e.g. by subqueries, are dropped.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "DataMgr/MemoryLevel.h"
+
+class QueryExecutionStats {
+ public:
+  struct StepStats {
+    size_t step_idx{0};
+    std::string description;
+    int64_t wall_time_ms{0};
+    size_t rows_in{0};
+    size_t rows_out{0};
+    size_t kernels{0};
+    int64_t kernel_time_ms{0};
+    size_t fragments_scanned{0};
+    size_t fragments_skipped{0};
+    // Indexed by Data_Namespace::MemoryLevel.
+    std::array<size_t, Data_Namespace::MemoryLevel::GPU_LEVEL + 1> bytes_fetched{};
+    size_t hash_tables_built{0};
+    int64_t hash_table_build_time_ms{0};
+    size_t hash_table_bytes{0};
+    int64_t compilation_time_ms{0};
+    size_t code_cache_hits{0};
+    size_t code_cache_misses{0};
+    int64_t reduction_time_ms{0};
+  };
+
+  // Opens the given step, resetting its statistics if the step is retried.
+  void beginStep(const size_t step_idx, const std::string& description);
+
+  void endStep(const int64_t wall_time_ms, const std::optional<size_t> rows_out);
+
+  void addKernel(const size_t rows_in, const int64_t time_ms);
+
+  void addFragments(const size_t scanned, const size_t skipped);
+
+  void addFetchedBytes(const Data_Namespace::MemoryLevel memory_level,
+                       const size_t num_bytes);
+
+  void addHashTable(const int64_t build_time_ms, const size_t num_bytes);
+
+  void addCompilation(const int64_t time_ms);
+
+  void addCodeCacheLookup(const bool hit);
+
+  void addReduction(const int64_t time_ms);
+
+  std::vector<StepStats> getSteps() const;
+
+  // One line per step with the plan of the step, followed by its statistics.
+  std::string toString() const;
+
+ private:
+  template <typename F>
+  void updateCurrentStep(F&& update) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (current_step_) {
+      update(steps_[*current_step_]);
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::vector<StepStats> steps_;
+  std::optional<size_t> current_step_;
+};
@@ -265,8 +265,11 @@ QueryMemoryInitializer::QueryMemoryInitializer(
                                        query_mem_desc.hasKeylessHash()
                                    ? query_mem_desc.getEntryCount()
                                    : size_t(0);
+  const auto hot_group_cache_qw = query_mem_desc.hasHotGroupCache(device_type)
+                                      ? size_t(HOT_GROUP_CACHE_QW)
+                                      : size_t(0);
   const auto actual_group_buffer_size =
-      group_buffer_size + index_buffer_qw * sizeof(int64_t);
+      group_buffer_size + (index_buffer_qw + hot_group_cache_qw) * sizeof(int64_t);
   CHECK_GE(actual_group_buffer_size, group_buffer_size);
 
   if (query_mem_desc.hasVarlenOutput()) {
@@ -297,6 +300,12 @@ QueryMemoryInitializer::QueryMemoryInitializer(
                           executor);
       }
     }
+    if (hot_group_cache_qw) {
+      memset(reinterpret_cast<int8_t*>(group_by_buffer + index_buffer_qw) +
+                 group_buffer_size,
+             0,
+             hot_group_cache_qw * sizeof(int64_t));
+    }
     group_by_buffers_.push_back(group_by_buffer);
     for (size_t j = 1; j < step; ++j) {
       group_by_buffers_.push_back(nullptr);
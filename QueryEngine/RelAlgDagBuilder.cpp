@@ -35,6 +35,7 @@
 
 extern bool g_cluster;
 extern bool g_enable_union;
+extern bool g_enable_query_step_fusion;
 
 namespace {
 
@@ -3144,6 +3145,9 @@ void RelAlgDagBuilder::build(const rapidjson::Value& query_ast,
   simplify_sort(nodes_);
   sink_projected_boolean_expr_to_join(nodes_);
   eliminate_identical_copy(nodes_);
+  if (g_enable_query_step_fusion) {
+    fuse_projects_into_consumers(nodes_);
+  }
   fold_filters(nodes_);
   std::vector<const RelAlgNode*> filtered_left_deep_joins;
   std::vector<const RelAlgNode*> left_deep_joins;
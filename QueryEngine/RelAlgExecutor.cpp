@@ -38,6 +38,7 @@
 #include "QueryEngine/ResultSetBuilder.h"
 #include "QueryEngine/RexVisitor.h"
 #include "QueryEngine/TableOptimizer.h"
+#include "QueryEngine/Visitors/RexSubQueryIdCollector.h"
 #include "QueryEngine/WindowContext.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/measure.h"
@@ -48,15 +49,24 @@
 #include <boost/range/adaptor/reversed.hpp>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <future>
+#include <list>
+#include <mutex>
 #include <numeric>
 
 bool g_skip_intermediate_count{true};
 bool g_enable_interop{false};
+size_t g_max_external_execution_input_rows{0};
 bool g_enable_union{true};  // DEPRECATED
 size_t g_estimator_failure_max_groupby_size{256000000};
 bool g_columnar_large_projections{true};
 size_t g_columnar_large_projections_threshold{1000000};
+size_t g_max_parallel_query_steps{1};
+size_t g_parallel_query_steps_memory_budget{size_t(4) << 30};
 
 extern bool g_enable_watchdog;
 extern size_t g_watchdog_none_encoded_string_translation_limit;
@@ -72,6 +82,35 @@ bool node_is_aggregate(const RelAlgNode* ra) {
   return ((compound && compound->isAggregate()) || aggregate);
 }
 
+// Sum of the number of rows of the tables and of the results of the previous steps that
+// a node reads, including through the nodes folded into its step.
+size_t get_input_row_count_upper_bound(const RelAlgNode* ra,
+                                       const TemporaryTables& temp_tables) {
+  size_t input_rows{0};
+  std::vector<const RelAlgNode*> nodes{ra};
+  while (!nodes.empty()) {
+    const auto node = nodes.back();
+    nodes.pop_back();
+    for (size_t i = 0; i < node->inputCount(); ++i) {
+      const auto input = node->getInput(i);
+      if (const auto scan = dynamic_cast<const RelScan*>(input)) {
+        const auto td = scan->getTableDescriptor();
+        if (td && td->fragmenter) {
+          input_rows += td->fragmenter->getFragmentsForQuery().getNumTuplesUpperBound();
+        }
+        continue;
+      }
+      const auto it = temp_tables.find(-static_cast<int>(input->getId()));
+      if (it != temp_tables.end()) {
+        input_rows += it->second->rowCount();
+      } else {
+        nodes.push_back(input);
+      }
+    }
+  }
+  return input_rows;
+}
+
 std::unordered_set<PhysicalInput> get_physical_inputs(
     const Catalog_Namespace::Catalog& cat,
     const RelAlgNode* ra) {
@@ -657,6 +696,9 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
   timer_setup.stop();
 
   // Dispatch the subqueries first
+  if (canExecuteConcurrently(eo, render_info)) {
+    executeSubqueriesConcurrently(co, eo);
+  }
   for (auto subquery : getSubqueries()) {
     const auto subquery_ra = subquery->getRelAlg();
     CHECK(subquery_ra);
@@ -669,6 +711,12 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
     auto result = ra_executor.executeRelAlgSeq(subquery_seq, co, eo, nullptr, 0);
     subquery->setExecutionResult(std::make_shared<ExecutionResult>(result));
   }
+  if (execution_stats_) {
+    executor_->setExecutionStats(execution_stats_.get());
+    ScopeGuard reset_execution_stats = [this] { executor_->setExecutionStats(nullptr); };
+    executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
+    return {std::make_shared<ResultSet>(execution_stats_->toString()), {}};
+  }
   return executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
 }
 
@@ -870,6 +918,10 @@ ExecutionResult RelAlgExecutor::executeRelAlgSeq(const RaExecutionSequence& seq,
   }
 
   const auto num_steps = exec_desc_count - 1;
+  if (canExecuteStepsConcurrently(seq, exec_desc_count, eo_copied, render_info)) {
+    executeRelAlgStepsConcurrently(seq, exec_desc_count, co, eo_copied, queue_time_ms);
+    return seq.getDescriptor(num_steps)->getResult();
+  }
   for (size_t i = 0; i < exec_desc_count; i++) {
     VLOG(1) << "Executing query step " << i << " / " << num_steps;
     try {
@@ -895,19 +947,20 @@ ExecutionResult RelAlgExecutor::executeRelAlgSeq(const RaExecutionSequence& seq,
                         eo_copied,
                         (i == num_steps) ? render_info : nullptr,
                         queue_time_ms);
-    } catch (const NativeExecutionError&) {
-      if (!g_enable_interop) {
-        throw;
-      }
+    } catch (const NativeExecutionError& e) {
       auto eo_extern = eo_copied;
       eo_extern.executor_type = ::ExecutorType::Extern;
       auto exec_desc_ptr = seq.getDescriptor(i);
       const auto body = exec_desc_ptr->getBody();
+      const auto input_rows = get_input_row_count_upper_bound(body, temporary_tables_);
       const auto compound = dynamic_cast<const RelCompound*>(body);
-      if (compound && (compound->getGroupByCount() || compound->isAggregate())) {
-        LOG(INFO) << "Also failed to run the query using interoperability";
-        throw;
-      }
+      check_external_execution_fallback(
+          e,
+          input_rows,
+          compound && (compound->getGroupByCount() || compound->isAggregate()));
+      LOG(INFO) << "Query step " << i << " / " << num_steps
+                << " cannot be executed natively (" << e.what() << "), executing its "
+                << input_rows << " input rows through the external executor";
       executeRelAlgStep(
           seq, i, co, eo_extern, (i == num_steps) ? render_info : nullptr, queue_time_ms);
     }
@@ -962,6 +1015,344 @@ ExecutionResult RelAlgExecutor::executeRelAlgSubSeq(
   return seq.getDescriptor(interval.second - 1)->getResult();
 }
 
+namespace {
+
+// Executors running query steps concurrently with the steps of a query are cached under
+// ids above the ones of the query dispatch queue, kMaxConcurrentQuerySteps of them per
+// executor running queries.
+constexpr size_t kMaxConcurrentQuerySteps{1024};
+constexpr Executor::ExecutorId kConcurrentStepExecutorIdBase{size_t(1) << 20};
+
+bool is_concurrent_step_supported(const RelAlgNode* body) {
+  return dynamic_cast<const RelCompound*>(body) ||
+         dynamic_cast<const RelProject*>(body) ||
+         dynamic_cast<const RelAggregate*>(body) ||
+         dynamic_cast<const RelFilter*>(body) || dynamic_cast<const RelSort*>(body) ||
+         dynamic_cast<const RelLogicalUnion*>(body) ||
+         dynamic_cast<const RelLogicalValues*>(body);
+}
+
+// Returns the steps whose results each of the first step_count steps of the sequence
+// reads. The nodes folded into a step, e.g. its joins or the input of a sort, are
+// searched for the inputs of the step.
+std::vector<std::vector<size_t>> get_step_dependencies(const RaExecutionSequence& seq,
+                                                       const size_t step_count) {
+  std::unordered_map<const RelAlgNode*, size_t> step_of_body;
+  for (size_t i = 0; i < step_count; ++i) {
+    step_of_body.emplace(seq.getDescriptor(i)->getBody(), i);
+  }
+  std::vector<std::vector<size_t>> dependencies(step_count);
+  for (size_t i = 0; i < step_count; ++i) {
+    std::vector<const RelAlgNode*> nodes{seq.getDescriptor(i)->getBody()};
+    std::unordered_set<const RelAlgNode*> visited;
+    while (!nodes.empty()) {
+      const auto node = nodes.back();
+      nodes.pop_back();
+      for (size_t j = 0; j < node->inputCount(); ++j) {
+        const auto input = node->getInput(j);
+        if (!visited.insert(input).second || dynamic_cast<const RelScan*>(input)) {
+          continue;
+        }
+        const auto it = step_of_body.find(input);
+        if (it != step_of_body.end()) {
+          dependencies[i].push_back(it->second);
+        } else {
+          nodes.push_back(input);
+        }
+      }
+    }
+  }
+  return dependencies;
+}
+
+// Upper bound of the number of rows a node reads from its inputs times its number of
+// columns, both known before the node is executed.
+size_t estimate_result_bytes(const RelAlgNode* ra, const TemporaryTables& temp_tables) {
+  return std::max(get_input_row_count_upper_bound(ra, temp_tables), size_t(1)) *
+         std::max(ra->size(), size_t(1)) * sizeof(int64_t);
+}
+
+}  // namespace
+
+bool RelAlgExecutor::canExecuteConcurrently(const ExecutionOptions& eo,
+                                            RenderInfo* render_info) const {
+  return g_max_parallel_query_steps > 1 && !g_cluster && !g_enable_interop &&
+         !render_info && !execution_stats_ && !eo.just_explain && !eo.just_validate &&
+         !eo.just_calcite_explain && !eo.find_push_down_candidates &&
+         eo.executor_type == ::ExecutorType::Native;
+}
+
+bool RelAlgExecutor::canExecuteStepsConcurrently(const RaExecutionSequence& seq,
+                                                 const size_t step_count,
+                                                 const ExecutionOptions& eo,
+                                                 RenderInfo* render_info) const {
+  if (step_count < 2 || !canExecuteConcurrently(eo, render_info)) {
+    return false;
+  }
+  // the steps executed concurrently do not see the query hints, which are registered
+  // in the query DAG of this executor only
+  if (!query_dag_ || !query_dag_->getQueryHints().empty() ||
+      query_dag_->getGlobalHints().isAnyQueryHintDelivered()) {
+    return false;
+  }
+  for (size_t i = 0; i < step_count; ++i) {
+    if (!is_concurrent_step_supported(seq.getDescriptor(i)->getBody())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void RelAlgExecutor::executeRelAlgStepsConcurrently(const RaExecutionSequence& seq,
+                                                    const size_t step_count,
+                                                    const CompilationOptions& co,
+                                                    const ExecutionOptions& eo,
+                                                    const int64_t queue_time_ms) {
+  auto eo_helper = eo;
+  // the runtime interrupt is tracked for the executor the query session is attached to
+  eo_helper.allow_runtime_query_interrupt = false;
+  auto execute_step = [this, &seq, &co, &eo, &eo_helper, queue_time_ms](
+                          RelAlgExecutor& ra_executor, const size_t step_idx) {
+    const auto& step_eo = &ra_executor == this ? eo : eo_helper;
+    try {
+      ra_executor.executeRelAlgStep(seq, step_idx, co, step_eo, nullptr, queue_time_ms);
+    } catch (const QueryMustRunOnCpu&) {
+      CHECK(co.device_type == ExecutorDeviceType::GPU);
+      if (!g_allow_query_step_cpu_retry) {
+        throw;
+      }
+      LOG(INFO) << "Retrying query step " << step_idx << " on CPU";
+      ra_executor.executeRelAlgStep(seq,
+                                    step_idx,
+                                    CompilationOptions::makeCpuOnly(co),
+                                    step_eo,
+                                    nullptr,
+                                    queue_time_ms);
+    }
+  };
+  executeConcurrently(
+      get_step_dependencies(seq, step_count),
+      [this, &seq](const size_t step_idx) {
+        return estimate_result_bytes(seq.getDescriptor(step_idx)->getBody(),
+                                     temporary_tables_);
+      },
+      execute_step,
+      true);
+}
+
+void RelAlgExecutor::executeSubqueriesConcurrently(const CompilationOptions& co,
+                                                   const ExecutionOptions& eo) {
+  // a subquery with nested subqueries needs their results first, it is left to the
+  // serial dispatch which follows
+  std::vector<std::shared_ptr<RexSubQuery>> subqueries;
+  std::unordered_set<const RelAlgNode*> subquery_ras;
+  for (const auto& subquery : getSubqueries()) {
+    const auto subquery_ra = subquery->getRelAlg();
+    CHECK(subquery_ra);
+    if (subquery_ra->hasContextData() || !subquery_ras.insert(subquery_ra).second ||
+        !RexSubQueryIdCollector::getLiveRexSubQueryIds(subquery_ra).empty()) {
+      continue;
+    }
+    subqueries.push_back(subquery);
+  }
+  if (subqueries.size() < 2) {
+    return;
+  }
+  std::vector<std::unique_ptr<RaExecutionSequence>> subquery_seqs;
+  for (const auto& subquery : subqueries) {
+    subquery_seqs.push_back(
+        std::make_unique<RaExecutionSequence>(subquery->getRelAlg(), executor_));
+  }
+  auto eo_helper = eo;
+  eo_helper.allow_runtime_query_interrupt = false;
+  executeConcurrently(
+      std::vector<std::vector<size_t>>(subqueries.size()),
+      [this, &subqueries](const size_t subquery_idx) {
+        return estimate_result_bytes(subqueries[subquery_idx]->getRelAlg(),
+                                     temporary_tables_);
+      },
+      [&subqueries, &subquery_seqs, &co, &eo_helper](RelAlgExecutor& ra_executor,
+                                                      const size_t subquery_idx) {
+        auto result = ra_executor.executeRelAlgSeq(
+            *subquery_seqs[subquery_idx], co, eo_helper, nullptr, 0);
+        subqueries[subquery_idx]->setExecutionResult(
+            std::make_shared<ExecutionResult>(result));
+      },
+      false);
+}
+
+void RelAlgExecutor::executeConcurrently(
+    const std::vector<std::vector<size_t>>& dependencies,
+    const std::function<size_t(const size_t)>& estimate_task_result_bytes,
+    const std::function<void(RelAlgExecutor&, const size_t)>& execute_task,
+    const bool tasks_are_steps) {
+  const auto task_count = dependencies.size();
+  const auto max_running_tasks = std::min(
+      {g_max_parallel_query_steps, size_t(cpu_threads()), kMaxConcurrentQuerySteps});
+  std::vector<size_t> pending_dependency_count(task_count);
+  std::vector<std::vector<size_t>> dependents(task_count);
+  std::deque<size_t> ready_tasks;
+  for (size_t i = 0; i < task_count; ++i) {
+    pending_dependency_count[i] = dependencies[i].size();
+    for (const auto dependency : dependencies[i]) {
+      CHECK_LT(dependency, i);
+      dependents[dependency].push_back(i);
+    }
+    if (!pending_dependency_count[i]) {
+      ready_tasks.push_back(i);
+    }
+  }
+  size_t completed_tasks{0};
+  auto complete_task = [&](const size_t task_idx) {
+    ++completed_tasks;
+    for (const auto dependent : dependents[task_idx]) {
+      if (!--pending_dependency_count[dependent]) {
+        ready_tasks.push_back(dependent);
+      }
+    }
+  };
+
+  struct RunningTask {
+    size_t task_idx;
+    size_t slot;
+    size_t estimated_bytes;
+    std::future<void> future;
+  };
+  std::vector<std::unique_ptr<RelAlgExecutor>> helpers(max_running_tasks);
+  std::vector<size_t> free_slots(max_running_tasks);
+  std::iota(free_slots.rbegin(), free_slots.rend(), 0);
+  std::list<RunningTask> running_tasks;
+  size_t running_bytes{0};
+  std::mutex finished_slots_mutex;
+  std::condition_variable finished_slots_cv;
+  std::deque<size_t> finished_slots;
+  ScopeGuard cleanup_helpers = [&running_tasks, &helpers] {
+    for (auto& running_task : running_tasks) {
+      running_task.future.wait();
+    }
+    for (auto& helper : helpers) {
+      if (helper) {
+        helper->cleanupPostExecution();
+        helper->executor_->clearMetaInfoCache();
+      }
+    }
+  };
+
+  std::exception_ptr error;
+  while (completed_tasks < task_count) {
+    while (!error && !ready_tasks.empty() && running_tasks.size() < max_running_tasks) {
+      const auto task_idx = ready_tasks.front();
+      if (tasks_are_steps && running_tasks.empty() && ready_tasks.size() == 1) {
+        // nothing to overlap the step with, execute it on this executor
+        ready_tasks.pop_front();
+        execute_task(*this, task_idx);
+        complete_task(task_idx);
+        continue;
+      }
+      const auto estimated_bytes = estimate_task_result_bytes(task_idx);
+      if (!running_tasks.empty() &&
+          running_bytes + estimated_bytes > g_parallel_query_steps_memory_budget) {
+        break;
+      }
+      ready_tasks.pop_front();
+      const auto slot = free_slots.back();
+      free_slots.pop_back();
+      auto& helper = helpers[slot];
+      if (!helper) {
+        const auto executor_id = kConcurrentStepExecutorIdBase +
+                                 executor_->getExecutorId() * kMaxConcurrentQuerySteps +
+                                 slot;
+        helper = std::make_unique<RelAlgExecutor>(
+            Executor::getExecutor(executor_id).get(), cat_, query_state_);
+      }
+      helper->shareExecutionStateOf(*this);
+      running_bytes += estimated_bytes;
+      VLOG(1) << "Executing task " << task_idx << " concurrently on executor "
+              << helper->executor_->getExecutorId() << ", " << running_tasks.size() + 1
+              << " tasks running";
+      running_tasks.push_back(
+          {task_idx,
+           slot,
+           estimated_bytes,
+           std::async(std::launch::async,
+                      [&, task_idx, slot, helper = helper.get()] {
+                        ScopeGuard notify_finished = [&, slot] {
+                          std::lock_guard<std::mutex> lock(finished_slots_mutex);
+                          finished_slots.push_back(slot);
+                          finished_slots_cv.notify_one();
+                        };
+                        execute_task(*helper, task_idx);
+                      })});
+      // counted here rather than in the tasks, so that it does not depend on how the
+      // threads of the tasks happen to be scheduled
+      auto max_dispatched = max_concurrently_dispatched_tasks_.load();
+      while (max_dispatched < running_tasks.size() &&
+             !max_concurrently_dispatched_tasks_.compare_exchange_weak(
+                 max_dispatched, running_tasks.size())) {
+      }
+    }
+    if (running_tasks.empty()) {
+      break;
+    }
+    size_t finished_slot;
+    {
+      std::unique_lock<std::mutex> lock(finished_slots_mutex);
+      finished_slots_cv.wait(lock, [&finished_slots] { return !finished_slots.empty(); });
+      finished_slot = finished_slots.front();
+      finished_slots.pop_front();
+    }
+    auto it = std::find_if(
+        running_tasks.begin(), running_tasks.end(), [finished_slot](const auto& task) {
+          return task.slot == finished_slot;
+        });
+    CHECK(it != running_tasks.end());
+    try {
+      it->future.get();
+      auto& helper = *helpers[finished_slot];
+      if (tasks_are_steps) {
+        for (const auto& [table_id, result] : helper.temporary_tables_) {
+          temporary_tables_.emplace(table_id, result);
+        }
+        target_exprs_owned_.insert(target_exprs_owned_.end(),
+                                   helper.target_exprs_owned_.begin(),
+                                   helper.target_exprs_owned_.end());
+        helper.target_exprs_owned_.clear();
+      }
+      complete_task(it->task_idx);
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+    running_bytes -= it->estimated_bytes;
+    free_slots.push_back(finished_slot);
+    running_tasks.erase(it);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  CHECK_EQ(completed_tasks, task_count);
+}
+
+size_t RelAlgExecutor::getMaxConcurrentlyDispatchedTasks() {
+  return max_concurrently_dispatched_tasks_;
+}
+
+void RelAlgExecutor::resetMaxConcurrentlyDispatchedTasks() {
+  max_concurrently_dispatched_tasks_ = 0;
+}
+
+void RelAlgExecutor::shareExecutionStateOf(const RelAlgExecutor& ra_executor) {
+  CHECK(ra_executor.executor_->row_set_mem_owner_);
+  executor_->setCatalog(&cat_);
+  executor_->row_set_mem_owner_ = ra_executor.executor_->row_set_mem_owner_;
+  executor_->agg_col_range_cache_ = ra_executor.executor_->agg_col_range_cache_;
+  executor_->table_generations_ = ra_executor.executor_->table_generations_;
+  decltype(temporary_tables_)(ra_executor.temporary_tables_).swap(temporary_tables_);
+  executor_->temporary_tables_ = &temporary_tables_;
+  now_ = ra_executor.now_;
+}
+
 void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
                                        const size_t step_idx,
                                        const CompilationOptions& co,
@@ -980,6 +1371,23 @@ void RelAlgExecutor::executeRelAlgStep(const RaExecutionSequence& seq,
     return;
   }
 
+  auto clock_begin = timer_start();
+  if (execution_stats_) {
+    RelRexToStringConfig config;
+    config.skip_input_nodes = true;
+    execution_stats_->beginStep(step_idx, body->toString(config));
+  }
+  ScopeGuard end_execution_stats_step = [this, &exec_desc, clock_begin] {
+    if (execution_stats_) {
+      // the step may be unwinding, in which case it has no (new) rows to count
+      const auto& rows = exec_desc.getResult().getRows();
+      execution_stats_->endStep(timer_stop(clock_begin),
+                                rows && !std::uncaught_exceptions()
+                                    ? std::make_optional(rows->rowCount())
+                                    : std::nullopt);
+    }
+  };
+
   const ExecutionOptions eo_work_unit{
       eo.output_columnar_hint,
       eo.keep_result,
@@ -2763,7 +3171,7 @@ ExecutionResult RelAlgExecutor::executeSimpleInsert(
   // mark the target table's cached item as dirty
   std::vector<int> table_chunk_key_prefix{cat_.getCurrentDB().dbId, table_id};
   auto table_key = boost::hash_value(table_chunk_key_prefix);
-  ResultSetCacheInvalidator::invalidateCachesByTable(table_key);
+  ResultSetRecyclerHolder::markCachedItemAsDirtyForAppend(table_key);
   UpdateTriggeredCacheInvalidator::invalidateCachesByTable(table_key);
 
   size_t start_row = 0;
@@ -3433,6 +3841,99 @@ inline bool can_use_bump_allocator(const RelAlgExecutionUnit& ra_exe_unit,
          !eo.output_columnar_hint && ra_exe_unit.sort_info.order_entries.empty();
 }
 
+// Whether the result of the work unit is the reduction of its results over any
+// partition of the fragments of its input table, which holds for aggregates over a
+// single stored table whose targets are group by keys or decomposable aggregates, and
+// whose group by keys are the same values in every execution.
+bool is_fragment_decomposable(const RelAlgExecutionUnit& ra_exe_unit,
+                              const std::vector<InputTableInfo>& table_infos,
+                              const Catalog_Namespace::Catalog& cat) {
+  if (ra_exe_unit.input_descs.size() != 1 || table_infos.size() != 1 ||
+      ra_exe_unit.input_descs.front().getSourceType() != InputSourceType::TABLE ||
+      !ra_exe_unit.join_quals.empty() || ra_exe_unit.estimator ||
+      ra_exe_unit.scan_limit || ra_exe_unit.use_bump_allocator ||
+      ra_exe_unit.sort_info.limit || ra_exe_unit.sort_info.offset ||
+      ra_exe_unit.query_plan_dag_hash == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return false;
+  }
+  const auto td = cat.getMetadataForTable(table_infos.front().table_id);
+  if (!td || td->isView || td->isTemporaryTable() || td->isForeignTable() ||
+      td->is_system_table || td->nShards) {
+    return false;
+  }
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    if (!groupby_expr) {
+      continue;
+    }
+    const auto& groupby_ti = groupby_expr->get_type_info();
+    if (groupby_ti.is_string()) {
+      // only the ids of a dictionary encoded column are the same across executions,
+      // string functions add transient ones
+      if (!dynamic_cast<const Analyzer::ColumnVar*>(groupby_expr.get()) ||
+          groupby_ti.get_compression() != kENCODING_DICT) {
+        return false;
+      }
+    } else if (groupby_ti.is_varlen()) {
+      return false;
+    }
+  }
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    if (const auto var = dynamic_cast<const Analyzer::Var*>(target_expr)) {
+      if (var->get_which_row() != Analyzer::Var::kGROUPBY) {
+        return false;
+      }
+      continue;
+    }
+    const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+    if (!agg_expr || agg_expr->get_is_distinct()) {
+      return false;
+    }
+    switch (agg_expr->get_aggtype()) {
+      case kAVG:
+      case kMIN:
+      case kMAX:
+      case kSUM:
+      case kCOUNT:
+        break;
+      default:
+        return false;
+    }
+    const auto arg = agg_expr->get_arg();
+    if (arg && arg->get_type_info().is_varlen()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// records the layout of the groups buffer of a group by query step and how many of its
+// entries got filled, so that the next execution of the step can pick its layout and
+// initial entry count from them
+void record_group_by_layout(const RelAlgExecutionUnit& ra_exe_unit,
+                            const RelAlgNode* body,
+                            const ResultSetPtr& result) {
+  if (!g_enable_adaptive_group_by_layout || !result ||
+      ra_exe_unit.query_plan_dag_hash == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return;
+  }
+  const auto layout = result->getQueryMemDesc().getQueryDescriptionType();
+  if (layout != QueryDescriptionType::GroupByPerfectHash &&
+      layout != QueryDescriptionType::GroupByBaselineHash) {
+    return;
+  }
+  auto layout_cache = GroupByAndAggregate::getGroupByLayoutCache();
+  layout_cache->putItemToCache(
+      ra_exe_unit.query_plan_dag_hash,
+      GroupByLayoutMetaInfo{layout, result->entryCount(), result->rowCount()},
+      CacheItemType::GROUP_BY_LAYOUT_STATS,
+      GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER,
+      0,
+      0);
+  layout_cache->addQueryPlanDagForTableKeys(
+      ra_exe_unit.query_plan_dag_hash,
+      ScanNodeTableKeyCollector::getScanNodeTableKey(body));
+}
+
 }  // namespace
 
 ExecutionResult RelAlgExecutor::executeWorkUnit(
@@ -3600,11 +4101,61 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
     }
   }
 
+  std::optional<ExecutionResult> incremental_result;
+  if (use_resultset_cache && g_enable_incremental_resultset_cache && is_agg &&
+      !render_info && is_fragment_decomposable(ra_exe_unit, table_infos, cat_)) {
+    incremental_result = executeWorkUnitIncrementally(ra_exe_unit,
+                                                      body,
+                                                      table_infos,
+                                                      targets_meta,
+                                                      max_groups_buffer_entry_guess,
+                                                      co,
+                                                      eo,
+                                                      column_cache);
+  }
+
+  const bool is_group_by = is_agg && !ra_exe_unit.groupby_exprs.empty() && !render_info;
+  const auto layout_stats =
+      is_group_by ? GroupByAndAggregate::getGroupByLayoutCache()->getItemFromCache(
+                        ra_exe_unit.query_plan_dag_hash,
+                        CacheItemType::GROUP_BY_LAYOUT_STATS,
+                        GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER)
+                  : std::nullopt;
+
+  // Starts from the number of groups found by the previous execution of the step and
+  // grows the groups buffer whenever it runs out of slots, instead of going through the
+  // NDV estimator query. We fall back to the estimator only once the buffer reaches the
+  // upper bound of the number of groups.
+  auto execute_with_recorded_groups = [&]() -> ExecutionResult {
+    CHECK(layout_stats);
+    const auto max_entry_guess = groups_approx_upper_bound(table_infos);
+    auto entry_guess =
+        std::min(std::max(2 * layout_stats->num_groups, size_t(1)), max_entry_guess);
+    while (true) {
+      try {
+        return execute_and_handle_errors(entry_guess,
+                                         /*has_cardinality_estimation=*/true,
+                                         /*has_ndv_estimation=*/false);
+      } catch (const CardinalityEstimationRequired&) {
+        if (entry_guess >= max_entry_guess) {
+          throw;
+        }
+        entry_guess = std::min(2 * entry_guess, max_entry_guess);
+        VLOG(1) << "Groups buffer ran out of slots, retrying with " << entry_guess
+                << " entries";
+      }
+    }
+  };
+
   auto cache_key = ra_exec_unit_desc_for_caching(ra_exe_unit);
   try {
     auto cached_cardinality = executor_->getCachedCardinality(cache_key);
     auto card = cached_cardinality.second;
-    if (cached_cardinality.first && card >= 0) {
+    if (incremental_result) {
+      result = std::move(*incremental_result);
+    } else if (layout_stats) {
+      result = execute_with_recorded_groups();
+    } else if (cached_cardinality.first && card >= 0) {
       result = execute_and_handle_errors(
           card, /*has_cardinality_estimation=*/true, /*has_ndv_estimation=*/false);
     } else {
@@ -3634,6 +4185,9 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
       }
     }
   }
+  if (is_group_by && !incremental_result && !is_validate_or_explain_query(eo)) {
+    record_group_by_layout(ra_exe_unit, body, result.getDataPtr());
+  }
 
   result.setQueueTime(queue_time_ms);
   if (render_info) {
@@ -3708,6 +4262,169 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
   return result;
 }
 
+std::optional<ExecutionResult> RelAlgExecutor::executeWorkUnitIncrementally(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const RelAlgNode* body,
+    const std::vector<InputTableInfo>& table_infos,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const size_t max_groups_buffer_entry_guess,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo,
+    ColumnCacheMap& column_cache) {
+  auto timer = DEBUG_TIMER(__func__);
+  auto clock_begin = timer_start();
+  CHECK_EQ(table_infos.size(), size_t(1));
+  const auto& fragments = table_infos.front().info.fragments;
+  // Rows are only appended to the last fragment of a table, so the partial result of
+  // all the others remains valid until they are modified.
+  if (fragments.size() < 2) {
+    return std::nullopt;
+  }
+  const auto last_fragment_idx = fragments.size() - 1;
+
+  const auto cached_cardinality =
+      executor_->getCachedCardinality(ra_exec_unit_desc_for_caching(ra_exe_unit));
+  const bool has_cardinality_estimation =
+      cached_cardinality.first ||
+      groups_approx_upper_bound(table_infos) <= g_big_group_threshold;
+  // Executing a subset of the fragments through the outer fragment indices rather than
+  // a subset of the table infos keeps the layout of the output buffer, which depends on
+  // the metadata of all fragments, the same for every subset.
+  auto execute_fragments =
+      [&](const std::vector<size_t>& fragment_indices) -> ResultSetPtr {
+    auto eo_fragments = eo;
+    eo_fragments.outer_fragment_indices = fragment_indices;
+    size_t groups_buffer_entry_guess = cached_cardinality.first
+                                           ? cached_cardinality.second
+                                           : max_groups_buffer_entry_guess;
+    try {
+      return executor_->executeWorkUnit(groups_buffer_entry_guess,
+                                        /*is_agg=*/true,
+                                        table_infos,
+                                        ra_exe_unit,
+                                        co,
+                                        eo_fragments,
+                                        cat_,
+                                        nullptr,
+                                        has_cardinality_estimation,
+                                        column_cache);
+    } catch (const QueryExecutionError& e) {
+      if (e.getErrorCode() == Executor::ERR_INTERRUPTED) {
+        throw;
+      }
+      VLOG(1) << "Failed to execute the query over a subset of fragments (error code: "
+              << e.getErrorCode() << "), execute it over all fragments instead";
+      return nullptr;
+    }
+  };
+  // Returns nullptr if the buffer layouts of the two results differ.
+  auto reduce_results = [this](ResultSetPtr cached_result,
+                               ResultSetPtr result) -> ResultSetPtr {
+    ResultSetManager rs_manager;
+    if (!rs_manager.reduceIntoCachedResult(
+            cached_result.get(), result.get(), executor_->getExecutorId())) {
+      return nullptr;
+    }
+    auto reduced_result = rs_manager.getOwnResultSet();
+    return reduced_result ? reduced_result : cached_result;
+  };
+
+  auto& resultset_recycler_holder = executor_->getRecultSetRecyclerHolder();
+  ResultSetPtr partial_result;
+  FragmentTupleCountMap covered_fragments;
+  if (auto cached_partial_result =
+          resultset_recycler_holder.getCachedPartialQueryResultSet(
+              ra_exe_unit.query_plan_dag_hash)) {
+    FragmentTupleCountMap full_fragments;
+    for (size_t i = 0; i < last_fragment_idx; ++i) {
+      full_fragments.emplace(fragments[i].fragmentId, fragments[i].getNumTuples());
+    }
+    // a covered fragment is gone or has a different size if it has been merged or
+    // vacuumed since
+    const auto& cached_fragments = cached_partial_result->second;
+    if (std::all_of(cached_fragments.begin(),
+                    cached_fragments.end(),
+                    [&full_fragments](const auto& fragment) {
+                      auto it = full_fragments.find(fragment.first);
+                      return it != full_fragments.end() && it->second == fragment.second;
+                    })) {
+      partial_result = cached_partial_result->first;
+      covered_fragments = cached_fragments;
+    }
+  }
+
+  std::vector<size_t> new_fragment_indices;
+  for (size_t i = 0; i < last_fragment_idx; ++i) {
+    if (!covered_fragments.count(fragments[i].fragmentId)) {
+      new_fragment_indices.push_back(i);
+    }
+  }
+  if (!new_fragment_indices.empty()) {
+    auto new_result = execute_fragments(new_fragment_indices);
+    if (!new_result) {
+      return std::nullopt;
+    }
+    if (partial_result) {
+      partial_result = reduce_results(partial_result, new_result);
+      // Reducing into a baseline hash layout grows the buffer by the entries of the
+      // reduced result, so rebuild a partial result that keeps growing.
+      constexpr size_t kMaxPartialResultEntryCountGrowth{4};
+      if (partial_result &&
+          partial_result->getQueryMemDesc().getQueryDescriptionType() ==
+              QueryDescriptionType::GroupByBaselineHash &&
+          partial_result->getQueryMemDesc().getEntryCount() >
+              kMaxPartialResultEntryCountGrowth *
+                  new_result->getQueryMemDesc().getEntryCount()) {
+        partial_result = nullptr;
+      }
+      if (!partial_result) {
+        // e.g., the range of a perfect hash group by key has grown since the partial
+        // result was cached, so recompute it over all full fragments
+        covered_fragments.clear();
+        new_fragment_indices.resize(last_fragment_idx);
+        std::iota(new_fragment_indices.begin(), new_fragment_indices.end(), 0);
+        partial_result = execute_fragments(new_fragment_indices);
+        if (!partial_result) {
+          return std::nullopt;
+        }
+      }
+    } else {
+      partial_result = new_result;
+    }
+    for (const auto fragment_idx : new_fragment_indices) {
+      const auto& fragment = fragments[fragment_idx];
+      covered_fragments.emplace(fragment.fragmentId, fragment.getNumTuples());
+    }
+    // the partial result is reduced with the result of the last fragment below, so
+    // cache a copy of it
+    if (auto cached_partial_result = partial_result->copy()) {
+      cached_partial_result->setExecTime(timer_stop(clock_begin));
+      resultset_recycler_holder.putPartialQueryResultSetToCache(
+          ra_exe_unit.query_plan_dag_hash,
+          ScanNodeTableKeyCollector::getScanNodeTableKey(body),
+          cached_partial_result,
+          cached_partial_result->getBufferSizeBytes(co.device_type),
+          covered_fragments);
+    }
+  }
+
+  auto result = partial_result;
+  if (fragments[last_fragment_idx].getNumTuples() > 0) {
+    auto last_fragment_result = execute_fragments({last_fragment_idx});
+    if (!last_fragment_result) {
+      return std::nullopt;
+    }
+    result = reduce_results(partial_result, last_fragment_result);
+    if (!result) {
+      return std::nullopt;
+    }
+  }
+  VLOG(1) << "Reduced the partial result of " << covered_fragments.size()
+          << " full fragments, " << new_fragment_indices.size()
+          << " of them executed by this query, with the result of the last fragment";
+  return ExecutionResult{result, targets_meta};
+}
+
 std::optional<size_t> RelAlgExecutor::getFilteredCountAll(const WorkUnit& work_unit,
                                                           const bool is_agg,
                                                           const CompilationOptions& co,
@@ -5081,6 +5798,7 @@ RelAlgExecutor::WorkUnit RelAlgExecutor::createFilterWorkUnit(const RelFilter* f
 }
 
 SpeculativeTopNBlacklist RelAlgExecutor::speculative_topn_blacklist_;
+std::atomic<size_t> RelAlgExecutor::max_concurrently_dispatched_tasks_{0};
 
 void RelAlgExecutor::initializeParallelismHints() {
   if (auto foreign_storage_mgr =
@@ -29,6 +29,7 @@
 #include "Shared/scope.h"
 #include "ThriftHandler/QueryState.h"
 
+#include <atomic>
 #include <ctime>
 #include <sstream>
 
@@ -100,6 +101,12 @@ class RelAlgExecutor : private StorageIOFacility {
                                      const bool just_explain_plan,
                                      RenderInfo* render_info);
 
+  // Makes executeRelAlgQuery() gather runtime statistics of the query steps and return
+  // them as an explanation instead of the result of the query (EXPLAIN ANALYZE).
+  void enableExplainAnalyze() {
+    execution_stats_ = std::make_unique<QueryExecutionStats>();
+  }
+
   ExecutionResult executeRelAlgQueryWithFilterPushDown(const RaExecutionSequence& seq,
                                                        const CompilationOptions& co,
                                                        const ExecutionOptions& eo,
@@ -202,6 +209,11 @@ class RelAlgExecutor : private StorageIOFacility {
 
   void prepareForSystemTableExecution(const CompilationOptions& co) const;
 
+  // Highest number of query steps or subqueries dispatched to helper executors and not
+  // finished yet at the same time since the last reset. Visible for use in unit tests.
+  static size_t getMaxConcurrentlyDispatchedTasks();
+  static void resetMaxConcurrentlyDispatchedTasks();
+
  private:
   void initializeParallelismHints();
 
@@ -217,6 +229,38 @@ class RelAlgExecutor : private StorageIOFacility {
                          RenderInfo*,
                          const int64_t queue_time_ms);
 
+  bool canExecuteConcurrently(const ExecutionOptions& eo, RenderInfo* render_info) const;
+
+  bool canExecuteStepsConcurrently(const RaExecutionSequence& seq,
+                                   const size_t step_count,
+                                   const ExecutionOptions& eo,
+                                   RenderInfo* render_info) const;
+
+  // Executes the first step_count steps of the sequence, each as soon as the steps it
+  // reads the results of have been executed, up to g_max_parallel_query_steps at a time.
+  void executeRelAlgStepsConcurrently(const RaExecutionSequence& seq,
+                                      const size_t step_count,
+                                      const CompilationOptions& co,
+                                      const ExecutionOptions& eo,
+                                      const int64_t queue_time_ms);
+
+  // Executes the subqueries which do not contain subqueries themselves concurrently.
+  void executeSubqueriesConcurrently(const CompilationOptions& co,
+                                     const ExecutionOptions& eo);
+
+  // Runs each task once the tasks it depends on have completed. The tasks run on
+  // helper executors sharing the execution state of this one, as many at a time as
+  // allowed by g_max_parallel_query_steps and by the memory budget for their results.
+  // Tasks which are steps of the sequence of this executor add their results to its
+  // temporary tables, and run on this executor when no other task can run meanwhile.
+  void executeConcurrently(
+      const std::vector<std::vector<size_t>>& dependencies,
+      const std::function<size_t(const size_t)>& estimate_task_result_bytes,
+      const std::function<void(RelAlgExecutor&, const size_t)>& execute_task,
+      const bool tasks_are_steps);
+
+  void shareExecutionStateOf(const RelAlgExecutor& ra_executor);
+
   void executeUpdate(const RelAlgNode* node,
                      const CompilationOptions& co,
                      const ExecutionOptions& eo,
@@ -304,6 +348,20 @@ class RelAlgExecutor : private StorageIOFacility {
       const int64_t queue_time_ms,
       const std::optional<size_t> previous_count = std::nullopt);
 
+  // Computes the result of an aggregate over a single table by reducing the cached
+  // partial result of its full fragments with the result of the fragments the partial
+  // result does not cover, and caches the partial result of the full fragments again.
+  // Returns std::nullopt if the work unit has to be executed over all fragments.
+  std::optional<ExecutionResult> executeWorkUnitIncrementally(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const RelAlgNode* body,
+      const std::vector<InputTableInfo>& table_infos,
+      const std::vector<TargetMetaInfo>& targets_meta,
+      const size_t max_groups_buffer_entry_guess,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo,
+      ColumnCacheMap& column_cache);
+
   // Computes the window function results to be used by the query.
   void computeWindow(const WorkUnit& work_unit,
                      const CompilationOptions& co,
@@ -436,9 +494,11 @@ class RelAlgExecutor : private StorageIOFacility {
   int64_t queue_time_ms_;
   bool has_step_for_union_;
   static SpeculativeTopNBlacklist speculative_topn_blacklist_;
+  static std::atomic<size_t> max_concurrently_dispatched_tasks_;
 
   std::unique_ptr<TransactionParameters> dml_transaction_parameters_;
   std::optional<std::function<void()>> post_execution_callback_;
+  std::unique_ptr<QueryExecutionStats> execution_stats_;
 
   friend class PendingExecutionClosure;
 };
@@ -19,6 +19,7 @@
 #include "RexVisitor.h"
 #include "Visitors/RexSubQueryIdCollector.h"
 
+#include <algorithm>
 #include <numeric>
 #include <string>
 #include <unordered_map>
@@ -1787,3 +1788,233 @@ void simplify_sort(std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept {
   }
   nodes.swap(new_nodes);
 }
+
+namespace {
+
+// Replaces the inputs referencing the given project by a copy of the expressions they
+// reference.
+class RexProjectInliner : public RexDeepCopyVisitor {
+ public:
+  RexProjectInliner(const RelProject* project) : project_(project) {}
+
+  RetType visitInput(const RexInput* input) const override {
+    if (input->getSourceNode() != project_) {
+      return input->deepCopy();
+    }
+    return RexDeepCopyVisitor::visit(project_->getProjectAt(input->getIndex()));
+  }
+
+ private:
+  const RelProject* project_;
+};
+
+class RexInputUseCounter : public RexVisitor<void*> {
+ public:
+  RexInputUseCounter(const RelAlgNode* source) : source_(source) {}
+
+  void* visitInput(const RexInput* input) const override {
+    if (input->getSourceNode() == source_) {
+      ++use_counts_[input->getIndex()];
+    }
+    return nullptr;
+  }
+
+  const std::unordered_map<size_t, size_t>& getUseCounts() const { return use_counts_; }
+
+ private:
+  const RelAlgNode* source_;
+  mutable std::unordered_map<size_t, size_t> use_counts_;
+};
+
+class RexSubQueryFinder : public RexVisitor<bool> {
+ public:
+  bool visitSubQuery(const RexSubQuery*) const override { return true; }
+
+ protected:
+  bool aggregateResult(const bool& aggregate, const bool& next_result) const override {
+    return aggregate || next_result;
+  }
+};
+
+bool is_fusible_project(RelProject* project) {
+  return !project->hasWindowFunctionExpr() && !project->hasDeliveredHint() &&
+         !project->isUpdateViaSelect() && !project->isDeleteViaSelect() &&
+         !project->isVarlenUpdateRequired() &&
+         !dynamic_cast<const RelJoin*>(project->getInput(0));
+}
+
+// The projected expressions can be copied to their uses if they contain no subquery,
+// and if the copies evaluate no expression other than an input or a literal more than
+// once per row.
+bool can_inline_project_exprs(const RelProject* project,
+                              const std::unordered_map<size_t, size_t>& use_counts) {
+  RexSubQueryFinder subquery_finder;
+  for (const auto& [idx, use_count] : use_counts) {
+    const auto expr = project->getProjectAt(idx);
+    if (subquery_finder.visit(expr)) {
+      return false;
+    }
+    if (use_count > 1 && !dynamic_cast<const RexInput*>(expr) &&
+        !dynamic_cast<const RexLiteral*>(expr)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether the projected expressions with the given indices are all inputs or literals.
+// Any other expression would be evaluated twice per row once copied below the project:
+// by the copy and by the project itself.
+bool references_only_inputs_and_literals(
+    const RelProject* project,
+    const std::unordered_map<size_t, size_t>& use_counts) {
+  for (const auto& [idx, use_count] : use_counts) {
+    const auto expr = project->getProjectAt(idx);
+    if (!dynamic_cast<const RexInput*>(expr) && !dynamic_cast<const RexLiteral*>(expr)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool is_used_by_join(
+    const RelAlgNode* node,
+    const std::unordered_map<const RelAlgNode*, std::unordered_set<const RelAlgNode*>>&
+        du_web) {
+  const auto usrs_it = du_web.find(node);
+  CHECK(usrs_it != du_web.end());
+  return std::any_of(usrs_it->second.begin(), usrs_it->second.end(), [](auto usr) {
+    return dynamic_cast<const RelJoin*>(usr);
+  });
+}
+
+// Moves a filter below the project it consumes: Project -> Filter becomes Filter ->
+// Project, with the filter condition reading the projected inputs and literals it
+// references from the input of the project. Returns true if any filter has been moved.
+bool sink_filters_below_projects(std::vector<std::shared_ptr<RelAlgNode>>& nodes) {
+  std::unordered_map<const RelAlgNode*, size_t> node_positions;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    node_positions.emplace(nodes[i].get(), i);
+  }
+  auto web = build_du_web(nodes);
+  bool sunk{false};
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    auto filter = std::dynamic_pointer_cast<RelFilter>(nodes[i]);
+    if (!filter) {
+      continue;
+    }
+    const auto project_pos_it = node_positions.find(filter->getInput(0));
+    if (project_pos_it == node_positions.end()) {
+      continue;
+    }
+    const auto project_pos = project_pos_it->second;
+    auto project = std::dynamic_pointer_cast<RelProject>(nodes[project_pos]);
+    if (!project || !is_fusible_project(project.get()) ||
+        web[project.get()].size() != 1 || is_used_by_join(filter.get(), web) ||
+        RexSubQueryFinder().visit(filter->getCondition())) {
+      continue;
+    }
+    RexInputUseCounter use_counter(project.get());
+    use_counter.visit(filter->getCondition());
+    if (!references_only_inputs_and_literals(project.get(),
+                                             use_counter.getUseCounts())) {
+      continue;
+    }
+    VLOG(1) << "Filter (ID: " << filter->getId() << ") sunk below project (ID: "
+            << project->getId() << ")";
+    RexProjectInliner inliner(project.get());
+    auto new_condition = inliner.visit(filter->getCondition());
+    filter->setCondition(new_condition);
+    const auto source = project->getAndOwnInput(0);
+    filter->replaceInput(project, source);
+    auto& filter_usrs = web[filter.get()];
+    for (auto usr : filter_usrs) {
+      auto usr_pos_it = node_positions.find(usr);
+      CHECK(usr_pos_it != node_positions.end());
+      nodes[usr_pos_it->second]->replaceInput(filter, project);
+    }
+    project->replaceInput(source, filter);
+
+    web[project.get()].swap(filter_usrs);
+    filter_usrs = {project.get()};
+    auto source_usrs_it = web.find(source.get());
+    if (source_usrs_it != web.end()) {
+      source_usrs_it->second.erase(project.get());
+      source_usrs_it->second.insert(filter.get());
+    }
+    std::swap(nodes[i], nodes[project_pos]);
+    node_positions[filter.get()] = project_pos;
+    node_positions[project.get()] = i;
+    sunk = true;
+  }
+  return sunk;
+}
+
+// Folds a project into the project consuming it, if it is its only consumer.
+void fold_projects(std::vector<std::shared_ptr<RelAlgNode>>& nodes) {
+  std::unordered_map<const RelAlgNode*, size_t> node_positions;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    node_positions.emplace(nodes[i].get(), i);
+  }
+  auto web = build_du_web(nodes);
+  for (auto& node : nodes) {
+    auto project = std::dynamic_pointer_cast<RelProject>(node);
+    if (!project || !is_fusible_project(project.get())) {
+      continue;
+    }
+    const auto src_pos_it = node_positions.find(project->getInput(0));
+    if (src_pos_it == node_positions.end()) {
+      continue;
+    }
+    auto& src_node = nodes[src_pos_it->second];
+    auto src_project = std::dynamic_pointer_cast<RelProject>(src_node);
+    if (!src_project || !is_fusible_project(src_project.get()) ||
+        web[src_project.get()].size() != 1) {
+      continue;
+    }
+    RexInputUseCounter use_counter(src_project.get());
+    for (size_t i = 0; i < project->size(); ++i) {
+      use_counter.visit(project->getProjectAt(i));
+    }
+    if (!can_inline_project_exprs(src_project.get(), use_counter.getUseCounts())) {
+      continue;
+    }
+    VLOG(1) << "Project (ID: " << src_project->getId() << ") folded into project (ID: "
+            << project->getId() << ")";
+    RexProjectInliner inliner(src_project.get());
+    std::vector<std::unique_ptr<const RexScalar>> new_exprs;
+    for (size_t i = 0; i < project->size(); ++i) {
+      new_exprs.push_back(inliner.visit(project->getProjectAt(i)));
+    }
+    project->setExpressions(new_exprs);
+    const auto source = src_project->getAndOwnInput(0);
+    project->replaceInput(src_project, source);
+    auto source_usrs_it = web.find(source.get());
+    if (source_usrs_it != web.end()) {
+      source_usrs_it->second.erase(src_project.get());
+      source_usrs_it->second.insert(project.get());
+    }
+    web.erase(src_project.get());
+    node_positions.erase(src_project.get());
+    src_node.reset();
+  }
+
+  std::vector<std::shared_ptr<RelAlgNode>> new_nodes;
+  for (auto node : nodes) {
+    if (!node) {
+      continue;
+    }
+    new_nodes.push_back(node);
+  }
+  nodes.swap(new_nodes);
+}
+
+}  // namespace
+
+void fuse_projects_into_consumers(
+    std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept {
+  // each move of a filter may place it below another project
+  while (sink_filters_below_projects(nodes)) {
+  }
+  fold_projects(nodes);
+}
@@ -32,6 +32,10 @@ void eliminate_dead_columns(std::vector<std::shared_ptr<RelAlgNode>>& nodes) noe
 void eliminate_dead_subqueries(std::vector<std::shared_ptr<RexSubQuery>>& subqueries,
                                RelAlgNode const* root);
 void fold_filters(std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept;
+// Fuses projects into the filters and projects consuming them, so that a chain of
+// projects and filters executes as a single step.
+void fuse_projects_into_consumers(
+    std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept;
 void hoist_filter_cond_to_cross_join(
     std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept;
 void simplify_sort(std::vector<std::shared_ptr<RelAlgNode>>& nodes) noexcept;
@@ -665,6 +665,16 @@ bool ResultSet::isEmpty() const {
   return rowCount() == size_t(0);
 }
 
+void ResultSet::setLazyFetchColumnBuffer(const size_t frag_idx,
+                                         const size_t local_col_id,
+                                         const int8_t* col_buffer) {
+  for (auto& storage_col_buffers : col_buffers_) {
+    CHECK_LT(frag_idx, storage_col_buffers.size());
+    CHECK_LT(local_col_id, storage_col_buffers[frag_idx].size());
+    storage_col_buffers[frag_idx][local_col_id] = col_buffer;
+  }
+}
+
 bool ResultSet::definitelyHasNoRows() const {
   return (!storage_ && !estimator_ && !just_explain_) || cached_row_count_ == 0;
 }
@@ -1313,15 +1323,23 @@ const std::vector<std::string> ResultSet::getStringDictionaryPayloadCopy(
 
 const std::pair<std::vector<int32_t>, std::vector<std::string>>
 ResultSet::getUniqueStringsForDictEncodedTargetCol(const size_t col_idx) const {
+  return getUniqueStringsForDictEncodedTargetCol(col_idx, 0, entryCount());
+}
+
+const std::pair<std::vector<int32_t>, std::vector<std::string>>
+ResultSet::getUniqueStringsForDictEncodedTargetCol(const size_t col_idx,
+                                                   const size_t start_entry,
+                                                   const size_t end_entry) const {
   const auto col_type_info = getColType(col_idx);
   CHECK(col_type_info.is_dict_encoded_string());
+  CHECK_LE(start_entry, end_entry);
+  CHECK_LE(end_entry, entryCount());
   std::unordered_set<int32_t> unique_string_ids_set;
-  const size_t num_entries = entryCount();
   std::vector<bool> targets_to_skip(colCount(), true);
   targets_to_skip[col_idx] = false;
   const auto null_val = inline_fixed_encoding_null_val(col_type_info);
 
-  for (size_t row_idx = 0; row_idx < num_entries; ++row_idx) {
+  for (size_t row_idx = start_entry; row_idx < end_entry; ++row_idx) {
     const auto result_row = getRowAtNoTranslations(row_idx, targets_to_skip);
     if (!result_row.empty()) {
       const auto scalar_col_val = boost::get<ScalarTargetValue>(result_row[col_idx]);
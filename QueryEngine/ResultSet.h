@@ -421,6 +421,11 @@ class ResultSet {
   void holdChunks(const std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunks) {
     chunks_ = chunks;
   }
+  // Sets the buffer of a lazily fetched column whose load was deferred until the kernel
+  // which produced this result set had run.
+  void setLazyFetchColumnBuffer(const size_t frag_idx,
+                                const size_t local_col_id,
+                                const int8_t* col_buffer);
   void holdChunkIterators(const std::shared_ptr<std::list<ChunkIter>> chunk_iters) {
     chunk_iters_.push_back(chunk_iters);
   }
@@ -577,6 +582,12 @@ class ResultSet {
   const std::pair<std::vector<int32_t>, std::vector<std::string>>
   getUniqueStringsForDictEncodedTargetCol(const size_t col_idx) const;
 
+  // Same as above, restricted to the entries in [start_entry, end_entry).
+  const std::pair<std::vector<int32_t>, std::vector<std::string>>
+  getUniqueStringsForDictEncodedTargetCol(const size_t col_idx,
+                                          const size_t start_entry,
+                                          const size_t end_entry) const;
+
   StringDictionaryProxy* getStringDictionaryProxy(int const dict_id) const;
 
   template <typename ENTRY_TYPE, QueryDescriptionType QUERY_TYPE, bool COLUMNAR_FORMAT>
@@ -992,11 +1003,20 @@ class ResultSetManager {
  public:
   ResultSet* reduce(std::vector<ResultSet*>&, const size_t executor_id);
 
+  // Reduces the result of a work unit over some fragments into the result of the same
+  // work unit over other fragments, computed earlier and possibly by another executor.
+  // Returns nullptr if their buffers do not have the same layout.
+  ResultSet* reduceIntoCachedResult(ResultSet* cached_result,
+                                    ResultSet* result,
+                                    const size_t executor_id);
+
   std::shared_ptr<ResultSet> getOwnResultSet();
 
   void rewriteVarlenAggregates(ResultSet*);
 
  private:
+  ResultSet* reduceImpl(std::vector<ResultSet*>&, const size_t executor_id);
+
   std::shared_ptr<ResultSet> rs_;
 };
 
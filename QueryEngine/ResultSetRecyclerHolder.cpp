@@ -56,6 +56,28 @@ void ResultSetRecyclerHolder::putQueryResultSetToCache(
                                          resultset_meta_info);
 }
 
+std::optional<std::pair<ResultSetPtr, FragmentTupleCountMap>>
+ResultSetRecyclerHolder::getCachedPartialQueryResultSet(const size_t key) {
+  return query_resultset_cache_->getPartialItemFromCache(key);
+}
+
+void ResultSetRecyclerHolder::putPartialQueryResultSetToCache(
+    const size_t key,
+    const std::unordered_set<size_t>& input_table_keys,
+    const ResultSetPtr partial_result,
+    size_t resultset_size,
+    const FragmentTupleCountMap& covered_fragments) {
+  ResultSetMetaInfo resultset_meta_info{input_table_keys};
+  resultset_meta_info.covered_fragments = covered_fragments;
+  query_resultset_cache_->putItemToCache(key,
+                                         partial_result,
+                                         CacheItemType::PARTIAL_QUERY_RESULTSET,
+                                         DataRecyclerUtil::CPU_DEVICE_IDENTIFIER,
+                                         resultset_size,
+                                         partial_result->getExecTime(),
+                                         resultset_meta_info);
+}
+
 std::optional<ChunkMetadataMap> ResultSetRecyclerHolder::getCachedChunkMetadata(
     const size_t key) {
   return chunk_metadata_cache_->getItemFromCache(
@@ -40,6 +40,30 @@ class ResultSetRecyclerHolder {
           *candidate_table_keys,
           CacheItemType::QUERY_RESULTSET,
           DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+      query_resultset_cache_->markCachedItemAsDirty(
+          table_key,
+          *candidate_table_keys,
+          CacheItemType::PARTIAL_QUERY_RESULTSET,
+          DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+
+      chunk_metadata_cache_->markCachedItemAsDirty(
+          table_key,
+          *candidate_table_keys,
+          CacheItemType::CHUNK_METADATA,
+          DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+    }
+  }
+
+  // invalidates cached items computed from a table whose only modification since is
+  // an append, i.e., an insert, COPY FROM or INSERT INTO ... SELECT
+  static auto markCachedItemAsDirtyForAppend(size_t table_key) {
+    CHECK(query_resultset_cache_);
+    CHECK(chunk_metadata_cache_);
+    auto candidate_table_keys =
+        query_resultset_cache_->getMappedQueryPlanDagsWithTableKey(table_key);
+    if (candidate_table_keys.has_value()) {
+      query_resultset_cache_->markCachedItemAsDirtyForAppend(table_key,
+                                                             *candidate_table_keys);
 
       chunk_metadata_cache_->markCachedItemAsDirty(
           table_key,
@@ -62,6 +86,15 @@ class ResultSetRecyclerHolder {
       size_t resultset_size,
       std::vector<std::shared_ptr<Analyzer::Expr>>& target_exprs);
 
+  std::optional<std::pair<ResultSetPtr, FragmentTupleCountMap>>
+  getCachedPartialQueryResultSet(const size_t key);
+
+  void putPartialQueryResultSetToCache(const size_t key,
+                                       const std::unordered_set<size_t>& input_table_keys,
+                                       const ResultSetPtr partial_result,
+                                       size_t resultset_size,
+                                       const FragmentTupleCountMap& covered_fragments);
+
   std::optional<ChunkMetadataMap> getCachedChunkMetadata(const size_t key);
 
   void putChunkMetadataToCache(const size_t key,
@@ -1056,14 +1056,63 @@ void ResultSet::initializeStorage() const {
 ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets,
                                     const size_t executor_id) {
   CHECK(!result_sets.empty());
+  const auto row_set_mem_owner = result_sets.front()->row_set_mem_owner_;
+  for (const auto result_set : result_sets) {
+    CHECK_EQ(row_set_mem_owner, result_set->row_set_mem_owner_);
+  }
+  return reduceImpl(result_sets, executor_id);
+}
+
+ResultSet* ResultSetManager::reduceIntoCachedResult(ResultSet* cached_result,
+                                                    ResultSet* result,
+                                                    const size_t executor_id) {
+  CHECK(cached_result);
+  CHECK(result);
+  if (!result->storage_) {
+    // none of the fragments has been dispatched
+    return cached_result;
+  }
+  if (cached_result->catalog_ != result->catalog_ || !cached_result->storage_ ||
+      !cached_result->appended_storage_.empty() ||
+      !result->appended_storage_.empty() || !cached_result->permutation_.empty() ||
+      !result->permutation_.empty()) {
+    return nullptr;
+  }
+  const auto& cached_query_mem_desc = cached_result->query_mem_desc_;
+  const auto& query_mem_desc = result->query_mem_desc_;
+  if (!(cached_query_mem_desc == query_mem_desc) || query_mem_desc.sortOnGpu()) {
+    return nullptr;
+  }
+  if (query_mem_desc.getQueryDescriptionType() !=
+          QueryDescriptionType::GroupByBaselineHash &&
+      cached_query_mem_desc.getEntryCount() != query_mem_desc.getEntryCount()) {
+    return nullptr;
+  }
+  // The targets of the row built for an empty input are nullable.
+  const auto& cached_targets = cached_result->targets_;
+  const auto& targets = result->targets_;
+  if (cached_targets.size() != targets.size()) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < targets.size(); ++i) {
+    if (cached_targets[i].agg_kind != targets[i].agg_kind ||
+        cached_targets[i].sql_type != targets[i].sql_type ||
+        cached_targets[i].skip_null_val != targets[i].skip_null_val) {
+      return nullptr;
+    }
+  }
+  std::vector<ResultSet*> result_sets{cached_result, result};
+  return reduceImpl(result_sets, executor_id);
+}
+
+ResultSet* ResultSetManager::reduceImpl(std::vector<ResultSet*>& result_sets,
+                                        const size_t executor_id) {
+  CHECK(!result_sets.empty());
   auto result_rs = result_sets.front();
   CHECK(result_rs->storage_);
   auto& first_result = *result_rs->storage_;
   auto result = &first_result;
   const auto row_set_mem_owner = result_rs->row_set_mem_owner_;
-  for (const auto result_set : result_sets) {
-    CHECK_EQ(row_set_mem_owner, result_set->row_set_mem_owner_);
-  }
   const auto catalog = result_rs->catalog_;
   for (const auto result_set : result_sets) {
     CHECK_EQ(catalog, result_set->catalog_);
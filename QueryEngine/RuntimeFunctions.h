@@ -134,6 +134,23 @@ extern "C" RUNTIME_EXPORT int64_t* get_group_value(
     const uint32_t key_width,
     const uint32_t row_size_quad);
 
+// Layout of the hot group cache placed right after the entries of a CPU baseline hash
+// groups buffer, in 64-bit words: the number of lookups (negative once the cache turned
+// itself off) and of hits, followed by the cached entry indices plus one.
+#define HOT_GROUP_CACHE_SIZE 64
+#define HOT_GROUP_CACHE_HEADER_QW 2
+#define HOT_GROUP_CACHE_QW (HOT_GROUP_CACHE_HEADER_QW + HOT_GROUP_CACHE_SIZE)
+// number of lookups after which the cache turns itself off unless half of them hit
+#define HOT_GROUP_CACHE_SAMPLE_SIZE 4096
+
+extern "C" RUNTIME_EXPORT int64_t* get_group_value_with_hot_cache(
+    int64_t* groups_buffer,
+    const uint32_t groups_buffer_entry_count,
+    const int64_t* key,
+    const uint32_t key_count,
+    const uint32_t key_width,
+    const uint32_t row_size_quad);
+
 enum RuntimeInterruptFlags { INT_CHECK = 0, INT_ABORT = -1, INT_RESET = -2 };
 
 extern "C" bool RUNTIME_EXPORT check_interrupt();
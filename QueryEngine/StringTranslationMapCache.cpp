@@ -0,0 +1,226 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/StringTranslationMapCache.h"
+
+#include <boost/functional/hash.hpp>
+
+#include "Logger/Logger.h"
+
+bool g_enable_string_translation_map_cache{false};
+size_t g_string_translation_map_cache_max_size_bytes{size_t(1) << 28};  // 256MB
+
+namespace {
+
+// A translation can only be reused when it does not depend on state local to the
+// query, i.e. neither proxy holds transient strings yet. Translations from an empty
+// source dictionary, such as the per-query literals dictionary, are not worth caching.
+bool is_cacheable_translation(const StringDictionaryProxy* source_proxy,
+                              const StringDictionaryProxy* dest_proxy) {
+  return g_enable_string_translation_map_cache &&
+         g_string_translation_map_cache_max_size_bytes > 0 &&
+         source_proxy->getGeneration() > 0 && dest_proxy->getGeneration() >= 0 &&
+         source_proxy->transientEntryCount() == 0 &&
+         dest_proxy->transientEntryCount() == 0;
+}
+
+}  // namespace
+
+bool StringTranslationMapCache::CacheKey::operator==(const CacheKey& other) const {
+  return source_db_id == other.source_db_id && source_dict_id == other.source_dict_id &&
+         source_generation == other.source_generation &&
+         dest_db_id == other.dest_db_id && dest_dict_id == other.dest_dict_id &&
+         dest_generation == other.dest_generation &&
+         is_union_translation == other.is_union_translation &&
+         string_op_infos == other.string_op_infos;
+}
+
+size_t StringTranslationMapCache::CacheKeyHasher::operator()(const CacheKey& key) const {
+  size_t hash{0};
+  boost::hash_combine(hash, key.source_db_id);
+  boost::hash_combine(hash, key.source_dict_id);
+  boost::hash_combine(hash, key.source_generation);
+  boost::hash_combine(hash, key.dest_db_id);
+  boost::hash_combine(hash, key.dest_dict_id);
+  boost::hash_combine(hash, key.dest_generation);
+  boost::hash_combine(hash, key.is_union_translation);
+  for (const auto& string_op_info : key.string_op_infos) {
+    boost::hash_combine(hash, string_op_info.hash());
+  }
+  return hash;
+}
+
+StringTranslationMapCache& StringTranslationMapCache::instance() {
+  static StringTranslationMapCache cache;
+  return cache;
+}
+
+StringTranslationMapCache::IdMap StringTranslationMapCache::getOrBuildIntersection(
+    const StringDictionaryProxy* source_proxy,
+    const StringDictionaryProxy* dest_proxy,
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+    const std::function<IdMap()>& build_map) {
+  return getOrBuildImpl(source_proxy, dest_proxy, nullptr, string_op_infos, build_map);
+}
+
+StringTranslationMapCache::IdMap StringTranslationMapCache::getOrBuildUnion(
+    const StringDictionaryProxy* source_proxy,
+    StringDictionaryProxy* dest_proxy,
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+    const std::function<IdMap()>& build_map) {
+  return getOrBuildImpl(source_proxy, dest_proxy, dest_proxy, string_op_infos, build_map);
+}
+
+StringTranslationMapCache::IdMap StringTranslationMapCache::getOrBuildImpl(
+    const StringDictionaryProxy* source_proxy,
+    const StringDictionaryProxy* dest_proxy,
+    StringDictionaryProxy* union_dest_proxy,
+    const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+    const std::function<IdMap()>& build_map) {
+  CHECK(source_proxy);
+  CHECK(dest_proxy);
+  if (!is_cacheable_translation(source_proxy, dest_proxy)) {
+    return build_map();
+  }
+  const auto source_dict = source_proxy->getDictionary();
+  const auto dest_dict = dest_proxy->getDictionary();
+  const CacheKey key{source_dict->getDbId(),
+                     source_dict->getDictId(),
+                     source_proxy->getGeneration(),
+                     dest_dict->getDbId(),
+                     dest_dict->getDictId(),
+                     dest_proxy->getGeneration(),
+                     union_dest_proxy != nullptr,
+                     string_op_infos};
+  if (const auto entry = lookup(key, source_proxy, dest_proxy)) {
+    CHECK_GE(entry->vector_map.size(), size_t(1));
+    IdMap id_map(0, entry->vector_map.size() - 1);
+    std::copy(entry->vector_map.begin(), entry->vector_map.end(), id_map.data());
+    id_map.setNumUntranslatedStrings(entry->num_untranslated_strings);
+    id_map.setRangeStart(entry->range_start);
+    id_map.setRangeEnd(entry->range_end);
+    if (!entry->dest_transients.empty()) {
+      CHECK(union_dest_proxy);
+      // The proxy has no transients yet, so re-adding the strings in their original
+      // order assigns them the same ids the cached map refers to
+      const auto transient_ids =
+          union_dest_proxy->getOrAddTransientBulk(entry->dest_transients);
+      for (size_t i = 0; i < transient_ids.size(); ++i) {
+        CHECK_EQ(transient_ids[i], StringDictionaryProxy::transientIndexToId(i));
+      }
+    }
+    VLOG(1) << "Reused cached string translation map for string ops: "
+            << string_op_infos;
+    return id_map;
+  }
+
+  auto id_map = build_map();
+  CHECK_EQ(id_map.numTransients(), size_t(0));
+  auto entry = std::make_shared<Entry>();
+  entry->source_dict = source_proxy->getDictionaryWeakPtr();
+  entry->dest_dict = dest_proxy->getDictionaryWeakPtr();
+  entry->vector_map = id_map.getVectorMap();
+  entry->size_bytes = entry->vector_map.size() * sizeof(int32_t);
+  for (const auto transient_str : dest_proxy->getTransientVector()) {
+    entry->dest_transients.push_back(*transient_str);
+    entry->size_bytes += transient_str->size() + sizeof(std::string);
+  }
+  entry->num_untranslated_strings = id_map.numUntranslatedStrings();
+  entry->range_start = id_map.rangeStart();
+  entry->range_end = id_map.rangeEnd();
+  insert(key, std::move(entry));
+  return id_map;
+}
+
+std::shared_ptr<const StringTranslationMapCache::Entry> StringTranslationMapCache::lookup(
+    const CacheKey& key,
+    const StringDictionaryProxy* source_proxy,
+    const StringDictionaryProxy* dest_proxy) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto it = entry_index_.find(key);
+  if (it == entry_index_.end()) {
+    miss_count_++;
+    return nullptr;
+  }
+  const auto entry = it->second->second;
+  // A truncated table gets a new dictionary object with the same id, the entry must
+  // refer to the dictionaries of the proxies
+  if (entry->source_dict.lock().get() != source_proxy->getDictionary() ||
+      entry->dest_dict.lock().get() != dest_proxy->getDictionary()) {
+    evictUnlocked(it->second);
+    miss_count_++;
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  hit_count_++;
+  return entry;
+}
+
+void StringTranslationMapCache::insert(const CacheKey& key,
+                                       std::shared_ptr<const Entry> entry) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (entry->size_bytes > g_string_translation_map_cache_max_size_bytes) {
+    return;
+  }
+  auto it = entry_index_.find(key);
+  if (it != entry_index_.end()) {
+    // built concurrently by another query
+    evictUnlocked(it->second);
+  }
+  const auto max_size_bytes = g_string_translation_map_cache_max_size_bytes;
+  while (!entries_.empty() && size_bytes_ + entry->size_bytes > max_size_bytes) {
+    evictUnlocked(std::prev(entries_.end()));
+  }
+  size_bytes_ += entry->size_bytes;
+  entries_.emplace_front(key, std::move(entry));
+  entry_index_.emplace(key, entries_.begin());
+}
+
+void StringTranslationMapCache::evictUnlocked(EntryList::iterator entry_it) {
+  CHECK_GE(size_bytes_, entry_it->second->size_bytes);
+  size_bytes_ -= entry_it->second->size_bytes;
+  entry_index_.erase(entry_it->first);
+  entries_.erase(entry_it);
+}
+
+void StringTranslationMapCache::clear() {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  entries_.clear();
+  entry_index_.clear();
+  size_bytes_ = 0;
+  hit_count_ = 0;
+  miss_count_ = 0;
+}
+
+size_t StringTranslationMapCache::getHitCount() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return hit_count_;
+}
+
+size_t StringTranslationMapCache::getMissCount() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return miss_count_;
+}
+
+size_t StringTranslationMapCache::getNumEntries() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return entries_.size();
+}
+
+size_t StringTranslationMapCache::getSizeBytes() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return size_bytes_;
+}
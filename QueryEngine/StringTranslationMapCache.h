@@ -0,0 +1,128 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    StringTranslationMapCache.h
+ * @brief   Cross-query cache of string dictionary translation maps.
+ *
+ * Evaluating string operators (LOWER, REGEXP_REPLACE, ...) on a dictionary-encoded
+ * column builds a translation map over every string of the dictionary. Dictionaries are
+ * append-only, so the map only depends on the dictionaries, their generations and the
+ * chain of string operators, and can be reused by later queries instead of evaluating
+ * the operators again.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "StringDictionary/StringDictionaryProxy.h"
+#include "StringOps/StringOpInfo.h"
+
+extern bool g_enable_string_translation_map_cache;
+extern size_t g_string_translation_map_cache_max_size_bytes;
+
+class StringTranslationMapCache {
+ public:
+  using IdMap = StringDictionaryProxy::IdMap;
+
+  static StringTranslationMapCache& instance();
+
+  // Returns the intersection translation map from source_proxy to dest_proxy, copied
+  // from the cache if an earlier query built the same translation, otherwise built with
+  // build_map and cached if possible.
+  IdMap getOrBuildIntersection(
+      const StringDictionaryProxy* source_proxy,
+      const StringDictionaryProxy* dest_proxy,
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+      const std::function<IdMap()>& build_map);
+
+  // Same as above for union translations. On a cache hit the transient strings the
+  // cached translation added to its destination proxy are added to dest_proxy as well.
+  IdMap getOrBuildUnion(
+      const StringDictionaryProxy* source_proxy,
+      StringDictionaryProxy* dest_proxy,
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+      const std::function<IdMap()>& build_map);
+
+  void clear();
+
+  size_t getHitCount() const;
+  size_t getMissCount() const;
+  size_t getNumEntries() const;
+  size_t getSizeBytes() const;
+
+ private:
+  // identifies a translation by the dictionaries, their generations and the string
+  // operators, compared by value rather than by their printed form
+  struct CacheKey {
+    int32_t source_db_id;
+    int32_t source_dict_id;
+    int64_t source_generation;
+    int32_t dest_db_id;
+    int32_t dest_dict_id;
+    int64_t dest_generation;
+    bool is_union_translation;
+    std::vector<StringOps_Namespace::StringOpInfo> string_op_infos;
+
+    bool operator==(const CacheKey& other) const;
+  };
+
+  struct CacheKeyHasher {
+    size_t operator()(const CacheKey& key) const;
+  };
+
+  struct Entry {
+    std::weak_ptr<StringDictionary> source_dict;
+    std::weak_ptr<StringDictionary> dest_dict;
+    std::vector<int32_t> vector_map;
+    std::vector<std::string> dest_transients;
+    size_t num_untranslated_strings;
+    int32_t range_start;
+    int32_t range_end;
+    size_t size_bytes;
+  };
+  using EntryList = std::list<std::pair<CacheKey, std::shared_ptr<const Entry>>>;
+
+  StringTranslationMapCache() {}
+
+  // union_dest_proxy is the destination proxy of union translations, nullptr otherwise
+  IdMap getOrBuildImpl(
+      const StringDictionaryProxy* source_proxy,
+      const StringDictionaryProxy* dest_proxy,
+      StringDictionaryProxy* union_dest_proxy,
+      const std::vector<StringOps_Namespace::StringOpInfo>& string_op_infos,
+      const std::function<IdMap()>& build_map);
+
+  std::shared_ptr<const Entry> lookup(const CacheKey& key,
+                                      const StringDictionaryProxy* source_proxy,
+                                      const StringDictionaryProxy* dest_proxy);
+  void insert(const CacheKey& key, std::shared_ptr<const Entry> entry);
+  void evictUnlocked(EntryList::iterator entry_it);
+
+  // most recently used entries are at the front of the list
+  EntryList entries_;
+  std::unordered_map<CacheKey, EntryList::iterator, CacheKeyHasher> entry_index_;
+  size_t size_bytes_{0};
+  size_t hit_count_{0}, miss_count_{0};
+  mutable std::mutex cache_mutex_;
+};
@@ -16,15 +16,23 @@
 
 #include "TableOptimizer.h"
 
+#include <numeric>
+
 #include "Analyzer/Analyzer.h"
+#include "Fragmenter/FragmentDefaultValues.h"
 #include "LockMgr/LockMgr.h"
 #include "Logger/Logger.h"
+#include "QueryEngine/DeferredVacuumQueue.h"
 #include "QueryEngine/Execute.h"
 #include "Shared/misc.h"
 #include "Shared/scope.h"
 
+extern bool g_enable_snapshot_reads;
+
 // By default, when rows are deleted, vacuum fragments with a least 10% deleted rows
 float g_vacuum_min_selectivity{0.1};
+// Fragments holding less than half of the fragment size are merged
+float g_fragment_merge_max_fill{0.5};
 
 TableOptimizer::TableOptimizer(const TableDescriptor* td,
                                Executor* executor,
@@ -540,7 +548,22 @@ void TableOptimizer::vacuumFragmentsAboveMinSelectivity(
     }
   }
 
-  if (!fragments_to_vacuum.empty()) {
+  // Vacuuming compacts chunks in place under the table data write lock, which waits for
+  // running queries. With snapshot reads, neither the delete nor a deferred vacuum job,
+  // which blocks inserts for its whole run, may wait for them. The deleted rows are only
+  // marked in the deleted column, and the fragments are compacted by OPTIMIZE.
+  if (!fragments_to_vacuum.empty() && g_enable_snapshot_reads) {
+    VLOG(1) << "Leaving the vacuuming of table " << td_->tableId << " to OPTIMIZE";
+    cat_.checkpointWithAutoRollback(td_->tableId);
+  } else if (!fragments_to_vacuum.empty() && g_enable_deferred_vacuum) {
+    for (const auto& [td, fragment_ids] : fragments_to_vacuum) {
+      DeferredVacuumQueue::instance().enqueue(
+          cat_.getDatabaseId(), td_->tableId, td->tableId, fragment_ids);
+    }
+    // The deleted rows are only marked in the deleted column until the fragments are
+    // vacuumed in the background
+    cat_.checkpointWithAutoRollback(td_->tableId);
+  } else if (!fragments_to_vacuum.empty()) {
     const auto db_id = cat_.getDatabaseId();
     const auto table_lock =
         lockmgr::TableDataLockMgr::getWriteLockForTable({db_id, td_->tableId});
@@ -562,3 +585,137 @@ void TableOptimizer::vacuumFragmentsAboveMinSelectivity(
     cat_.checkpointWithAutoRollback(td_->tableId);
   }
 }
+
+void TableOptimizer::vacuumFragmentsIncrementally(
+    const TableDescriptor* td,
+    const std::set<int>& fragment_ids) const {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto db_id = cat_.getDatabaseId();
+  for (const auto fragment_id : fragment_ids) {
+    {
+      const auto table_lock =
+          lockmgr::TableDataLockMgr::getWriteLockForTable({db_id, td_->tableId});
+      const auto table_epochs = cat_.getTableEpochs(db_id, td_->tableId);
+      try {
+        vacuumFragments(td, {fragment_id});
+        cat_.checkpoint(td_->tableId);
+      } catch (...) {
+        cat_.setTableEpochsLogExceptions(db_id, table_epochs);
+        throw;
+      }
+    }
+    // vacuuming moves rows, cached hash tables and results refer to row positions
+    Executor::clearExternalCaches(true, td_, db_id);
+  }
+}
+
+void TableOptimizer::mergeUnderfilledFragments() const {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto table_id = td_->tableId;
+  const auto db_id = cat_.getDatabaseId();
+  size_t num_merged_fragments{0};
+  {
+    const auto table_lock =
+        lockmgr::TableDataLockMgr::getWriteLockForTable({db_id, table_id});
+    const auto table_epochs = cat_.getTableEpochs(db_id, table_id);
+    try {
+      for (const auto shard : cat_.getPhysicalTablesDescriptors(td_)) {
+        num_merged_fragments += mergeUnderfilledFragments(shard);
+      }
+      if (num_merged_fragments > 0) {
+        cat_.checkpoint(table_id);
+      }
+    } catch (...) {
+      cat_.setTableEpochsLogExceptions(db_id, table_epochs);
+      throw;
+    }
+  }
+  if (num_merged_fragments > 0) {
+    // merging moves rows, cached hash tables and results refer to row positions
+    Executor::clearExternalCaches(true, td_, db_id);
+  }
+}
+
+size_t TableOptimizer::mergeUnderfilledFragments(const TableDescriptor* td) const {
+  // Appending rows can drop the oldest fragments of tables with a maximum number of
+  // rows, and staged updates require disk resident tables.
+  if (td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL ||
+      td->maxRows != DEFAULT_MAX_ROWS) {
+    return 0;
+  }
+  auto fragmenter = td->fragmenter.get();
+  CHECK(fragmenter);
+  const auto table_info = fragmenter->getFragmentsForQuery();
+  int last_fragment_id{-1};
+  for (const auto& fragment : table_info.fragments) {
+    last_fragment_id = std::max(last_fragment_id, fragment.fragmentId);
+  }
+  // Rows are appended to the last fragment, which is never merged.
+  std::vector<int> fragment_ids;
+  for (const auto& fragment : table_info.fragments) {
+    if (fragment.fragmentId != last_fragment_id &&
+        fragment.getPhysicalNumTuples() < g_fragment_merge_max_fill * td->maxFragRows) {
+      fragment_ids.emplace_back(fragment.fragmentId);
+    }
+  }
+  if (fragment_ids.size() < 2) {
+    return 0;
+  }
+
+  const auto deleted_cd = cat_.getDeletedColumn(td);
+  const auto columns = cat_.getAllColumnMetadataForTable(td->tableId, false, false, true);
+  for (const auto fragment_id : fragment_ids) {
+    const auto fragment = fragmenter->getFragmentInfo(fragment_id);
+    CHECK(fragment);
+    const auto num_rows = fragment->getPhysicalNumTuples();
+    const auto& chunk_metadata_map = fragment->getChunkMetadataMapPhysical();
+    auto get_chunk = [&](const ColumnDescriptor* cd) {
+      const auto chunk_metadata_it = chunk_metadata_map.find(cd->columnId);
+      CHECK(chunk_metadata_it != chunk_metadata_map.end());
+      const auto& chunk_metadata = chunk_metadata_it->second;
+      ChunkKey chunk_key{cat_.getDatabaseId(), td->tableId, cd->columnId, fragment_id};
+      return Chunk_NS::Chunk::getChunk(cd,
+                                       &cat_.getDataMgr(),
+                                       chunk_key,
+                                       Data_Namespace::MemoryLevel::CPU_LEVEL,
+                                       0,
+                                       chunk_metadata->numBytes,
+                                       chunk_metadata->numElements);
+    };
+
+    // The fragmenter fills in the deleted and row id system columns of the appended rows
+    Fragmenter_Namespace::InsertChunks insert_chunks{
+        td->tableId, cat_.getDatabaseId(), {}, {}};
+    for (const auto cd : columns) {
+      insert_chunks.chunks[cd->columnId] = get_chunk(cd);
+    }
+    const int8_t* deleted{nullptr};
+    std::shared_ptr<Chunk_NS::Chunk> deleted_chunk;
+    if (deleted_cd) {
+      deleted_chunk = get_chunk(deleted_cd);
+      deleted = deleted_chunk->getBuffer()->getMemoryPtr();
+    }
+    for (size_t row = 0; row < num_rows; ++row) {
+      if (!deleted || !deleted[row]) {
+        insert_chunks.valid_row_indices.emplace_back(row);
+      }
+    }
+    fragmenter->insertChunksNoCheckpoint(insert_chunks);
+
+    // the rows of the fragment now live at the end of the table, empty it
+    UpdelRoll updel_roll;
+    updel_roll.catalog = &cat_;
+    updel_roll.logicalTableId = cat_.getLogicalTableId(td->tableId);
+    updel_roll.memoryLevel = Data_Namespace::MemoryLevel::CPU_LEVEL;
+    updel_roll.table_descriptor = td;
+    std::vector<uint64_t> frag_offsets(num_rows);
+    std::iota(frag_offsets.begin(), frag_offsets.end(), 0);
+    fragmenter->compactRows(
+        &cat_, td, fragment_id, frag_offsets, updel_roll.memoryLevel, updel_roll);
+    updel_roll.stageUpdate();
+  }
+  fragmenter->resetSizesFromFragments();
+  VLOG(1) << "Merged fragments: " << shared::printContainer(fragment_ids)
+          << ", table id: " << td->tableId;
+  return fragment_ids.size();
+}
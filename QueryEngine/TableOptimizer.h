@@ -72,6 +72,27 @@ class TableOptimizer {
   void vacuumFragmentsAboveMinSelectivity(
       const TableUpdateMetadata& table_update_metadata) const;
 
+  /**
+   * Vacuums the given fragments of a physical table one fragment at a time, taking the
+   * table data write lock and checkpointing for each fragment, so that queries on the
+   * table can run in between. Used by DeferredVacuumQueue.
+   */
+  void vacuumFragmentsIncrementally(const TableDescriptor* td,
+                                    const std::set<int>& fragment_ids) const;
+
+  /**
+   * @brief Merges under-filled fragments.
+   * Vacuuming leaves fragments with fewer rows than the fragment size, and every
+   * fragment is scanned by a kernel of its own. Fragments filled below the configured
+   * maximum fill ratio, other than the last one, have their visible rows appended to the
+   * end of the table and are emptied, which queries skip. The emptied fragments stay in
+   * the fragment list and their ids are never reclaimed. Note that merging changes the
+   * order of the rows. The caller must keep inserts out of the table, e.g. with a
+   * schema write lock or the insert data write lock, since the merge appends rows and
+   * checkpoints or rolls back the table.
+   */
+  void mergeUnderfilledFragments() const;
+
  private:
   DeletedColumnStats recomputeDeletedColumnMetadata(
       const TableDescriptor* td,
@@ -89,6 +110,9 @@ class TableOptimizer {
   void vacuumFragments(const TableDescriptor* td,
                        const std::set<int>& fragment_ids = {}) const;
 
+  // Returns the number of fragments merged
+  size_t mergeUnderfilledFragments(const TableDescriptor* td) const;
+
   DeletedColumnStats getDeletedColumnStats(
       const TableDescriptor* td,
       const std::set<size_t>& fragment_indexes) const;
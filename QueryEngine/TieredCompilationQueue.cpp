@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/TieredCompilationQueue.h"
+
+#include "Logger/Logger.h"
+
+bool g_enable_tiered_compilation{false};
+size_t g_tiered_compilation_max_pending_jobs{64};
+
+TieredCompilationQueue::~TieredCompilationQueue() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_ = true;
+    // the optimized code is only an improvement, pending jobs can be dropped
+    jobs_.clear();
+  }
+  jobs_cv_.notify_all();
+  if (worker_thread_.joinable()) {
+    worker_thread_.join();
+  }
+}
+
+bool TieredCompilationQueue::enqueue(const CodeCacheKey& key, Job job) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (stop_ || pending_keys_.size() >= g_tiered_compilation_max_pending_jobs ||
+        !pending_keys_.insert(key).second) {
+      return false;
+    }
+    jobs_.emplace_back(key, std::move(job));
+    if (!worker_thread_.joinable()) {
+      worker_thread_ = std::thread([this] { worker(); });
+    }
+  }
+  jobs_cv_.notify_one();
+  return true;
+}
+
+void TieredCompilationQueue::waitForPendingJobs() {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  idle_cv_.wait(lock, [this] { return pending_keys_.empty(); });
+}
+
+size_t TieredCompilationQueue::getCompletedJobCount() const {
+  std::lock_guard<std::mutex> lock(queue_mutex_);
+  return completed_job_count_;
+}
+
+void TieredCompilationQueue::worker() {
+  while (true) {
+    std::pair<CodeCacheKey, Job> job;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      jobs_cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+      if (stop_) {
+        pending_keys_.clear();
+        idle_cv_.notify_all();
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    try {
+      job.second();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Background compilation of optimized query code failed: "
+                   << e.what();
+    }
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      pending_keys_.erase(job.first);
+      completed_job_count_++;
+    }
+    idle_cv_.notify_all();
+  }
+}
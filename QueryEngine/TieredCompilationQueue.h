@@ -0,0 +1,69 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    TieredCompilationQueue.h
+ * @brief   Background thread for the optimized tier of tiered JIT compilation.
+ *
+ * With tiered compilation, a new query shape is first compiled without IR
+ * optimizations so that it can start executing right away. The fully optimized code is
+ * compiled by the jobs of this queue and swapped into the code cache once ready.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include "QueryEngine/CodeCache.h"
+
+extern bool g_enable_tiered_compilation;
+extern size_t g_tiered_compilation_max_pending_jobs;
+
+class TieredCompilationQueue {
+ public:
+  using Job = std::function<void()>;
+
+  TieredCompilationQueue() {}
+
+  ~TieredCompilationQueue();
+
+  // Schedules the job compiling the optimized code for the given key. Returns false,
+  // and drops the job, if a job for the same key is already pending or if the queue is
+  // full.
+  bool enqueue(const CodeCacheKey& key, Job job);
+
+  // Blocks until all the jobs scheduled so far have completed.
+  void waitForPendingJobs();
+
+  size_t getCompletedJobCount() const;
+
+ private:
+  void worker();
+
+  std::deque<std::pair<CodeCacheKey, Job>> jobs_;
+  std::unordered_set<CodeCacheKey, boost::hash<CodeCacheKey>> pending_keys_;
+  size_t completed_job_count_{0};
+  bool stop_{false};
+  std::thread worker_thread_;
+  mutable std::mutex queue_mutex_;
+  std::condition_variable jobs_cv_;
+  std::condition_variable idle_cv_;
+};
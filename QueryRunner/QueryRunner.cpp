@@ -37,6 +37,7 @@
 #include "Shared/SysDefinitions.h"
 #include "Shared/SystemParameters.h"
 #include "Shared/import_helpers.h"
+#include "Shared/scope.h"
 #include "TestProcessSignalHandler.h"
 #include "gen-cpp/CalciteServer.h"
 #include "include/bcrypt.h"
@@ -891,10 +892,15 @@ std::shared_ptr<ExecutionResult> QueryRunner::runSelectQuery(const std::string&
                                                   &query_str,
                                                   &co,
                                                   explain_type = this->explain_type_,
+                                                  execution_stats = execution_stats_,
                                                   &eo,
                                                   &query_state,
                                                   &result](const size_t worker_id) {
         auto executor = Executor::getExecutor(worker_id);
+        executor->setExecutionStats(execution_stats);
+        ScopeGuard reset_execution_stats = [&executor] {
+          executor->setExecutionStats(nullptr);
+        };
         // TODO The next line should be deleted since it overwrites co, but then
         // NycTaxiTest.RunSelectsEncodingDictWhereGreater fails due to co not getting
         // reset to its default values.
@@ -1105,6 +1111,27 @@ size_t QueryRunner::getNumberOfCachedItem(CacheItemStatus item_status,
     case CacheItemType::OVERLAPS_AUTO_TUNER_PARAM: {
       return get_num_cached_auto_tuner_param();
     }
+    case CacheItemType::GROUP_BY_LAYOUT_STATS: {
+      auto layout_cache = GroupByAndAggregate::getGroupByLayoutCache();
+      switch (item_status) {
+        case CacheItemStatus::ALL: {
+          return layout_cache->getCurrentNumCachedItems(
+              hash_table_type, GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER);
+        }
+        case CacheItemStatus::CLEAN_ONLY: {
+          return layout_cache->getCurrentNumCleanCachedItems(
+              hash_table_type, GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER);
+        }
+        case CacheItemStatus::DIRTY_ONLY: {
+          return layout_cache->getCurrentNumDirtyCachedItems(
+              hash_table_type, GROUP_BY_LAYOUT_CACHE_DEVICE_IDENTIFIER);
+        }
+        default: {
+          UNREACHABLE();
+          return static_cast<size_t>(0);
+        }
+      }
+    }
     default: {
       UNREACHABLE();
       return 0;
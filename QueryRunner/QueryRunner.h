@@ -32,6 +32,7 @@
 #include "QueryEngine/JoinHashTable/OverlapsJoinHashTable.h"
 #include "QueryEngine/QueryDispatchQueue.h"
 #include "QueryEngine/QueryEngine.h"
+#include "QueryEngine/QueryExecutionStats.h"
 #include "QueryEngine/QueryHint.h"
 #include "QueryEngine/QueryPlanDagExtractor.h"
 #include "QueryEngine/RelAlgDagBuilder.h"
@@ -303,6 +304,12 @@ class QueryRunner {
     explain_type_ = explain_type;
   }
 
+  // Makes the executor add the runtime statistics of the queries run by runSelectQuery()
+  // to the open step of `execution_stats`, e.g. to measure their compilation time.
+  void setExecutionStats(QueryExecutionStats* execution_stats) {
+    execution_stats_ = execution_stats;
+  }
+
  protected:
   QueryRunner(const char* db_path,
               const std::string& user,
@@ -320,6 +327,7 @@ class QueryRunner {
   static std::unique_ptr<QueryRunner> qr_instance_;
 
   ExecutorExplainType explain_type_ = ExecutorExplainType::Default;
+  QueryExecutionStats* execution_stats_{nullptr};
 
   Catalog_Namespace::DBMetadata db_metadata_;
   std::shared_ptr<Catalog_Namespace::SessionInfo> session_info_;
@@ -34,6 +34,7 @@ inline const std::string kInfoSchemaMigrationName = "information_schema_db_creat
 inline const std::string kDefaultExportDirName = "export";
 inline const std::string kDefaultImportDirName = "import";
 inline const std::string kDefaultDiskCacheDirName = "disk_cache";
+inline const std::string kDefaultCodeCacheDirName = "code_cache";
 inline const std::string kDefaultKeyFileName = "heavyai.pem";
 inline const std::string kDefaultKeyStoreDirName = "key_store";
 inline const std::string kDefaultLogDirName = "log";
@@ -20,6 +20,7 @@
 #include <mutex>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "DataMgr/Chunk/Chunk.h"
 #include "DataMgr/ChunkMetadata.h"
@@ -39,6 +40,9 @@ struct TableDescriptor;
 using MetaDataKey =
     std::pair<const TableDescriptor*, Fragmenter_Namespace::FragmentInfo*>;
 
+using ChunkReplacement =
+    std::pair<std::shared_ptr<Chunk_NS::Chunk>, std::shared_ptr<Chunk_NS::Chunk>>;
+
 // this roll records stuff that need to be roll back/forw after upd/del fails or finishes
 struct UpdelRoll {
   ~UpdelRoll() {
@@ -68,6 +72,22 @@ struct UpdelRoll {
 
   void addDirtyChunk(std::shared_ptr<Chunk_NS::Chunk> chunk, int fragment_id);
 
+  // Returns the chunk to update in place. With snapshot reads enabled, this is a copy of
+  // the stored chunk, which replaces it when the update is committed, so that the update
+  // does not wait for the queries reading the chunk.
+  std::shared_ptr<Chunk_NS::Chunk> getChunkToUpdate(const ColumnDescriptor* cd,
+                                                    const ChunkKey& chunk_key,
+                                                    const size_t num_bytes,
+                                                    const size_t num_elems);
+
+  bool updatesChunkCopies() const {
+    mapd_shared_lock<mapd_shared_mutex> lock(chunk_update_tracker_mutex);
+    return !replaced_chunks.empty();
+  }
+
+  // Pairs of a replaced chunk and the updated copy replacing it, for a fragment.
+  std::vector<ChunkReplacement> getChunkReplacements(const MetaDataKey& key) const;
+
   std::shared_ptr<ChunkMetadata> getChunkMetadata(
       const MetaDataKey& key,
       int32_t column_id,
@@ -80,7 +100,9 @@ struct UpdelRoll {
   void setNumTuple(const MetaDataKey& key, size_t num_tuple);
 
  private:
-  void updateFragmenterAndCleanupChunks();
+  void updateFragmenter();
+
+  void cleanupChunks();
 
   void initializeUnsetMetadata(const TableDescriptor* td,
                                Fragmenter_Namespace::FragmentInfo& fragment_info);
@@ -91,6 +113,9 @@ struct UpdelRoll {
   // chunks changed during this query
   std::map<ChunkKey, std::shared_ptr<Chunk_NS::Chunk>> dirty_chunks;
 
+  // stored chunks the copies among the dirty chunks replace on commit
+  std::map<ChunkKey, std::shared_ptr<Chunk_NS::Chunk>> replaced_chunks;
+
   // new FragmentInfo.numTuples
   std::map<MetaDataKey, size_t> num_tuples;
 
@@ -731,6 +731,11 @@ StringDictionary* StringDictionaryProxy::getDictionary() const noexcept {
   return string_dict_.get();
 }
 
+std::weak_ptr<StringDictionary> StringDictionaryProxy::getDictionaryWeakPtr()
+    const noexcept {
+  return string_dict_;
+}
+
 int64_t StringDictionaryProxy::getGeneration() const noexcept {
   return generation_;
 }
@@ -50,6 +50,7 @@ class StringDictionaryProxy {
 
   int32_t getOrAdd(const std::string& str) noexcept;
   StringDictionary* getDictionary() const noexcept;
+  std::weak_ptr<StringDictionary> getDictionaryWeakPtr() const noexcept;
   int64_t getGeneration() const noexcept;
 
   /**
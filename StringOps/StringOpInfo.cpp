@@ -17,6 +17,8 @@
 #include "StringOpInfo.h"
 #include "Logger/Logger.h"
 
+#include <boost/functional/hash.hpp>
+
 #include <sstream>
 
 namespace StringOps_Namespace {
@@ -140,6 +142,63 @@ std::string StringOpInfo::toString() const {
 //  return oss.str();
 //}
 
+bool StringOpInfo::operator==(const StringOpInfo& other) const {
+  if (op_kind_ != other.op_kind_ ||
+      literal_arg_map_.size() != other.literal_arg_map_.size()) {
+    return false;
+  }
+  for (auto it = literal_arg_map_.begin(), other_it = other.literal_arg_map_.begin();
+       it != literal_arg_map_.end();
+       ++it, ++other_it) {
+    const auto datum_type = it->second.first;
+    const auto& datum = it->second.second;
+    const auto& other_datum = other_it->second.second;
+    if (it->first != other_it->first || datum_type != other_it->second.first) {
+      return false;
+    }
+    const bool is_null = isLiteralArgNull(datum_type, datum);
+    if (is_null != isLiteralArgNull(datum_type, other_datum)) {
+      return false;
+    }
+    if (is_null) {
+      continue;
+    }
+    if (IS_STRING(datum_type)) {
+      if (*datum.stringval != *other_datum.stringval) {
+        return false;
+      }
+    } else {
+      CHECK(IS_INTEGER(datum_type));
+      const SQLTypeInfo ti(datum_type, false);
+      if (extract_int_type_from_datum(datum, ti) !=
+          extract_int_type_from_datum(other_datum, ti)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+size_t StringOpInfo::hash() const {
+  size_t hash = static_cast<size_t>(op_kind_);
+  for (const auto& literal_arg : literal_arg_map_) {
+    const auto datum_type = literal_arg.second.first;
+    const auto& datum = literal_arg.second.second;
+    boost::hash_combine(hash, literal_arg.first);
+    boost::hash_combine(hash, static_cast<int>(datum_type));
+    if (isLiteralArgNull(datum_type, datum)) {
+      boost::hash_combine(hash, true);
+    } else if (IS_STRING(datum_type)) {
+      boost::hash_combine(hash, *datum.stringval);
+    } else {
+      CHECK(IS_INTEGER(datum_type));
+      const SQLTypeInfo ti(datum_type, false);
+      boost::hash_combine(hash, extract_int_type_from_datum(datum, ti));
+    }
+  }
+  return hash;
+}
+
 bool StringOpInfo::isLiteralArgNull(const SQLTypes datum_type, const Datum& datum) {
   if (datum_type == kNULLT) {
     CHECK(datum.bigintval == 0);
@@ -60,6 +60,11 @@ struct StringOpInfo {
 
   std::string toString() const;
 
+  // Compare and hash the operator kind and the literal arguments by value.
+  bool operator==(const StringOpInfo& other) const;
+
+  size_t hash() const;
+
   friend std::ostream& operator<<(std::ostream& stream,
                                   const StringOpInfo& string_op_info);
 
@@ -262,6 +262,22 @@ void adjust_altered_table_files(const int32_t table_epoch,
   thread_controller.finish();
 }
 
+// Page header snapshots of the dumped table describe page headers which may be rewritten
+// on restore, and are recreated at the next checkpoint anyway.
+void delete_header_snapshots(const std::string& temp_data_dir) {
+  std::vector<boost::filesystem::path> header_snapshots;
+  boost::filesystem::recursive_directory_iterator end_it;
+  for (boost::filesystem::recursive_directory_iterator fit(temp_data_dir); fit != end_it;
+       ++fit) {
+    if (fit->path().filename() == File_Namespace::FileMgr::HEADER_SNAPSHOT_FILENAME) {
+      header_snapshots.emplace_back(fit->path());
+    }
+  }
+  for (const auto& header_snapshot : header_snapshots) {
+    boost::filesystem::remove(header_snapshot);
+  }
+}
+
 void delete_old_symlinks(const std::string& table_data_dir) {
   std::vector<boost::filesystem::path> symlinks;
   for (boost::filesystem::directory_iterator it(table_data_dir), end_it; it != end_it;
@@ -532,6 +548,7 @@ void TableArchiver::restoreTable(const Catalog_Namespace::SessionInfo& session,
   run("rm -rf " + temp_data_dir);
   run("mkdir -p " + temp_data_dir);
   run("tar " + compression + " -xvf " + get_quoted_string(archive_path), temp_data_dir);
+  delete_header_snapshots(temp_data_dir);
 
   // if table was ever altered after it was created, update column ids in chunk headers.
   if (was_table_altered) {
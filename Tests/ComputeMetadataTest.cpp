@@ -18,6 +18,7 @@
 
 #include "Catalog/Catalog.h"
 #include "DBHandlerTestHelpers.h"
+#include "QueryEngine/DeferredVacuumQueue.h"
 #include "QueryEngine/TableOptimizer.h"
 
 #include <gtest/gtest.h>
@@ -1176,6 +1177,7 @@ class OpportunisticVacuumingTest : public OptimizeTableVacuumTest {
   }
 
   void TearDown() override {
+    g_enable_deferred_vacuum = false;
     sql("drop table if exists test_table;");
     DBHandlerTestFixture::TearDown();
   }
@@ -1514,6 +1516,68 @@ TEST_F(OpportunisticVacuumingTest,
                       {{i(3)}, {i(4)}, {i(5)}, {i(6)}, {i(7)}, {i(8)}});
 }
 
+TEST_F(OpportunisticVacuumingTest, DeferredVacuum) {
+  sql("create table test_table (i int) with (fragment_size = 5, "
+      "max_rollback_epochs = 25);");
+  OptimizeTableVacuumTest::insertRange(1, 10);
+
+  g_enable_deferred_vacuum = true;
+  g_vacuum_min_selectivity = 0.35;
+  sql("delete from test_table where i <= 2 or i >= 9;");
+  sqlAndCompareResult("select * from test_table;",
+                      {{i(3)}, {i(4)}, {i(5)}, {i(6)}, {i(7)}, {i(8)}});
+
+  DeferredVacuumQueue::instance().waitForPendingJobs();
+  assertChunkContentAndMetadata(0, {3, 4, 5});
+  assertChunkContentAndMetadata(1, {6, 7, 8});
+  assertFragmentRowCount(6);
+  sqlAndCompareResult("select * from test_table;",
+                      {{i(3)}, {i(4)}, {i(5)}, {i(6)}, {i(7)}, {i(8)}});
+}
+
+TEST_F(OpportunisticVacuumingTest, DeferredVacuumWithConcurrentInserts) {
+  sql("create table test_table (i int) with (fragment_size = 5, "
+      "max_rollback_epochs = 25);");
+  OptimizeTableVacuumTest::insertRange(1, 10);
+
+  g_enable_deferred_vacuum = true;
+  g_vacuum_min_selectivity = 0.35;
+  sql("delete from test_table where i <= 2 or i >= 9;");
+  // the inserts run while the background thread compacts the first two fragments
+  OptimizeTableVacuumTest::insertRange(11, 30);
+  DeferredVacuumQueue::instance().waitForPendingJobs();
+
+  // the last fragment may have been appended to after its compaction
+  assertChunkContentAndMetadata(0, {3, 4, 5});
+  sqlAndCompareResult("select count(*), sum(i), min(i), max(i) from test_table;",
+                      {{i(26), i(443), i(3), i(30)}});
+}
+
+TEST_F(OpportunisticVacuumingTest, MergeUnderfilledFragments) {
+  sql("create table test_table (i int) with (fragment_size = 4);");
+  OptimizeTableVacuumTest::insertRange(1, 12);
+
+  sql("delete from test_table where i <= 3 or (i >= 5 and i <= 7);");
+  sql("optimize table test_table with (vacuum = 'true');");
+  assertChunkContentAndMetadata(0, {4});
+  assertChunkContentAndMetadata(1, {8});
+
+  sql("optimize table test_table with (merge_fragments = 'false');");
+  assertChunkContentAndMetadata(0, {4});
+  assertChunkContentAndMetadata(1, {8});
+
+  // The rows of the first two fragments move to a new fragment, since the last fragment
+  // is full.
+  sql("optimize table test_table with (merge_fragments = 'true');");
+  assertChunkContentAndMetadata(0, {});
+  assertChunkContentAndMetadata(1, {});
+  assertChunkContentAndMetadata(2, {9, 10, 11, 12});
+  assertChunkContentAndMetadata(3, {4, 8});
+  assertFragmentRowCount(6);
+  sqlAndCompareResult("select * from test_table order by i;",
+                      {{i(4)}, {i(8)}, {i(9)}, {i(10)}, {i(11)}, {i(12)}});
+}
+
 TEST_F(OpportunisticVacuumingTest,
        DeleteQueryAndPercentDeletedRowsAboveSelectivityThresholdAndUncappedEpoch) {
   sql("create table test_table (i int) with (fragment_size = 5);");
@@ -2017,6 +2017,73 @@ TEST_F(Itas, ItasOrderLimitOffset) {
   sql("DELETE FROM ITAS_TARGET;");
 }
 
+class InsertOnConflict : public DBHandlerTestFixture {
+ public:
+  void SetUp() override {
+    DBHandlerTestFixture::SetUp();
+    sql("DROP TABLE IF EXISTS upsert_test;");
+    sql("CREATE TABLE upsert_test (k INT, s TEXT ENCODING DICT(16), v DOUBLE) WITH "
+        "(fragment_size = 2, vacuum = 'delayed');");
+    sql("INSERT INTO upsert_test VALUES (1, 'a', 1.0), (2, 'b', 2.0), (3, 'c', 3.0);");
+  }
+
+  void TearDown() override {
+    sql("DROP TABLE IF EXISTS upsert_test;");
+    DBHandlerTestFixture::TearDown();
+  }
+};
+
+TEST_F(InsertOnConflict, DoUpdate) {
+  sql("INSERT INTO upsert_test VALUES (2, 'b', 20.0), (4, 'd', 4.0) ON CONFLICT (k) DO "
+      "UPDATE;");
+  sqlAndCompareResult("SELECT k, s, v FROM upsert_test ORDER BY k;",
+                      {{i(1), "a", 1.0},
+                       {i(2), "b", 20.0},
+                       {i(3), "c", 3.0},
+                       {i(4), "d", 4.0}});
+
+  // keys on a dictionary encoded column, the index is maintained by the earlier insert
+  sql("INSERT INTO upsert_test VALUES (5, 'a', 10.0) ON CONFLICT (s) DO UPDATE;");
+  sqlAndCompareResult("SELECT k, s, v FROM upsert_test ORDER BY k;",
+                      {{i(2), "b", 20.0},
+                       {i(3), "c", 3.0},
+                       {i(4), "d", 4.0},
+                       {i(5), "a", 10.0}});
+}
+
+TEST_F(InsertOnConflict, DoNothing) {
+  sql("INSERT INTO upsert_test VALUES (3, 'x', 30.0), (4, 'd', 4.0), (4, 'e', 40.0) ON "
+      "CONFLICT (k) DO NOTHING;");
+  sqlAndCompareResult(
+      "SELECT k, s, v FROM upsert_test ORDER BY k;",
+      {{i(1), "a", 1.0}, {i(2), "b", 2.0}, {i(3), "c", 3.0}, {i(4), "d", 4.0}});
+
+  // every row conflicts
+  sql("INSERT INTO upsert_test VALUES (1, 'z', 0.0) ON CONFLICT (k) DO NOTHING;");
+  sqlAndCompareResult("SELECT COUNT(*) FROM upsert_test;", {{i(4)}});
+}
+
+TEST_F(InsertOnConflict, AfterDelete) {
+  sql("DELETE FROM upsert_test WHERE k = 2;");
+  sql("INSERT INTO upsert_test VALUES (2, 'b', 20.0) ON CONFLICT (k) DO NOTHING;");
+  sqlAndCompareResult("SELECT k, v FROM upsert_test ORDER BY k;",
+                      {{i(1), 1.0}, {i(2), 20.0}, {i(3), 3.0}});
+}
+
+TEST_F(InsertOnConflict, Errors) {
+  queryAndAssertPartialException(
+      "INSERT INTO upsert_test VALUES (4, 'd', 4.0), (4, 'e', 5.0) ON CONFLICT (k) DO "
+      "UPDATE;",
+      "cannot affect a row a second time");
+  queryAndAssertPartialException(
+      "INSERT INTO upsert_test VALUES (4, 'd', 4.0) ON CONFLICT (v) DO UPDATE;",
+      "must be an integer or a dictionary encoded text column");
+  queryAndAssertPartialException(
+      "INSERT INTO upsert_test (s, v) VALUES ('d', 4.0) ON CONFLICT (k) DO UPDATE;",
+      "must be one of the inserted columns");
+  sqlAndCompareResult("SELECT COUNT(*) FROM upsert_test;", {{i(3)}});
+}
+
 class Export : public DBHandlerTestFixture {
  public:
   void SetUp() override {
@@ -29,8 +29,11 @@
 #include "DataMgr/BufferMgr/CpuBufferMgr/TieredCpuBufferMgr.h"
 #include "DataMgr/Chunk/Chunk.h"
 #include "DataMgr/DataMgr.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
+extern bool g_enable_numa_aware_cpu_buffer_pool;
+extern bool g_enable_snapshot_reads;
 #ifdef ENABLE_MEMKIND
 extern bool g_enable_tiered_cpu_mem;
 extern size_t g_pmem_size;
@@ -95,6 +98,145 @@ TEST_F(DataMgrTest, ReuseWithPinnedGaps) {
   writeChunkForKey({1, 1, 1, 3});                // unpinned
 }
 
+TEST_F(DataMgrTest, NumaAwareSlabPlacement) {
+  ScopeGuard reset = [orig = g_enable_numa_aware_cpu_buffer_pool] {
+    g_enable_numa_aware_cpu_buffer_pool = orig;
+  };
+  g_enable_numa_aware_cpu_buffer_pool = true;
+  resetDataMgr(2);
+  auto chunk1 = writeChunkForKey({1, 1, 1, 1});
+  auto chunk2 = writeChunkForKey({1, 1, 1, 2});
+  const auto mem_info = data_mgr_->getMemoryInfo(MemoryLevel::CPU_LEVEL);
+  ASSERT_EQ(mem_info.size(), size_t(1));
+  // single node hosts and slabs smaller than an OS page leave the placement to the OS
+  size_t num_placed_pages{0};
+  for (const auto& [numa_node, num_pages] : mem_info[0].numaNodeNumPageAllocated) {
+    EXPECT_GE(numa_node, 0);
+    num_placed_pages += num_pages;
+  }
+  EXPECT_LE(num_placed_pages, mem_info[0].numPageAllocated);
+  for (const auto& memory_data : mem_info[0].nodeMemoryData) {
+    EXPECT_EQ(memory_data.numaNode,
+              data_mgr_->getCpuBufferMgr()->getSlabNumaNode(memory_data.slabNum));
+  }
+}
+
+TEST_F(DataMgrTest, DeletePinnedBuffer) {
+  ScopeGuard reset = [orig = g_enable_snapshot_reads] {
+    g_enable_snapshot_reads = orig;
+  };
+  resetDataMgr(2);
+  auto cpu_buffer_mgr = data_mgr_->getCpuBufferMgr();
+  for (bool enable_snapshot_reads : {false, true}) {
+    g_enable_snapshot_reads = enable_snapshot_reads;
+    const ChunkKey key{1, 1, 1, enable_snapshot_reads ? 2 : 1};
+    auto chunk = writeChunkForKey(key);  // pinned
+    cpu_buffer_mgr->deleteBuffersWithPrefix(key);
+    // a pinned buffer is only detached from its chunk for snapshot reads
+    EXPECT_EQ(cpu_buffer_mgr->isBufferOnDevice(key), !enable_snapshot_reads);
+    EXPECT_EQ(chunk->getBuffer()->getMemoryPtr()[0], 1);
+  }
+}
+
+TEST_F(DataMgrTest, MaxBufferPoolBytesUsed) {
+  resetDataMgr(3);
+  data_mgr_->resetMaxBufferPoolBytesUsed(MemoryLevel::CPU_LEVEL);
+  EXPECT_EQ(data_mgr_->getMaxBufferPoolBytesUsed(MemoryLevel::CPU_LEVEL), size_t(0));
+  {
+    auto chunk1 = writeChunkForKey({1, 1, 1, 1});
+    auto chunk2 = writeChunkForKey({1, 1, 1, 2});
+  }
+  data_mgr_->deleteChunksWithPrefix({1, 1}, MemoryLevel::CPU_LEVEL);
+  // the high-water mark is kept once the buffers are gone
+  EXPECT_EQ(data_mgr_->getMaxBufferPoolBytesUsed(MemoryLevel::CPU_LEVEL),
+            2 * slab_size_);
+
+  auto chunk3 = writeChunkForKey({1, 1, 1, 3});
+  data_mgr_->resetMaxBufferPoolBytesUsed(MemoryLevel::CPU_LEVEL);
+  // and restarts from the buffers in use when reset
+  EXPECT_EQ(data_mgr_->getMaxBufferPoolBytesUsed(MemoryLevel::CPU_LEVEL), slab_size_);
+  EXPECT_EQ(data_mgr_->getMaxBufferPoolBytesUsed(MemoryLevel::GPU_LEVEL), size_t(0));
+}
+
+// Prefers the NUMA node set by the test and does not actually bind its slabs, so that
+// the NUMA aware allocation is tested the same way on hosts with a single node.
+class NumaNodeCpuBufferMgr : public Buffer_Namespace::CpuBufferMgr {
+ public:
+  NumaNodeCpuBufferMgr(const size_t slab_size,
+                       const size_t num_slabs,
+                       const size_t page_size)
+      : CpuBufferMgr(0, slab_size * num_slabs, nullptr, slab_size, slab_size, page_size) {
+  }
+
+  int32_t preferred_numa_node{-1};
+
+ protected:
+  int32_t getPreferredNumaNode() const override { return preferred_numa_node; }
+
+  bool placeSlabOnNumaNode(int8_t*, const size_t, const int32_t) override {
+    return true;
+  }
+};
+
+TEST(NumaAwareCpuBufferMgrTest, PreferredNumaNodeSlabsFirst) {
+  constexpr size_t page_size{512};
+  // two slabs of two pages each
+  NumaNodeCpuBufferMgr buffer_mgr(2 * page_size, 2, page_size);
+  auto create_buffer = [&buffer_mgr](const ChunkKey& key) {
+    buffer_mgr.createBuffer(key, page_size, page_size);
+  };
+  auto get_slab_num = [&buffer_mgr](const ChunkKey& key) {
+    const auto& slab_segments = buffer_mgr.getSlabSegments();
+    for (size_t slab_num = 0; slab_num < slab_segments.size(); ++slab_num) {
+      for (const auto& segment : slab_segments[slab_num]) {
+        if (segment.mem_status == Buffer_Namespace::USED && segment.chunk_key == key) {
+          return static_cast<int>(slab_num);
+        }
+      }
+    }
+    return -1;
+  };
+
+  buffer_mgr.preferred_numa_node = 0;
+  create_buffer({1, 1, 1, 1});
+  create_buffer({1, 1, 1, 2});
+  buffer_mgr.preferred_numa_node = 1;
+  create_buffer({1, 1, 1, 3});
+  ASSERT_EQ(buffer_mgr.getSlabSegments().size(), size_t(2));
+  EXPECT_EQ(buffer_mgr.getSlabNumaNode(0), 0);
+  EXPECT_EQ(buffer_mgr.getSlabNumaNode(1), 1);
+  EXPECT_EQ(get_slab_num({1, 1, 1, 1}), 0);
+  EXPECT_EQ(get_slab_num({1, 1, 1, 2}), 0);
+  EXPECT_EQ(get_slab_num({1, 1, 1, 3}), 1);
+
+  // the first slab has a free page again, but the slab of the preferred node comes first
+  buffer_mgr.deleteBuffer({1, 1, 1, 1});
+  create_buffer({1, 1, 1, 4});
+  EXPECT_EQ(get_slab_num({1, 1, 1, 4}), 1);
+
+  // once the slabs of the preferred node are full, those of the other nodes are used
+  create_buffer({1, 1, 1, 5});
+  EXPECT_EQ(get_slab_num({1, 1, 1, 5}), 0);
+}
+
+TEST(NumaAwareCpuBufferMgrTest, FragmentNumaNodes) {
+  constexpr size_t page_size{512};
+  NumaNodeCpuBufferMgr buffer_mgr(2 * page_size, 3, page_size);
+  // fragment 1 of table 1 is on node 0, fragment 2 mostly on node 1
+  buffer_mgr.preferred_numa_node = 0;
+  buffer_mgr.createBuffer({1, 1, 1, 1}, page_size, page_size);
+  buffer_mgr.createBuffer({1, 1, 2, 2}, page_size, page_size);
+  buffer_mgr.preferred_numa_node = 1;
+  buffer_mgr.createBuffer({1, 1, 1, 2}, page_size, page_size);
+  buffer_mgr.createBuffer({1, 1, 3, 2}, page_size, page_size);
+  buffer_mgr.createBuffer({1, 2, 1, 3}, page_size, page_size);
+
+  EXPECT_EQ(buffer_mgr.getFragmentNumaNodes({1, 1}),
+            (std::map<int, int32_t>{{1, 0}, {2, 1}}));
+  EXPECT_EQ(buffer_mgr.getFragmentNumaNodes({1, 2}), (std::map<int, int32_t>{{3, 1}}));
+  EXPECT_TRUE(buffer_mgr.getFragmentNumaNodes({1, 3}).empty());
+}
+
 #ifdef ENABLE_MEMKIND
 // Tests for the TieredCpuBufferMgr class.
 // These tests set the DataMgr to use small slabs (one page) to force situations like
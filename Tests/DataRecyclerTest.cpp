@@ -2383,6 +2383,68 @@ TEST(DataRecycler, Lazy_Cache_Invalidation) {
   drop_tables_for_string_joins();
 }
 
+TEST(DataRecycler, Group_By_Layout_Stats) {
+  ScopeGuard reset_state = [orig_adaptive_layout = g_enable_adaptive_group_by_layout] {
+    g_enable_adaptive_group_by_layout = orig_adaptive_layout;
+    GroupByAndAggregate::invalidateCache();
+    run_ddl_statement("DROP TABLE IF EXISTS gb_sparse;");
+  };
+  g_enable_adaptive_group_by_layout = true;
+  GroupByAndAggregate::invalidateCache();
+
+  run_ddl_statement("DROP TABLE IF EXISTS gb_sparse;");
+  run_ddl_statement("CREATE TABLE gb_sparse (x int);");
+  for (int x : {0, 100000, 200000}) {
+    QR::get()->runSQL("INSERT INTO gb_sparse VALUES (" + ::toString(x) + ");",
+                      ExecutorDeviceType::CPU);
+  }
+
+  const auto query = "SELECT x, COUNT(*) FROM gb_sparse GROUP BY x;";
+  for (auto dt : {ExecutorDeviceType::CPU}) {
+    // the range of x picks the perfect hash layout, whose buffer ends up almost empty
+    auto rows = QR::get()->runSQL(query, dt);
+    EXPECT_EQ(rows->getQueryMemDesc().getQueryDescriptionType(),
+              QueryDescriptionType::GroupByPerfectHash);
+    EXPECT_EQ(rows->rowCount(), size_t(3));
+    EXPECT_EQ(size_t(1),
+              QR::get()->getNumberOfCachedItem(QueryRunner::CacheItemStatus::ALL,
+                                               CacheItemType::GROUP_BY_LAYOUT_STATS));
+
+    // the next execution uses the baseline layout, sized after the recorded # groups
+    rows = QR::get()->runSQL(query, dt);
+    EXPECT_EQ(rows->getQueryMemDesc().getQueryDescriptionType(),
+              QueryDescriptionType::GroupByBaselineHash);
+    EXPECT_EQ(rows->rowCount(), size_t(3));
+    EXPECT_LT(rows->entryCount(), size_t(200001));
+
+    // the baseline execution keeps the recorded sparse perfect hash stats, so the
+    // following executions stay on the baseline layout
+    for (size_t run = 3; run <= 4; ++run) {
+      rows = QR::get()->runSQL(query, dt);
+      EXPECT_EQ(rows->getQueryMemDesc().getQueryDescriptionType(),
+                QueryDescriptionType::GroupByBaselineHash)
+          << "run " << run;
+      EXPECT_EQ(rows->rowCount(), size_t(3));
+      EXPECT_EQ(size_t(1),
+                QR::get()->getNumberOfCachedItem(QueryRunner::CacheItemStatus::ALL,
+                                                 CacheItemType::GROUP_BY_LAYOUT_STATS));
+    }
+
+    // appending to the table invalidates the recorded stats
+    QR::get()->runSQL("INSERT INTO gb_sparse VALUES (300000);", dt);
+    EXPECT_EQ(size_t(1),
+              QR::get()->getNumberOfCachedItem(QueryRunner::CacheItemStatus::DIRTY_ONLY,
+                                               CacheItemType::GROUP_BY_LAYOUT_STATS));
+    rows = QR::get()->runSQL(query, dt);
+    EXPECT_EQ(rows->getQueryMemDesc().getQueryDescriptionType(),
+              QueryDescriptionType::GroupByPerfectHash);
+    EXPECT_EQ(rows->rowCount(), size_t(4));
+    EXPECT_EQ(size_t(1),
+              QR::get()->getNumberOfCachedItem(QueryRunner::CacheItemStatus::CLEAN_ONLY,
+                                               CacheItemType::GROUP_BY_LAYOUT_STATS));
+  }
+}
+
 TEST(DataRecycler, MetricTrackerTest) {
   auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
   auto& resultset_recycler_holder = executor->getRecultSetRecyclerHolder();
@@ -23,6 +23,8 @@
 #include "../QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
 #include "../QueryEngine/Execute.h"
 #include "../QueryEngine/ExpressionRange.h"
+#include "../QueryEngine/ExternalExecutor.h"
+#include "../QueryEngine/RelAlgExecutor.h"
 #include "../QueryEngine/ResultSetReductionJIT.h"
 #include "../QueryRunner/QueryRunner.h"
 #include "../Shared/DateConverters.h"
@@ -36,10 +38,12 @@
 #include <gtest/gtest.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/any.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
 #include <cmath>
 #include <cstdio>
+#include <fstream>
 #include <random>
 
 #ifndef BASE_PATH
@@ -56,6 +60,9 @@ using namespace TestHelpers;
 bool g_aggregator{false};
 
 extern bool g_enable_smem_group_by;
+extern bool g_enable_hot_group_cache;
+extern bool g_enable_cpu_sub_tasks;
+extern size_t g_cpu_sub_task_size;
 extern bool g_allow_cpu_retry;
 extern bool g_allow_query_step_cpu_retry;
 extern bool g_enable_watchdog;
@@ -72,8 +79,13 @@ extern bool g_enable_window_functions;
 extern bool g_enable_calcite_view_optimize;
 extern bool g_enable_bump_allocator;
 extern bool g_enable_interop;
+extern size_t g_max_external_execution_input_rows;
 extern bool g_enable_union;
 extern size_t g_watchdog_none_encoded_string_translation_limit;
+extern bool g_enable_late_materialization;
+extern bool g_enable_query_step_fusion;
+extern size_t g_max_parallel_query_steps;
+extern size_t g_parallel_query_steps_memory_budget;
 extern bool g_enable_table_functions;
 
 extern size_t g_leaf_count;
@@ -10263,6 +10275,57 @@ TEST(Select, GroupByBaselineHash) {
   }
 }
 
+TEST(Select, GroupByBaselineHashHotGroupCache) {
+  ScopeGuard reset = [orig = g_enable_hot_group_cache] {
+    g_enable_hot_group_cache = orig;
+  };
+  g_enable_hot_group_cache = true;
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    // skewed keys, for which the cache stays on
+    c("SELECT cast(x as double) as key, COUNT(*), SUM(y), MIN(z) FROM test"
+      " GROUP BY key ORDER BY key;",
+      dt);
+    c("SELECT x, str, f, COUNT(*), MAX(d) FROM test GROUP BY x, str, f"
+      " ORDER BY x, str, f;",
+      dt);
+    // keys with little skew
+    c("SELECT cast(x1 as double) as key, COUNT(*), SUM(x2), MIN(x3), MAX(x4) FROM "
+      "random_test"
+      " GROUP BY key ORDER BY key;",
+      dt);
+    c("SELECT x1, x2, x3, x4, COUNT(*), MIN(x5) FROM random_test "
+      "GROUP BY x1, x2, x3, x4 ORDER BY x1, x2, x3, x4;",
+      dt);
+  }
+}
+
+TEST(Select, CpuSubTasks) {
+  ScopeGuard reset = [orig_enable = g_enable_cpu_sub_tasks,
+                      orig_size = g_cpu_sub_task_size] {
+    g_enable_cpu_sub_tasks = orig_enable;
+    g_cpu_sub_task_size = orig_size;
+  };
+  g_enable_cpu_sub_tasks = true;
+  // a few rows per sub-task, so that every fragment is split
+  g_cpu_sub_task_size = 3;
+  const auto dt = ExecutorDeviceType::CPU;
+  // projection
+  c("SELECT x + y AS a, z * 2 AS b FROM test WHERE y > 41 ORDER BY a, b;", dt);
+  c("SELECT COUNT(*) FROM (SELECT x * 3 AS a FROM test WHERE z > 0);", dt);
+  // non-grouped aggregate
+  c("SELECT COUNT(*), SUM(x), MIN(y), MAX(z), AVG(w) FROM test;", dt);
+  c("SELECT COUNT(*), SUM(x) FROM test WHERE y > 42;", dt);
+  // group by
+  c("SELECT x, COUNT(*), SUM(y) FROM test GROUP BY x ORDER BY x;", dt);
+  // hash join probe
+  c("SELECT COUNT(*), SUM(test.y) FROM test, join_test WHERE test.x = join_test.x;",
+    dt);
+  c("SELECT test.x, COUNT(*) FROM test, join_test WHERE test.x = join_test.x GROUP BY "
+    "test.x ORDER BY test.x;",
+    dt);
+}
+
 TEST(Select, GroupByConstrainedByInQueryRewrite) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -13414,6 +13477,44 @@ TEST(Select, ArrowDictionaries) {
   }
 }
 
+TEST(Select, ArrowDictionariesOfEntryRanges) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  // converts the dict encoded column in many small ranges of entries, as a streaming
+  // record batch reader does, and checks each batch only holds its own strings
+  const auto results = QR::get()->runSQL(
+      "SELECT t_unique FROM test_window_func_large_multi_frag WHERE i_1000 < 400;",
+      ExecutorDeviceType::CPU,
+      g_hoist_literals,
+      true);
+  // bulk dictionary fetches would be used for the whole result
+  ArrowResultSetConverter converter(results, {"t_unique"}, -1, 0, 1e9);
+  auto get_strings = [](const arrow::RecordBatch& batch, std::vector<std::string>& out) {
+    const auto& column = static_cast<const arrow::DictionaryArray&>(*batch.column(0));
+    const auto& dictionary =
+        static_cast<const arrow::StringArray&>(*column.dictionary());
+    for (int64_t i = 0; i < column.length(); ++i) {
+      out.push_back(column.IsNull(i) ? std::string("NULL")
+                                     : dictionary.GetString(column.GetValueIndex(i)));
+    }
+  };
+  std::vector<std::string> expected_strings;
+  get_strings(*converter.convertToArrow(), expected_strings);
+
+  constexpr size_t batch_entries{16};
+  const auto entry_count = results->entryCount();
+  ASSERT_GT(entry_count, 4 * batch_entries);
+  std::vector<std::string> streamed_strings;
+  for (size_t start_entry = 0; start_entry < entry_count; start_entry += batch_entries) {
+    const auto batch = converter.convertToArrow(
+        start_entry, std::min(start_entry + batch_entries, entry_count));
+    const auto& column = static_cast<const arrow::DictionaryArray&>(*batch->column(0));
+    EXPECT_LE(column.dictionary()->length(), batch->num_rows());
+    get_strings(*batch, streamed_strings);
+  }
+  EXPECT_EQ(streamed_strings, expected_strings);
+}
+
 TEST(Select, WatchdogTest) {
   const auto watchdog_state = g_enable_watchdog;
   g_enable_watchdog = true;
@@ -22715,6 +22816,38 @@ TEST(Select, DISABLED_Interop) {
   g_enable_interop = false;
 }
 
+TEST(Select, ExternalExecutionFallback) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset = [orig_interop = g_enable_interop,
+                      orig_max_input_rows = g_max_external_execution_input_rows] {
+    g_enable_interop = orig_interop;
+    g_max_external_execution_input_rows = orig_max_input_rows;
+  };
+  const auto reason = NativeExecutionErrorReason::WindowFunctionOutsideProjection;
+  const NativeExecutionError error("Window expression not supported in this context",
+                                   reason);
+  const auto counts = get_external_execution_fallback_counts()[reason];
+
+  // without interoperability, the native execution error is not recorded
+  g_enable_interop = false;
+  EXPECT_THROW(check_external_execution_fallback(error, 10, false),
+               NativeExecutionError);
+  EXPECT_EQ(get_external_execution_fallback_counts()[reason].refused, counts.refused);
+
+  g_enable_interop = true;
+  g_max_external_execution_input_rows = 0;
+  EXPECT_NO_THROW(check_external_execution_fallback(error, 1000, false));
+  EXPECT_THROW(check_external_execution_fallback(error, 10, true), NativeExecutionError);
+  g_max_external_execution_input_rows = 100;
+  EXPECT_NO_THROW(check_external_execution_fallback(error, 100, false));
+  EXPECT_THROW(check_external_execution_fallback(error, 101, false), std::runtime_error);
+
+  const auto new_counts = get_external_execution_fallback_counts()[reason];
+  EXPECT_EQ(new_counts.executed, counts.executed + 2);
+  EXPECT_EQ(new_counts.refused, counts.refused + 2);
+  EXPECT_EQ(new_counts.input_rows, counts.input_rows + 1100);
+}
+
 // Test https://github.com/omnisci/omniscidb/issues/463
 TEST(Select, LeftJoinDictionaryGenerationIssue463) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
@@ -23338,6 +23471,258 @@ TEST(Select, AutoQueryCaching) {
   }
 }
 
+TEST(Select, IncrementalQueryResultCaching) {
+  SKIP_ALL_ON_AGGREGATOR();
+  SKIP_WITH_TEMP_TABLES();
+
+  ScopeGuard reset_global_flag_state =
+      [orig_resulset_recycler = g_use_query_resultset_cache,
+       orig_data_recycler = g_enable_data_recycler,
+       orig_allow_query_step_skipping = g_allow_query_step_skipping,
+       orig_incremental_resultset_cache = g_enable_incremental_resultset_cache] {
+        g_use_query_resultset_cache = orig_resulset_recycler;
+        g_enable_data_recycler = orig_data_recycler;
+        g_allow_query_step_skipping = orig_allow_query_step_skipping;
+        g_enable_incremental_resultset_cache = orig_incremental_resultset_cache;
+      };
+  g_enable_data_recycler = true;
+  g_use_query_resultset_cache = true;
+  g_allow_query_step_skipping = false;
+  g_enable_incremental_resultset_cache = true;
+
+  auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID).get();
+  auto clearCache = [&executor] {
+    executor->clearMemory(MemoryLevel::CPU_LEVEL);
+    executor->getQueryPlanDagCache().clearQueryPlanCache();
+  };
+  auto resultset_recycler = executor->getRecultSetRecyclerHolder().getResultSetRecycler();
+  auto num_partial_results = [&resultset_recycler] {
+    return resultset_recycler->getCurrentNumCachedItems(
+        CacheItemType::PARTIAL_QUERY_RESULTSET, DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+  };
+  auto run_statement = [](const std::string& stmt) {
+    run_multiple_agg(stmt, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(stmt);
+  };
+  auto insert_rows = [&run_statement](const int begin, const int end) {
+    for (int i = begin; i < end; ++i) {
+      run_statement("INSERT INTO test_incremental VALUES (" + std::to_string(i % 3) +
+                    ", " + std::to_string(i) + ", 'str" + std::to_string(i % 4) + "');");
+    }
+  };
+  auto drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS test_incremental;");
+    g_sqlite_comparator.query("DROP TABLE IF EXISTS test_incremental;");
+  };
+  ScopeGuard drop_table_guard = [&drop_table] { drop_table(); };
+
+  const std::vector<std::string> queries{
+      "SELECT COUNT(*), SUM(x), MIN(x), MAX(x) FROM test_incremental;",
+      "SELECT g, COUNT(*), SUM(x), AVG(x) FROM test_incremental GROUP BY g ORDER BY g;",
+      "SELECT g, x, COUNT(*) FROM test_incremental WHERE x > 1 GROUP BY g, x ORDER BY "
+      "g, x;",
+      "SELECT s, COUNT(*) FROM test_incremental GROUP BY s ORDER BY s;"};
+  // the ids of strings computed per execution do not match across executions
+  const std::string transient_key_query{
+      "SELECT UPPER(s) AS u, SUM(x) FROM test_incremental GROUP BY u ORDER BY u;"};
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    clearCache();
+    drop_table();
+    run_ddl_statement(
+        "CREATE TABLE test_incremental (g INT, x INT, s TEXT) WITH (fragment_size = "
+        "2);");
+    g_sqlite_comparator.query("CREATE TABLE test_incremental (g INT, x INT, s TEXT);");
+    insert_rows(0, 5);
+    for (const auto& query : queries) {
+      c(query, dt);
+    }
+    c(transient_key_query, dt);
+    EXPECT_EQ(num_partial_results(), queries.size());
+
+    // appended rows fill the last fragment and new ones, and keep the partial results
+    insert_rows(5, 12);
+    EXPECT_EQ(num_partial_results(), queries.size());
+    for (const auto& query : queries) {
+      c(query, dt);
+    }
+    c(transient_key_query, dt);
+    EXPECT_EQ(num_partial_results(), queries.size());
+
+    // other modifications invalidate them
+    run_statement("UPDATE test_incremental SET x = x + 1 WHERE x = 3;");
+    EXPECT_EQ(num_partial_results(), size_t(0));
+    for (const auto& query : queries) {
+      c(query, dt);
+    }
+    run_statement("DELETE FROM test_incremental WHERE x = 7;");
+    EXPECT_EQ(num_partial_results(), size_t(0));
+    insert_rows(12, 15);
+    for (const auto& query : queries) {
+      c(query, dt);
+    }
+  }
+}
+
+TEST(Select, LateMaterialization) {
+  SKIP_ALL_ON_AGGREGATOR();
+  SKIP_WITH_TEMP_TABLES();
+
+  ScopeGuard reset_global_flag_state =
+      [orig_late_materialization = g_enable_late_materialization,
+       orig_resulset_recycler = g_use_query_resultset_cache] {
+        g_enable_late_materialization = orig_late_materialization;
+        g_use_query_resultset_cache = orig_resulset_recycler;
+      };
+  // the chunks must be loaded by the queries, not served from cached results
+  g_use_query_resultset_cache = false;
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS test_late_mat;");
+    g_sqlite_comparator.query("DROP TABLE IF EXISTS test_late_mat;");
+  };
+  run_ddl_statement("DROP TABLE IF EXISTS test_late_mat;");
+  run_ddl_statement(
+      "CREATE TABLE test_late_mat (x INT, w DOUBLE, s TEXT ENCODING NONE) WITH "
+      "(fragment_size = 2);");
+  g_sqlite_comparator.query("DROP TABLE IF EXISTS test_late_mat;");
+  g_sqlite_comparator.query("CREATE TABLE test_late_mat (x INT, w DOUBLE, s TEXT);");
+  for (int i = 0; i < 10; ++i) {
+    const auto stmt = "INSERT INTO test_late_mat VALUES (" + std::to_string(i) + ", " +
+                      std::to_string(i) + ".5, 'str" + std::to_string(i) + "');";
+    run_multiple_agg(stmt, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(stmt);
+  }
+
+  const auto cat = QR::get()->getCatalog();
+  const auto td = cat->getMetadataForTable("test_late_mat");
+  CHECK(td);
+  const auto cd = cat->getMetadataForColumn(td->tableId, "w");
+  CHECK(cd);
+  auto is_chunk_loaded = [&cat, td, cd](const int frag_id) {
+    return cat->getDataMgr().isBufferOnDevice(
+        {cat->getCurrentDB().dbId, td->tableId, cd->columnId, frag_id},
+        MemoryLevel::CPU_LEVEL,
+        0);
+  };
+
+  for (bool enable_late_materialization : {false, true}) {
+    g_enable_late_materialization = enable_late_materialization;
+    Executor::clearMemory(MemoryLevel::CPU_LEVEL);
+    // only rows of the second and the last fragment survive, and the filter cannot be
+    // resolved from the fragment metadata
+    c("SELECT x, w, s FROM test_late_mat WHERE MOD(x, 5) = 3 ORDER BY x;",
+      ExecutorDeviceType::CPU);
+    c("SELECT x, w, s FROM test_late_mat WHERE MOD(x, 5) = 3 AND w > 0;",
+      ExecutorDeviceType::CPU);
+    c("SELECT w FROM test_late_mat WHERE x < 0;", ExecutorDeviceType::CPU);
+    EXPECT_TRUE(is_chunk_loaded(1));
+    EXPECT_TRUE(is_chunk_loaded(4));
+
+    Executor::clearMemory(MemoryLevel::CPU_LEVEL);
+    run_multiple_agg("SELECT x, w, s FROM test_late_mat WHERE MOD(x, 5) = 3;",
+                     ExecutorDeviceType::CPU);
+    EXPECT_TRUE(is_chunk_loaded(1));
+    for (int frag_id : {0, 2, 3}) {
+      EXPECT_EQ(is_chunk_loaded(frag_id), !enable_late_materialization);
+    }
+  }
+}
+
+TEST(Select, ConcurrentQuerySteps) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  ScopeGuard reset_global_flag_state =
+      [orig_max_parallel_query_steps = g_max_parallel_query_steps,
+       orig_memory_budget = g_parallel_query_steps_memory_budget] {
+        g_max_parallel_query_steps = orig_max_parallel_query_steps;
+        g_parallel_query_steps_memory_budget = orig_memory_budget;
+      };
+  g_max_parallel_query_steps = 4;
+  // the independent steps are all dispatched before any of them is waited for, as many
+  // at a time as there are CPU threads
+  const size_t min_overlapping_steps = std::min(2, cpu_threads());
+  // a budget of one byte runs one step at a time, but still on the helper executors
+  for (size_t memory_budget : {g_parallel_query_steps_memory_budget, size_t(1)}) {
+    g_parallel_query_steps_memory_budget = memory_budget;
+    RelAlgExecutor::resetMaxConcurrentlyDispatchedTasks();
+    c("SELECT MAX(b0) max0, b1 % 2, MAX(b2), MAX(b3) FROM union_all_b"
+      " GROUP BY b1 % 2"
+      " UNION ALL"
+      " SELECT MAX(a0), a1 % 3, MAX(a2), MAX(a3) FROM union_all_a"
+      " GROUP BY a1 % 3"
+      " UNION ALL"
+      " SELECT c0, c1, c2, c3 FROM union_all_c"
+      " WHERE c0 < 316"
+      " ORDER BY max0;",
+      ExecutorDeviceType::CPU);
+    if (memory_budget == 1) {
+      EXPECT_EQ(RelAlgExecutor::getMaxConcurrentlyDispatchedTasks(), 1U);
+    } else {
+      EXPECT_GE(RelAlgExecutor::getMaxConcurrentlyDispatchedTasks(),
+                min_overlapping_steps);
+    }
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      RelAlgExecutor::resetMaxConcurrentlyDispatchedTasks();
+      c("SELECT COUNT(*) FROM test WHERE x = (SELECT MIN(x) FROM test) OR "
+        "y = (SELECT MAX(y) FROM test) OR z IN (SELECT z FROM test WHERE x > 7);",
+        dt);
+      if (memory_budget == 1) {
+        EXPECT_EQ(RelAlgExecutor::getMaxConcurrentlyDispatchedTasks(), 1U);
+      } else {
+        EXPECT_GE(RelAlgExecutor::getMaxConcurrentlyDispatchedTasks(),
+                  min_overlapping_steps);
+      }
+      c("SELECT x, COUNT(*) FROM test WHERE y > (SELECT AVG(y) FROM test WHERE x < "
+        "(SELECT MAX(x) FROM test)) AND z < (SELECT MAX(z) FROM test) GROUP BY x "
+        "ORDER BY x;",
+        dt);
+    }
+  }
+}
+
+TEST(Select, QueryStepFusion) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  ScopeGuard reset_global_flag_state =
+      [orig_query_step_fusion = g_enable_query_step_fusion] {
+        g_enable_query_step_fusion = orig_query_step_fusion;
+      };
+  // the filter reads a projected column, and the projects fold into one step
+  const std::vector<std::string> fused_queries{
+      "SELECT z3 FROM (SELECT z2 * 3 AS z3 FROM (SELECT z * 2 AS z2, x FROM test) t1 "
+      "WHERE x > 7) t2 ORDER BY z3;",
+      "SELECT z3, COUNT(*) FROM (SELECT z2 + 3 AS z3, y FROM (SELECT z - 2 AS z2, y "
+      "FROM test) t1 WHERE y < 43) t2 GROUP BY z3 ORDER BY z3;"};
+  // the filters read computed expressions, which would be evaluated twice per row once
+  // copied below their project, or the subqueries stop the fusion
+  const std::vector<std::string> other_queries{
+      "SELECT x2, COUNT(*) FROM (SELECT x + 1 AS x2, y FROM test) t WHERE x2 > 7 AND "
+      "y < 43 GROUP BY x2 ORDER BY x2;",
+      "SELECT SUM(d) FROM (SELECT y - x AS d FROM test) t WHERE d > 34 AND d < 36;",
+      "SELECT x, COUNT(*) FROM (SELECT x, y FROM test WHERE y IN (SELECT y FROM test "
+      "WHERE x = 7)) t GROUP BY x ORDER BY x;"};
+  std::map<std::string, std::vector<size_t>> step_counts;
+  for (bool enable_query_step_fusion : {false, true}) {
+    g_enable_query_step_fusion = enable_query_step_fusion;
+    for (const auto& queries : {fused_queries, other_queries}) {
+      for (const auto& query : queries) {
+        step_counts[query].push_back(QR::get()->getRaExecutionSequence(query).size());
+        for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+          SKIP_NO_GPU();
+          c(query, dt);
+        }
+      }
+    }
+  }
+  for (const auto& query : fused_queries) {
+    EXPECT_LT(step_counts[query][1], step_counts[query][0]) << query;
+  }
+  for (const auto& query : other_queries) {
+    EXPECT_LE(step_counts[query][1], step_counts[query][0]) << query;
+  }
+}
+
 class SubqueryTestEnv : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -23527,6 +23912,106 @@ TEST(Select, UpdatePinnedBuffers) {
   }
 }
 
+TEST(Select, PersistentCodeCache) {
+  SKIP_ALL_ON_AGGREGATOR();
+  const auto cache_path =
+      boost::filesystem::path(BASE_PATH) / "persistent_code_cache_test";
+  const auto enable_persistent_code_cache = g_enable_persistent_code_cache;
+  const auto persistent_code_cache_path = g_persistent_code_cache_path;
+  ScopeGuard reset_persistent_code_cache = [&] {
+    Executor::cpu_persistent_code_cache.clear();
+    g_enable_persistent_code_cache = enable_persistent_code_cache;
+    g_persistent_code_cache_path = persistent_code_cache_path;
+    boost::filesystem::remove_all(cache_path);
+  };
+  g_enable_persistent_code_cache = true;
+  g_persistent_code_cache_path = cache_path.string();
+  Executor::cpu_persistent_code_cache.clear();
+
+  const auto query = "SELECT x, SUM(y), COUNT(*) FROM test GROUP BY x ORDER BY x;";
+  // the first run compiles the query and persists the object code
+  Executor::cpu_code_accessor.clear();
+  const auto expected = run_multiple_agg(query, ExecutorDeviceType::CPU);
+  EXPECT_EQ(Executor::cpu_persistent_code_cache.getHitCount(), size_t(0));
+  EXPECT_GE(Executor::cpu_persistent_code_cache.getStoreCount(), size_t(1));
+
+  // dropping the in-memory code cache simulates a server restart
+  Executor::cpu_code_accessor.clear();
+  const auto actual = run_multiple_agg(query, ExecutorDeviceType::CPU);
+  EXPECT_GE(Executor::cpu_persistent_code_cache.getHitCount(), size_t(1));
+  EXPECT_EQ(Executor::cpu_persistent_code_cache.getInvalidCount(), size_t(0));
+
+  ASSERT_EQ(expected->rowCount(), actual->rowCount());
+  for (size_t i = 0; i < expected->rowCount(); ++i) {
+    const auto expected_row = expected->getNextRow(false, false);
+    const auto actual_row = actual->getNextRow(false, false);
+    ASSERT_EQ(expected_row.size(), actual_row.size());
+    for (size_t j = 0; j < expected_row.size(); ++j) {
+      EXPECT_EQ(v<int64_t>(expected_row[j]), v<int64_t>(actual_row[j]));
+    }
+  }
+
+  // corrupted entries are dropped and the code is recompiled
+  for (const auto& file : boost::filesystem::directory_iterator(cache_path)) {
+    std::ofstream out(file.path().string(), std::ios::binary | std::ios::trunc);
+    out << "not an object file";
+  }
+  Executor::cpu_code_accessor.clear();
+  const auto recompiled = run_multiple_agg(query, ExecutorDeviceType::CPU);
+  EXPECT_GE(Executor::cpu_persistent_code_cache.getInvalidCount(), size_t(1));
+  EXPECT_EQ(expected->rowCount(), recompiled->rowCount());
+}
+
+TEST(Select, TieredCompilation) {
+  SKIP_ALL_ON_AGGREGATOR();
+  const auto enable_tiered_compilation = g_enable_tiered_compilation;
+  const auto max_pending_jobs = g_tiered_compilation_max_pending_jobs;
+  ScopeGuard reset_tiered_compilation = [&] {
+    Executor::tiered_compilation_queue.waitForPendingJobs();
+    g_enable_tiered_compilation = enable_tiered_compilation;
+    g_tiered_compilation_max_pending_jobs = max_pending_jobs;
+  };
+  g_enable_tiered_compilation = true;
+
+  const auto query = "SELECT x, SUM(y), COUNT(*) FROM test GROUP BY x ORDER BY x;";
+  const auto completed_job_count =
+      Executor::tiered_compilation_queue.getCompletedJobCount();
+  const auto overwrite_count = Executor::cpu_code_accessor.getOverwriteCount();
+  // the first run executes the unoptimized code
+  Executor::cpu_code_accessor.clear();
+  const auto unoptimized = run_multiple_agg(query, ExecutorDeviceType::CPU);
+  Executor::tiered_compilation_queue.waitForPendingJobs();
+  EXPECT_GT(Executor::tiered_compilation_queue.getCompletedJobCount(),
+            completed_job_count);
+  // the optimized code has replaced the unoptimized code in the code cache
+  EXPECT_GT(Executor::cpu_code_accessor.getOverwriteCount(), overwrite_count);
+
+  // the second run picks up the optimized code from the code cache
+  const auto optimized = run_multiple_agg(query, ExecutorDeviceType::CPU);
+  ASSERT_EQ(unoptimized->rowCount(), optimized->rowCount());
+  for (size_t i = 0; i < unoptimized->rowCount(); ++i) {
+    const auto unoptimized_row = unoptimized->getNextRow(false, false);
+    const auto optimized_row = optimized->getNextRow(false, false);
+    ASSERT_EQ(unoptimized_row.size(), optimized_row.size());
+    for (size_t j = 0; j < unoptimized_row.size(); ++j) {
+      EXPECT_EQ(v<int64_t>(unoptimized_row[j]), v<int64_t>(optimized_row[j]));
+    }
+  }
+
+  // when the queue does not accept the job, the optimized code is compiled right away
+  g_tiered_compilation_max_pending_jobs = 0;
+  const auto fallback_completed_job_count =
+      Executor::tiered_compilation_queue.getCompletedJobCount();
+  const auto fallback_overwrite_count = Executor::cpu_code_accessor.getOverwriteCount();
+  Executor::cpu_code_accessor.clear();
+  const auto synchronous = run_multiple_agg(query, ExecutorDeviceType::CPU);
+  Executor::tiered_compilation_queue.waitForPendingJobs();
+  EXPECT_EQ(Executor::tiered_compilation_queue.getCompletedJobCount(),
+            fallback_completed_job_count);
+  EXPECT_EQ(Executor::cpu_code_accessor.getOverwriteCount(), fallback_overwrite_count);
+  EXPECT_EQ(unoptimized->rowCount(), synchronous->rowCount());
+}
+
 TEST(Select, Explain_Query_Session) {
   // currently, QueryRunner only supports "EXPLAIN" query to get the IR of the given
   // SELECT query but since we check "ALL" EXPLAIN-type queries before registering the
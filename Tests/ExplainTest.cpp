@@ -23,6 +23,7 @@
 
 #include "DBHandlerTestHelpers.h"
 #include "Shared/SysDefinitions.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
 #ifndef BASE_PATH
@@ -70,6 +71,29 @@ TEST_F(ExplainTest, ExplainCmds) {
                TDBException);
 }
 
+TEST_F(ExplainTest, ExplainAnalyze) {
+  sql("drop table if exists table_analyze;");
+  sql("create table table_analyze (c1 integer) with (fragment_size = 2);");
+  ScopeGuard drop_table = [] { sql("drop table if exists table_analyze;"); };
+  sql("insert into table_analyze values (1), (2), (3), (4), (5), (6);");
+
+  TQueryResult result;
+  sql(result,
+      "EXPLAIN ANALYZE SELECT c1, COUNT(*) FROM table_analyze WHERE c1 > 3 GROUP BY "
+      "c1;");
+  ASSERT_EQ(result.row_set.columns.size(), size_t(1));
+  const auto& explanation = result.row_set.columns[0].data.str_col[0];
+  EXPECT_NE(explanation.find("1 : RelCompound"), std::string::npos) << explanation;
+  // the fragment holding 1 and 2 is skipped by its metadata
+  EXPECT_NE(explanation.find("rows in: 4, rows out: 3"), std::string::npos)
+      << explanation;
+  EXPECT_NE(explanation.find("fragments scanned: 2, skipped: 1"), std::string::npos)
+      << explanation;
+
+  EXPECT_THROW(sql("EXPLAIN ANALYZE SELECT COUNT(*) FROM nonexistant_table_name;"),
+               TDBException);
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -1125,6 +1125,133 @@ TEST_F(FileMgrUnitTest, InitializeWithUncheckpointedAppendPages) {
   ASSERT_EQ(buffer->pageCount(), 1U);
 }
 
+class HeaderSnapshotTest : public FileMgrUnitTest {
+ protected:
+  void SetUp() override {
+    FileMgrUnitTest::SetUp();
+    g_enable_file_mgr_header_snapshot = true;
+  }
+
+  void TearDown() override {
+    g_enable_file_mgr_header_snapshot = false;
+    g_file_mgr_header_snapshot_interval = default_snapshot_interval_;
+    FileMgrUnitTest::TearDown();
+  }
+
+  File_Namespace::FileMgr* getFileMgr(File_Namespace::GlobalFileMgr& gfm) {
+    return dynamic_cast<File_Namespace::FileMgr*>(gfm.getFileMgr(1, 1));
+  }
+
+  bf::path getSnapshotPath() {
+    return bf::path(file_mgr_path) / "table_1_1" /
+           File_Namespace::FileMgr::HEADER_SNAPSHOT_FILENAME;
+  }
+
+  void appendAndCheckpoint(File_Namespace::GlobalFileMgr& gfm) {
+    std::vector<int8_t> write_buffer{1, 2, 3, 4};
+    gfm.getBuffer({1, 1, 1, 1})->append(write_buffer.data(), 4);
+    gfm.checkpoint(1, 1);
+  }
+
+  const size_t default_snapshot_interval_{g_file_mgr_header_snapshot_interval};
+};
+
+TEST_F(HeaderSnapshotTest, InitializeFromSnapshot) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  { auto temp_gfm = initializeGFM(fsi, 2); }
+  ASSERT_TRUE(bf::exists(getSnapshotPath()));
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  ASSERT_TRUE(getFileMgr(gfm)->isInitializedFromHeaderSnapshot());
+  auto buffer = dynamic_cast<File_Namespace::FileBuffer*>(gfm.getBuffer({1, 1, 1, 1}));
+  ASSERT_EQ(buffer->pageCount(), 2U);
+  std::vector<int8_t> read_buffer(buffer->size());
+  buffer->read(read_buffer.data(), buffer->size());
+  for (size_t i = 0; i < read_buffer.size(); ++i) {
+    ASSERT_EQ(read_buffer[i], static_cast<int8_t>(i % 4 + 1));
+  }
+}
+
+TEST_F(HeaderSnapshotTest, UncheckpointedFreedPageInvalidatesSnapshot) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  {
+    auto temp_gfm = initializeGFM(fsi, 2);
+    auto buffer =
+        dynamic_cast<File_Namespace::FileBuffer*>(temp_gfm->getBuffer({1, 1, 1, 1}));
+    buffer->freePage(buffer->getMultiPage().front().current().page);
+    ASSERT_FALSE(bf::exists(getSnapshotPath()));
+  }
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  ASSERT_FALSE(getFileMgr(gfm)->isInitializedFromHeaderSnapshot());
+  auto buffer = gfm.getBuffer({1, 1, 1, 1});
+  ASSERT_EQ(buffer->pageCount(), 2U);
+}
+
+TEST_F(HeaderSnapshotTest, UncheckpointedAppendInvalidatesSnapshot) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  std::vector<int8_t> write_buffer{1, 2, 3, 4};
+  {
+    auto temp_gfm = initializeGFM(fsi, 1);
+    auto buffer =
+        dynamic_cast<File_Namespace::FileBuffer*>(temp_gfm->getBuffer({1, 1, 1, 1}));
+    buffer->append(write_buffer.data(), 4);
+    ASSERT_FALSE(bf::exists(getSnapshotPath()));
+  }
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  ASSERT_FALSE(getFileMgr(gfm)->isInitializedFromHeaderSnapshot());
+  auto buffer = dynamic_cast<File_Namespace::FileBuffer*>(gfm.getBuffer({1, 1, 1, 1}));
+  ASSERT_EQ(buffer->pageCount(), 1U);
+}
+
+TEST_F(HeaderSnapshotTest, CorruptedSnapshot) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  { auto temp_gfm = initializeGFM(fsi, 2); }
+  {
+    std::fstream snapshot_file(getSnapshotPath().string(),
+                               std::ios::in | std::ios::out | std::ios::binary);
+    snapshot_file.seekp(-1, std::ios::end);
+    snapshot_file.put(0x7f);
+  }
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  ASSERT_FALSE(getFileMgr(gfm)->isInitializedFromHeaderSnapshot());
+  auto buffer = gfm.getBuffer({1, 1, 1, 1});
+  ASSERT_EQ(buffer->pageCount(), 2U);
+}
+
+TEST_F(HeaderSnapshotTest, CheckpointWithoutChangesKeepsSnapshot) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  {
+    auto temp_gfm = initializeGFM(fsi, 2);
+    ASSERT_EQ(getFileMgr(*temp_gfm)->getHeaderSnapshotWriteCount(), 1U);
+    temp_gfm->checkpoint(1, 1);
+    temp_gfm->checkpoint(1, 1);
+    ASSERT_EQ(getFileMgr(*temp_gfm)->getHeaderSnapshotWriteCount(), 1U);
+  }
+  // The snapshot taken two checkpoints ago is still used.
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  ASSERT_TRUE(getFileMgr(gfm)->isInitializedFromHeaderSnapshot());
+  ASSERT_EQ(gfm.getBuffer({1, 1, 1, 1})->pageCount(), 2U);
+}
+
+TEST_F(HeaderSnapshotTest, SnapshotInterval) {
+  g_file_mgr_header_snapshot_interval = 3;
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  {
+    auto temp_gfm = initializeGFM(fsi, 1);
+    auto file_mgr = getFileMgr(*temp_gfm);
+    ASSERT_EQ(file_mgr->getHeaderSnapshotWriteCount(), 1U);
+    appendAndCheckpoint(*temp_gfm);
+    appendAndCheckpoint(*temp_gfm);
+    ASSERT_EQ(file_mgr->getHeaderSnapshotWriteCount(), 1U);
+    ASSERT_FALSE(bf::exists(getSnapshotPath()));
+    appendAndCheckpoint(*temp_gfm);
+    ASSERT_EQ(file_mgr->getHeaderSnapshotWriteCount(), 2U);
+    ASSERT_TRUE(bf::exists(getSnapshotPath()));
+  }
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  ASSERT_TRUE(getFileMgr(gfm)->isInitializedFromHeaderSnapshot());
+  ASSERT_EQ(gfm.getBuffer({1, 1, 1, 1})->pageCount(), 2U);
+}
+
 class RebrandMigrationTest : public FileMgrUnitTest {
  protected:
   void setFileMgrVersion(int32_t version_number) {
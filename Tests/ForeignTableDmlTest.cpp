@@ -45,6 +45,7 @@ extern bool g_enable_fsi;
 extern bool g_enable_s3_fsi;
 extern bool g_enable_seconds_refresh;
 extern bool g_allow_s3_server_privileges;
+extern bool g_enable_foreign_table_filter_pushdown;
 extern std::optional<size_t> g_detect_test_sample_size;
 
 std::string test_binary_file_path;
@@ -957,6 +958,14 @@ class DataTypeFragmentSizeAndDataWrapperTest
   }
 
   std::string fragmentSizeStr() { return std::to_string(fragment_size_); }
+
+  size_t getSkippedFragmentCount() {
+    return getCatalog()
+        .getDataMgr()
+        .getPersistentStorageMgr()
+        ->getForeignStorageMgr()
+        ->getSkippedFragmentCount();
+  }
 };
 
 class RowGroupAndFragmentSizeSelectQueryTest
@@ -4699,6 +4708,100 @@ TEST_P(RowGroupAndFragmentSizeSelectQueryTest, Filter) {
   assertResultSetEqual({{i(5), i(7), i(10), -1.}, {i(6), i(8), i(1), -100.}}, result);
 }
 
+TEST_P(RowGroupAndFragmentSizeSelectQueryTest, RowGroupStatisticsFilter) {
+  ScopeGuard reset = [orig = g_enable_foreign_table_filter_pushdown] {
+    g_enable_foreign_table_filter_pushdown = orig;
+  };
+  g_enable_foreign_table_filter_pushdown = true;
+  auto param = GetParam();
+  int64_t row_group_size = param.first;
+  int64_t fragment_size = param.second;
+  std::stringstream filename_stream;
+  filename_stream << "example_row_group_size." << row_group_size;
+  const auto& query =
+      getCreateForeignTableQuery("(a BIGINT, b BIGINT, c BIGINT, d DOUBLE)",
+                                 {{"fragment_size", std::to_string(fragment_size)}},
+                                 filename_stream.str(),
+                                 "parquet");
+  sql(query);
+
+  {
+    TQueryResult result;
+    sql(result, "SELECT a FROM " + default_table_name + " WHERE c = 8;");
+    assertResultSetEqual({{i(3)}}, result);
+  }
+
+  {
+    TQueryResult result;
+    sql(result,
+        "SELECT a FROM " + default_table_name + " WHERE c < 7 AND d < 0 ORDER BY a;");
+    assertResultSetEqual({{i(6)}}, result);
+  }
+
+  {
+    TQueryResult result;
+    sql(result, "SELECT COUNT(*) FROM " + default_table_name + " WHERE c > 10;");
+    assertResultSetEqual({{i(0)}}, result);
+  }
+
+  {
+    // the last fragment holds c = 10 and c = 1, so only its row group statistics can
+    // rule out c = 5 when it spans several row groups
+    const auto skipped_fragment_count = getSkippedFragmentCount();
+    TQueryResult result;
+    sql(result, "SELECT COUNT(*) FROM " + default_table_name + " WHERE c = 5;");
+    assertResultSetEqual({{i(0)}}, result);
+    if (row_group_size < fragment_size) {
+      EXPECT_GT(getSkippedFragmentCount(), skipped_fragment_count);
+    } else {
+      EXPECT_EQ(getSkippedFragmentCount(), skipped_fragment_count);
+    }
+  }
+}
+
+TEST_P(RowGroupAndFragmentSizeSelectQueryTest, RowGroupStatisticsStringFilter) {
+  ScopeGuard reset = [orig = g_enable_foreign_table_filter_pushdown] {
+    g_enable_foreign_table_filter_pushdown = orig;
+  };
+  g_enable_foreign_table_filter_pushdown = true;
+  auto param = GetParam();
+  int64_t row_group_size = param.first;
+  int64_t fragment_size = param.second;
+  std::stringstream filename_stream;
+  filename_stream << "example_1_row_group_size." << row_group_size;
+  const auto& query =
+      getCreateForeignTableQuery("(t TEXT, i INTEGER)",
+                                 {{"fragment_size", std::to_string(fragment_size)}},
+                                 filename_stream.str(),
+                                 "parquet");
+  sql(query);
+
+  {
+    TQueryResult result;
+    sql(result, "SELECT t FROM " + default_table_name + " WHERE t = 'aa';");
+    assertResultSetEqual({{"aa"}}, result);
+  }
+
+  {
+    // fragment metadata has no range for strings, every fragment is skipped by the
+    // data wrapper
+    const auto skipped_fragment_count = getSkippedFragmentCount();
+    TQueryResult result;
+    sql(result, "SELECT COUNT(*) FROM " + default_table_name + " WHERE t = 'b';");
+    assertResultSetEqual({{i(0)}}, result);
+    EXPECT_GT(getSkippedFragmentCount(), skipped_fragment_count);
+  }
+
+  {
+    g_enable_foreign_table_filter_pushdown = false;
+    const auto skipped_fragment_count = getSkippedFragmentCount();
+    TQueryResult result;
+    sql(result, "SELECT COUNT(*) FROM " + default_table_name + " WHERE t = 'b';");
+    assertResultSetEqual({{i(0)}}, result);
+    EXPECT_EQ(getSkippedFragmentCount(), skipped_fragment_count);
+  }
+}
+
 using namespace foreign_storage;
 class ForeignStorageCacheQueryTest : public ForeignTableTest {
  protected:
@@ -360,6 +360,67 @@ TEST(Ordering, Triple) {
   }
 }
 
+TEST(Ordering, CostBased) {
+  const auto enable_cost_based_join_ordering = g_enable_cost_based_join_ordering;
+  ScopeGuard reset_cost_based_join_ordering = [enable_cost_based_join_ordering] {
+    g_enable_cost_based_join_ordering = enable_cost_based_join_ordering;
+  };
+  g_enable_cost_based_join_ordering = true;
+
+  // Table with one fragment and the given [min, max] range for each of its columns.
+  auto make_table_info = [](const size_t num_tuples,
+                            const std::vector<std::pair<int32_t, int32_t>>& ranges) {
+    Fragmenter_Namespace::FragmentInfo fragment;
+    fragment.setPhysicalNumTuples(num_tuples);
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      auto chunk_metadata = std::make_shared<ChunkMetadata>();
+      chunk_metadata->sqlType = SQLTypeInfo{kINT, true};
+      chunk_metadata->numElements = num_tuples;
+      chunk_metadata->fillChunkStats(ranges[i].first, ranges[i].second, false);
+      fragment.setChunkMetadata(i + 1, chunk_metadata);
+    }
+    InputTableInfo table_info;
+    table_info.table_id = 1;
+    table_info.info.fragments.push_back(fragment);
+    table_info.info.setPhysicalNumTuples(num_tuples);
+    return table_info;
+  };
+
+  // Star join of a fact table (nest level 2) with a large dimension table (nest level 0)
+  // and a small dimension table with a selective filter (nest level 1). The filtered
+  // dimension table must be joined first, even though it is the smaller one.
+  {
+    std::vector<InputTableInfo> viti{make_table_info(100000, {{0, 99999}}),
+                                     make_table_info(1000, {{0, 999}, {0, 999}}),
+                                     make_table_info(1000000, {{0, 99999}, {0, 999}})};
+
+    SQLTypeInfo ti{kINT, true};
+    auto big_dim_key = std::make_shared<Analyzer::ColumnVar>(ti, 1, 1, 0);
+    auto small_dim_key = std::make_shared<Analyzer::ColumnVar>(ti, 1, 1, 1);
+    auto small_dim_attr = std::make_shared<Analyzer::ColumnVar>(ti, 1, 2, 1);
+    auto fact_big_dim_key = std::make_shared<Analyzer::ColumnVar>(ti, 1, 1, 2);
+    auto fact_small_dim_key = std::make_shared<Analyzer::ColumnVar>(ti, 1, 2, 2);
+    Datum filter_value;
+    filter_value.intval = 5;
+    auto filter_literal = std::make_shared<Analyzer::Constant>(ti, false, filter_value);
+
+    auto filter = std::make_shared<Analyzer::BinOper>(
+        kBOOLEAN, kEQ, kONE, small_dim_attr, filter_literal);
+    auto op1 = std::make_shared<Analyzer::BinOper>(
+        kBOOLEAN, kEQ, kONE, fact_big_dim_key, big_dim_key);
+    auto op2 = std::make_shared<Analyzer::BinOper>(
+        kBOOLEAN, kEQ, kONE, fact_small_dim_key, small_dim_key);
+
+    JoinQualsPerNestingLevel nesting_levels;
+    nesting_levels.push_back(JoinCondition{{filter}, JoinType::INNER});
+    nesting_levels.push_back(JoinCondition{{op1, op2}, JoinType::INNER});
+
+    auto input_permutation = get_node_input_permutation(nesting_levels, viti, nullptr);
+    decltype(input_permutation) expected_input_permutation{2, 1, 0};
+    ASSERT_EQ(expected_input_permutation, input_permutation);
+  }
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
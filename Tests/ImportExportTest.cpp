@@ -162,6 +162,45 @@ TEST(Detect, Numeric) {
   d(kTIME, "1.22.22");
 }
 
+TEST(DelimitedParser, LongFields) {
+  // fields and quoted sections spanning several of the blocks scanned at once
+  const std::string long_field(100, 'x');
+  const std::string buffer = long_field + "," + "\"" + long_field + ",\"\"" +
+                             long_field + "\"" + "\n" + long_field + ",a\n";
+  import_export::CopyParams copy_params;
+  const char* buffer_end = buffer.data() + buffer.size();
+  std::vector<std::string_view> row;
+  std::vector<std::unique_ptr<char[]>> tmp_buffers;
+  bool try_single_thread{false};
+  auto p = import_export::delimited_parser::get_row(buffer.data(),
+                                                    buffer_end,
+                                                    buffer_end,
+                                                    copy_params,
+                                                    nullptr,
+                                                    row,
+                                                    tmp_buffers,
+                                                    try_single_thread,
+                                                    false);
+  ASSERT_EQ(2U, row.size());
+  EXPECT_EQ(long_field, row[0]);
+  EXPECT_EQ(long_field + ",\"" + long_field, row[1]);
+  EXPECT_FALSE(try_single_thread);
+
+  row.clear();
+  import_export::delimited_parser::get_row(p + 1,
+                                           buffer_end,
+                                           buffer_end,
+                                           copy_params,
+                                           nullptr,
+                                           row,
+                                           tmp_buffers,
+                                           try_single_thread,
+                                           false);
+  ASSERT_EQ(2U, row.size());
+  EXPECT_EQ(long_field, row[0]);
+  EXPECT_EQ("a", row[1]);
+}
+
 class ImportExportTestBase : public DBHandlerTestFixture {
  protected:
   void SetUp() override { DBHandlerTestFixture::SetUp(); }
@@ -2361,6 +2400,23 @@ TEST_F(ImportTest, One_csv_file) {
   EXPECT_TRUE(importTestLocal("trip_data_dir/csv/trip_data_9.csv", 100, 1.0));
 }
 
+TEST_F(ImportTest, One_csv_file_stage_times) {
+  // stage times are only recorded by the legacy delimited importer
+  ScopeGuard reset = [orig = g_enable_legacy_delimited_import] {
+    g_enable_legacy_delimited_import = orig;
+  };
+  g_enable_legacy_delimited_import = true;
+  const std::string file_name{"trip_data_9.csv"};
+  EXPECT_TRUE(importTestLocal("trip_data_dir/csv/" + file_name, 100, 1.0));
+  const auto import_status = import_export::Importer::get_import_status(file_name);
+  EXPECT_EQ(import_status.bytes_read,
+            boost::filesystem::file_size(
+                "../../Tests/Import/datafiles/trip_data_dir/csv/" + file_name));
+  EXPECT_GT(import_status.read_time.count(), size_t(0));
+  EXPECT_GT(import_status.parse_time.count(), size_t(0));
+  EXPECT_GT(import_status.load_time.count(), size_t(0));
+}
+
 TEST_F(ImportTest, tsv_file) {
   // Test the delimeter option
   EXPECT_TRUE(importTestCommon(
@@ -0,0 +1,717 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    QueryEngineBenchmark.cpp
+ * @brief   Microbenchmarks for the runtime hot paths of the query engine.
+ *
+ * Every benchmark runs on synthetic data built in memory, so that regressions in the
+ * group by and hash join runtime functions, the result set reduction, sort and
+ * columnarization and the chunk encoders can be measured without loading tables.
+ * Benchmarks taking a thread count run with `g_cpu_threads_override` set to it.
+ */
+
+#include "TestHelpers.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <future>
+#include <numeric>
+#include <random>
+
+#include "DataMgr/AbstractBuffer.h"
+#include "DataMgr/Encoder.h"
+#include "QueryEngine/ColumnarResults.h"
+#include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/JoinHashTable/Runtime/HashJoinKeyHandlers.h"
+#include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryEngine/RuntimeFunctions.h"
+#include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
+#include "Shared/thread_count.h"
+#include "Tests/ResultSetTestUtils.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+
+extern size_t g_parallel_top_min;
+
+namespace {
+
+std::once_flag setup_flag;
+void global_setup() {
+  TestHelpers::init_logger_stderr_only();
+  QR::init(BASE_PATH);
+}
+
+constexpr size_t kSeed{42};
+
+class QueryEngineFixture : public benchmark::Fixture {
+ public:
+  void SetUp(const ::benchmark::State& state) override {
+    std::call_once(setup_flag, global_setup);
+  }
+
+  void TearDown(const ::benchmark::State& state) override {
+    // noop
+  }
+};
+
+// Runs the benchmark body with the CPU thread count used by the query engine set to
+// `thread_count`, restoring the previous value on exit.
+ScopeGuard override_cpu_threads(const size_t thread_count) {
+  const auto saved_override = g_cpu_threads_override;
+  g_cpu_threads_override = thread_count;
+  return [saved_override] { g_cpu_threads_override = saved_override; };
+}
+
+void sizes_and_thread_counts(benchmark::internal::Benchmark* b) {
+  for (const int64_t num_entries : {1 << 14, 1 << 18, 1 << 22}) {
+    for (const int64_t thread_count : {1, 4, 16}) {
+      b->Args({num_entries, thread_count});
+    }
+  }
+}
+
+void skews_with_and_without_hot_cache(benchmark::internal::Benchmark* b) {
+  for (const int64_t num_groups : {1 << 12, 1 << 20}) {
+    for (const int64_t heavy_hitter_percent : {0, 60, 90}) {
+      for (const int64_t use_hot_cache : {0, 1}) {
+        b->Args({num_groups, heavy_hitter_percent, use_hot_cache});
+      }
+    }
+  }
+}
+
+std::vector<int32_t> make_shuffled_keys(const size_t num_keys) {
+  std::vector<int32_t> keys(num_keys);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(kSeed));
+  return keys;
+}
+
+std::vector<int64_t> make_random_keys(const size_t num_keys, const int64_t cardinality) {
+  std::vector<int64_t> keys(num_keys);
+  std::mt19937_64 gen(kSeed);
+  std::uniform_int_distribution<int64_t> dist(0, cardinality - 1);
+  for (auto& key : keys) {
+    key = dist(gen);
+  }
+  return keys;
+}
+
+// Runs `fill_func(thread_idx, thread_count)` on `thread_count` threads, the way the
+// hash table builders split the work, and returns the first error.
+template <typename FILL_FUNC>
+int run_on_threads(const size_t thread_count, FILL_FUNC fill_func) {
+  std::vector<std::future<int>> workers;
+  for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+    workers.emplace_back(
+        std::async(std::launch::async, fill_func, thread_idx, thread_count));
+  }
+  int err{0};
+  for (auto& worker : workers) {
+    const auto worker_err = worker.get();
+    err = err ? err : worker_err;
+  }
+  return err;
+}
+
+}  // namespace
+
+// Group by runtime: get_group_value_fast (perfect hash) and get_group_value (baseline
+// hash) on random keys. Args: number of rows, number of distinct groups.
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, GetGroupValueFast)(benchmark::State& state) {
+  const size_t num_rows = state.range(0);
+  const int64_t num_groups = state.range(1);
+  const auto keys = make_random_keys(num_rows, num_groups);
+  const uint32_t row_size_quad = 2;
+  std::vector<int64_t> groups_buffer(num_groups * row_size_quad);
+  for (auto _ : state) {
+    std::fill(groups_buffer.begin(), groups_buffer.end(), EMPTY_KEY_64);
+    for (const auto key : keys) {
+      auto value_slot =
+          get_group_value_fast(groups_buffer.data(), key, 0, 0, row_size_quad);
+      ++*value_slot;
+    }
+    benchmark::DoNotOptimize(groups_buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, GetGroupValue)(benchmark::State& state) {
+  const size_t num_rows = state.range(0);
+  const int64_t num_groups = state.range(1);
+  const auto keys = make_random_keys(num_rows, num_groups);
+  const uint32_t key_count = 2;
+  const uint32_t row_size_quad = key_count + 1;
+  // Baseline hash group by buffers are sized for a load factor of at most one half.
+  const uint32_t entry_count = 2 * num_groups;
+  std::vector<int64_t> groups_buffer(size_t(entry_count) * row_size_quad);
+  for (auto _ : state) {
+    std::fill(groups_buffer.begin(), groups_buffer.end(), EMPTY_KEY_64);
+    for (const auto key : keys) {
+      const int64_t group_key[key_count] = {key, key >> 3};
+      auto value_slot = get_group_value(groups_buffer.data(),
+                                        entry_count,
+                                        group_key,
+                                        key_count,
+                                        sizeof(int64_t),
+                                        row_size_quad);
+      CHECK(value_slot);
+      ++*value_slot;
+    }
+    benchmark::DoNotOptimize(groups_buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, GetGroupValueFast)
+    ->ArgPair(1 << 20, 1 << 4)
+    ->ArgPair(1 << 20, 1 << 12)
+    ->ArgPair(1 << 20, 1 << 20)
+    ->ArgPair(1 << 24, 1 << 22)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, GetGroupValue)
+    ->ArgPair(1 << 20, 1 << 4)
+    ->ArgPair(1 << 20, 1 << 12)
+    ->ArgPair(1 << 20, 1 << 20)
+    ->ArgPair(1 << 24, 1 << 22)
+    ->Unit(benchmark::kMillisecond);
+
+// Baseline hash group by on keys of which a given share are the same heavy hitter, with
+// and without the hot group cache. Args: number of distinct groups, percentage of rows
+// with the heavy hitter key, whether to use the hot group cache.
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, GetGroupValueSkewed)(benchmark::State& state) {
+  const size_t num_rows = 1 << 22;
+  const int64_t num_groups = state.range(0);
+  const int64_t heavy_hitter_percent = state.range(1);
+  const bool use_hot_cache = state.range(2);
+  auto keys = make_random_keys(num_rows, num_groups);
+  std::mt19937_64 gen(kSeed);
+  std::uniform_int_distribution<int64_t> percent_dist(0, 99);
+  for (auto& key : keys) {
+    if (percent_dist(gen) < heavy_hitter_percent) {
+      key = 0;
+    }
+  }
+  const uint32_t key_count = 2;
+  const uint32_t row_size_quad = key_count + 1;
+  const uint32_t entry_count = 2 * num_groups;
+  std::vector<int64_t> groups_buffer(size_t(entry_count) * row_size_quad +
+                                     HOT_GROUP_CACHE_QW);
+  const auto get_group_value_func =
+      use_hot_cache ? get_group_value_with_hot_cache : get_group_value;
+  for (auto _ : state) {
+    std::fill(
+        groups_buffer.begin(), groups_buffer.end() - HOT_GROUP_CACHE_QW, EMPTY_KEY_64);
+    std::fill(groups_buffer.end() - HOT_GROUP_CACHE_QW, groups_buffer.end(), 0);
+    for (const auto key : keys) {
+      const int64_t group_key[key_count] = {key, key >> 3};
+      auto value_slot = get_group_value_func(groups_buffer.data(),
+                                             entry_count,
+                                             group_key,
+                                             key_count,
+                                             sizeof(int64_t),
+                                             row_size_quad);
+      CHECK(value_slot);
+      ++*value_slot;
+    }
+    benchmark::DoNotOptimize(groups_buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, GetGroupValueSkewed)
+    ->Apply(skews_with_and_without_hot_cache)
+    ->Unit(benchmark::kMillisecond);
+
+// Hash join runtime: building a perfect one-to-one hash table over an INT column and a
+// baseline hash table over a pair of INT columns, with 32 and 64 bit keys. Args: number
+// of rows in the inner table, number of build threads.
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, FillHashJoinBuff)(benchmark::State& state) {
+  const size_t num_elems = state.range(0);
+  const size_t thread_count = state.range(1);
+  const auto keys = make_shuffled_keys(num_elems);
+  const JoinChunk chunk{reinterpret_cast<const int8_t*>(keys.data()), num_elems};
+  const JoinColumn join_column{reinterpret_cast<const int8_t*>(&chunk),
+                               sizeof(JoinChunk),
+                               1,
+                               num_elems,
+                               sizeof(int32_t)};
+  const JoinColumnTypeInfo type_info{sizeof(int32_t),
+                                     0,
+                                     static_cast<int64_t>(num_elems) - 1,
+                                     inline_int_null_value<int32_t>(),
+                                     false,
+                                     inline_int_null_value<int32_t>(),
+                                     ColumnType::Signed};
+  std::vector<int32_t> hash_buff(num_elems);
+  for (auto _ : state) {
+    const auto err = run_on_threads(
+        thread_count, [&](const int32_t cpu_thread_idx, const int32_t cpu_thread_count) {
+          init_hash_join_buff(
+              hash_buff.data(), num_elems, -1, cpu_thread_idx, cpu_thread_count);
+          return 0;
+        });
+    CHECK_EQ(err, 0);
+    const auto fill_err = run_on_threads(
+        thread_count, [&](const int32_t cpu_thread_idx, const int32_t cpu_thread_count) {
+          return fill_hash_join_buff(hash_buff.data(),
+                                     -1,
+                                     false,
+                                     join_column,
+                                     type_info,
+                                     nullptr,
+                                     0,
+                                     cpu_thread_idx,
+                                     cpu_thread_count);
+        });
+    CHECK_EQ(fill_err, 0);
+    benchmark::DoNotOptimize(hash_buff.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_elems);
+}
+
+void run_baseline_hash_join_fill_benchmark(benchmark::State& state,
+                                           const size_t key_component_width) {
+  const size_t num_elems = state.range(0);
+  const size_t thread_count = state.range(1);
+  const size_t key_component_count = 2;
+  const auto first_keys = make_shuffled_keys(num_elems);
+  std::vector<int32_t> second_keys(num_elems);
+  std::transform(first_keys.begin(),
+                 first_keys.end(),
+                 second_keys.begin(),
+                 [](const int32_t key) { return key >> 3; });
+  const std::vector<JoinChunk> chunks{
+      {reinterpret_cast<const int8_t*>(first_keys.data()), num_elems},
+      {reinterpret_cast<const int8_t*>(second_keys.data()), num_elems}};
+  std::vector<JoinColumn> join_columns;
+  std::vector<JoinColumnTypeInfo> type_infos;
+  for (const auto& chunk : chunks) {
+    join_columns.push_back({reinterpret_cast<const int8_t*>(&chunk),
+                            sizeof(JoinChunk),
+                            1,
+                            num_elems,
+                            sizeof(int32_t)});
+    type_infos.push_back({sizeof(int32_t),
+                          0,
+                          static_cast<int64_t>(num_elems) - 1,
+                          inline_int_null_value<int32_t>(),
+                          false,
+                          inline_int_null_value<int32_t>(),
+                          ColumnType::Signed});
+  }
+  const GenericKeyHandler key_handler(key_component_count,
+                                      true,
+                                      join_columns.data(),
+                                      type_infos.data(),
+                                      nullptr,
+                                      nullptr);
+  const int64_t entry_count = 2 * num_elems;
+  std::vector<int8_t> hash_buff(entry_count * (key_component_count + 1) *
+                                key_component_width);
+  for (auto _ : state) {
+    const auto err = run_on_threads(
+        thread_count, [&](const int32_t cpu_thread_idx, const int32_t cpu_thread_count) {
+          if (key_component_width == sizeof(int32_t)) {
+            init_baseline_hash_join_buff_32(hash_buff.data(),
+                                            entry_count,
+                                            key_component_count,
+                                            true,
+                                            -1,
+                                            cpu_thread_idx,
+                                            cpu_thread_count);
+          } else {
+            init_baseline_hash_join_buff_64(hash_buff.data(),
+                                            entry_count,
+                                            key_component_count,
+                                            true,
+                                            -1,
+                                            cpu_thread_idx,
+                                            cpu_thread_count);
+          }
+          return 0;
+        });
+    CHECK_EQ(err, 0);
+    const auto fill_err = run_on_threads(
+        thread_count, [&](const int32_t cpu_thread_idx, const int32_t cpu_thread_count) {
+          if (key_component_width == sizeof(int32_t)) {
+            return fill_baseline_hash_join_buff_32(hash_buff.data(),
+                                                   entry_count,
+                                                   -1,
+                                                   false,
+                                                   key_component_count,
+                                                   true,
+                                                   &key_handler,
+                                                   num_elems,
+                                                   cpu_thread_idx,
+                                                   cpu_thread_count);
+          }
+          return fill_baseline_hash_join_buff_64(hash_buff.data(),
+                                                 entry_count,
+                                                 -1,
+                                                 false,
+                                                 key_component_count,
+                                                 true,
+                                                 &key_handler,
+                                                 num_elems,
+                                                 cpu_thread_idx,
+                                                 cpu_thread_count);
+        });
+    CHECK_EQ(fill_err, 0);
+    benchmark::DoNotOptimize(hash_buff.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_elems);
+}
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, FillBaselineHashJoinBuff32)
+(benchmark::State& state) {
+  run_baseline_hash_join_fill_benchmark(state, sizeof(int32_t));
+}
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, FillBaselineHashJoinBuff64)
+(benchmark::State& state) {
+  run_baseline_hash_join_fill_benchmark(state, sizeof(int64_t));
+}
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, FillHashJoinBuff)
+    ->Apply(sizes_and_thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, FillBaselineHashJoinBuff32)
+    ->Apply(sizes_and_thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, FillBaselineHashJoinBuff64)
+    ->Apply(sizes_and_thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Result sets: reduction of two group by buffers, sort, top-n and conversion to columnar
+// results. Every result set holds a BIGINT key and SUM, COUNT and MAX of a BIGINT. Args:
+// number of entries, number of threads.
+
+namespace {
+
+std::vector<TargetInfo> result_set_target_infos() {
+  return generate_custom_agg_target_infos({8},
+                                          {kSUM, kCOUNT, kMAX},
+                                          {kBIGINT, kBIGINT, kBIGINT},
+                                          {kBIGINT, kBIGINT, kBIGINT});
+}
+
+QueryMemoryDescriptor baseline_hash_desc(const std::vector<TargetInfo>& target_infos,
+                                         const size_t entry_count) {
+  QueryMemoryDescriptor query_mem_desc(
+      QueryDescriptionType::GroupByBaselineHash, 0, entry_count - 1, false, {8, 8});
+  for (size_t i = 0; i < target_infos.size(); ++i) {
+    query_mem_desc.addColSlotInfo({std::make_tuple(int8_t(8), int8_t(8))});
+  }
+  query_mem_desc.setEntryCount(entry_count);
+  return query_mem_desc;
+}
+
+std::unique_ptr<ResultSet> make_result_set(
+    const std::vector<TargetInfo>& target_infos,
+    const QueryMemoryDescriptor& query_mem_desc,
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner) {
+  auto rs = std::make_unique<ResultSet>(target_infos,
+                                        ExecutorDeviceType::CPU,
+                                        query_mem_desc,
+                                        row_set_mem_owner,
+                                        nullptr,
+                                        0,
+                                        0);
+  rs->allocateStorage();
+  return rs;
+}
+
+void fill_result_set(ResultSet& rs,
+                     const std::vector<TargetInfo>& target_infos,
+                     const QueryMemoryDescriptor& query_mem_desc,
+                     NumberGenerator& generator,
+                     const size_t step) {
+  generator.reset();
+  fill_storage_buffer(rs.getStorage()->getUnderlyingBuffer(),
+                      target_infos,
+                      query_mem_desc,
+                      generator,
+                      step);
+}
+
+void run_reduction_benchmark(benchmark::State& state,
+                             const QueryMemoryDescriptor& query_mem_desc,
+                             const size_t step) {
+  const auto target_infos = result_set_target_infos();
+  const auto cpu_threads_guard = override_cpu_threads(state.range(1));
+  const auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  auto rs1 = make_result_set(target_infos, query_mem_desc, row_set_mem_owner);
+  auto rs2 = make_result_set(target_infos, query_mem_desc, row_set_mem_owner);
+  EvenNumberGenerator generator1;
+  ReverseOddOrEvenNumberGenerator generator2(2 * query_mem_desc.getEntryCount() - 1);
+  for (auto _ : state) {
+    state.PauseTiming();
+    fill_result_set(*rs1, target_infos, query_mem_desc, generator1, step);
+    fill_result_set(*rs2, target_infos, query_mem_desc, generator2, step);
+    state.ResumeTiming();
+    ResultSetManager rs_manager;
+    std::vector<ResultSet*> storage_set{rs1.get(), rs2.get()};
+    benchmark::DoNotOptimize(
+        rs_manager.reduce(storage_set, Executor::UNITARY_EXECUTOR_ID));
+  }
+  state.SetItemsProcessed(state.iterations() * query_mem_desc.getEntryCount());
+}
+
+void run_sort_benchmark(benchmark::State& state, const size_t top_n) {
+  const auto target_infos = result_set_target_infos();
+  const auto cpu_threads_guard = override_cpu_threads(state.range(1));
+  const auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  const auto query_mem_desc =
+      perfect_hash_one_col_desc(target_infos, 8, 0, state.range(0) - 1);
+  auto rs = make_result_set(target_infos, query_mem_desc, row_set_mem_owner);
+  EvenNumberGenerator generator;
+  fill_result_set(*rs, target_infos, query_mem_desc, generator, 2);
+  // Order by the SUM target, descending.
+  const std::list<Analyzer::OrderEntry> order_entries{{2, true, false}};
+  for (auto _ : state) {
+    rs->clearPermutation();
+    rs->sort(order_entries, top_n, nullptr);
+    benchmark::DoNotOptimize(rs->isPermutationBufferEmpty());
+  }
+  state.SetItemsProcessed(state.iterations() * query_mem_desc.getEntryCount());
+}
+
+void run_columnar_conversion_benchmark(benchmark::State& state,
+                                       const bool output_columnar) {
+  const auto target_infos = result_set_target_infos();
+  const auto cpu_threads_guard = override_cpu_threads(state.range(1));
+  const auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+  auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, state.range(0) - 1);
+  query_mem_desc.setOutputColumnar(output_columnar);
+  auto rs = make_result_set(target_infos, query_mem_desc, row_set_mem_owner);
+  EvenNumberGenerator generator;
+  fill_result_set(*rs, target_infos, query_mem_desc, generator, 2);
+  std::vector<SQLTypeInfo> target_types;
+  for (const auto& target_info : target_infos) {
+    target_types.push_back(target_info.sql_type);
+  }
+  for (auto _ : state) {
+    ColumnarResults columnar_results(row_set_mem_owner,
+                                     *rs,
+                                     target_types.size(),
+                                     target_types,
+                                     Executor::UNITARY_EXECUTOR_ID,
+                                     0);
+    benchmark::DoNotOptimize(columnar_results.getColumnBuffers().data());
+  }
+  state.SetItemsProcessed(state.iterations() * query_mem_desc.getEntryCount());
+}
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, ReducePerfectHash)(benchmark::State& state) {
+  const auto query_mem_desc = perfect_hash_one_col_desc(
+      result_set_target_infos(), 8, 0, state.range(0) - 1);
+  run_reduction_benchmark(state, query_mem_desc, 2);
+}
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, ReduceBaselineHash)(benchmark::State& state) {
+  const auto query_mem_desc =
+      baseline_hash_desc(result_set_target_infos(), state.range(0));
+  run_reduction_benchmark(state, query_mem_desc, 2);
+}
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, Sort)(benchmark::State& state) {
+  run_sort_benchmark(state, 0);
+}
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, ParallelTop)(benchmark::State& state) {
+  // Take the parallel top-n path regardless of the number of entries.
+  const auto saved_parallel_top_min = g_parallel_top_min;
+  ScopeGuard reset_parallel_top_min = [saved_parallel_top_min] {
+    g_parallel_top_min = saved_parallel_top_min;
+  };
+  g_parallel_top_min = 0;
+  run_sort_benchmark(state, 100);
+}
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, ColumnarConversionRowwise)
+(benchmark::State& state) {
+  run_columnar_conversion_benchmark(state, false);
+}
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, ColumnarConversionColumnar)
+(benchmark::State& state) {
+  run_columnar_conversion_benchmark(state, true);
+}
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, ReducePerfectHash)
+    ->Apply(sizes_and_thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, ReduceBaselineHash)
+    ->Apply(sizes_and_thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, Sort)
+    ->Apply(sizes_and_thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, ParallelTop)
+    ->Apply(sizes_and_thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, ColumnarConversionRowwise)
+    ->Apply(sizes_and_thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, ColumnarConversionColumnar)
+    ->Apply(sizes_and_thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Encoders: appending a BIGINT column to a chunk without and with fixed length encoding,
+// and updating the chunk stats of a column. Arg: number of elements.
+
+namespace {
+
+// In-memory buffer only supporting the appends done by the encoders.
+class AppendOnlyBuffer : public Data_Namespace::AbstractBuffer {
+ public:
+  AppendOnlyBuffer(const SQLTypeInfo sql_type) : AbstractBuffer(0, sql_type) {}
+
+  void read(int8_t* const dst,
+            const size_t num_bytes,
+            const size_t offset,
+            const Data_Namespace::MemoryLevel dst_buffer_type,
+            const int dst_device_id) override {
+    UNREACHABLE();
+  }
+
+  void write(int8_t* src,
+             const size_t num_bytes,
+             const size_t offset,
+             const Data_Namespace::MemoryLevel src_buffer_type,
+             const int src_device_id) override {
+    UNREACHABLE();
+  }
+
+  void reserve(size_t num_bytes) override { data_.reserve(num_bytes); }
+
+  void append(int8_t* src,
+              const size_t num_bytes,
+              const Data_Namespace::MemoryLevel src_buffer_type,
+              const int device_id) override {
+    data_.insert(data_.end(), src, src + num_bytes);
+    setSize(data_.size());
+  }
+
+  int8_t* getMemoryPtr() override { return data_.data(); }
+
+  size_t pageCount() const override { return 1; }
+
+  size_t pageSize() const override { return data_.capacity(); }
+
+  size_t reservedSize() const override { return data_.capacity(); }
+
+  Data_Namespace::MemoryLevel getType() const override {
+    return Data_Namespace::CPU_LEVEL;
+  }
+
+  void clear() {
+    data_.clear();
+    setSize(0);
+  }
+
+ private:
+  std::vector<int8_t> data_;
+};
+
+void run_encoder_append_benchmark(benchmark::State& state, const SQLTypeInfo& ti) {
+  const size_t num_elems = state.range(0);
+  // Values fit in the smallest fixed length encoding benchmarked.
+  auto data = make_random_keys(num_elems, std::numeric_limits<int16_t>::max());
+  AppendOnlyBuffer buffer(ti);
+  buffer.reserve(num_elems * sizeof(int64_t));
+  for (auto _ : state) {
+    buffer.clear();
+    auto src_data = reinterpret_cast<int8_t*>(data.data());
+    benchmark::DoNotOptimize(
+        buffer.getEncoder()->appendData(src_data, num_elems, ti, false, -1));
+  }
+  state.SetBytesProcessed(state.iterations() * num_elems * sizeof(int64_t));
+}
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, EncoderAppendNone)(benchmark::State& state) {
+  run_encoder_append_benchmark(state, SQLTypeInfo(kBIGINT, false));
+}
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, EncoderAppendFixed16)
+(benchmark::State& state) {
+  SQLTypeInfo ti(kBIGINT, false);
+  ti.set_compression(kENCODING_FIXED);
+  ti.set_comp_param(16);
+  run_encoder_append_benchmark(state, ti);
+}
+
+BENCHMARK_DEFINE_F(QueryEngineFixture, EncoderUpdateStats)(benchmark::State& state) {
+  const size_t num_elems = state.range(0);
+  const auto data = make_random_keys(num_elems, std::numeric_limits<int64_t>::max());
+  AppendOnlyBuffer buffer(SQLTypeInfo(kBIGINT, false));
+  for (auto _ : state) {
+    buffer.getEncoder()->updateStats(reinterpret_cast<const int8_t*>(data.data()),
+                                     num_elems);
+  }
+  state.SetBytesProcessed(state.iterations() * num_elems * sizeof(int64_t));
+}
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, EncoderAppendNone)
+    ->Range(1 << 14, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, EncoderAppendFixed16)
+    ->Range(1 << 14, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_REGISTER_F(QueryEngineFixture, EncoderUpdateStats)
+    ->Range(1 << 14, 1 << 24)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,652 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    QueryRegressionBenchmark.cpp
+ * @brief   End-to-end query benchmark comparing its results against a stored baseline.
+ *
+ * Generates a Star Schema Benchmark style data set at the given scale factor in the
+ * local catalogs, then runs a suite of queries through the QueryRunner. Every query is
+ * run once on a fresh code cache ("first"), then repeatedly after clearing the buffer
+ * pools and caches ("cold") and repeatedly with everything cached ("warm"), for each
+ * of the requested CPU thread counts. Latency percentiles, JIT compilation time and
+ * the high-water mark of the buffer pool usage during the queries are reported, written
+ * as JSON with --output and compared against a JSON baseline written by a previous run
+ * on the same device and scale factor with --baseline.
+ *
+ * The exit code is 0 if no regression was found, 1 if any metric regressed beyond its
+ * threshold and 2 on errors.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/prettywriter.h>
+
+#include "Catalog/Catalog.h"
+#include "Logger/Logger.h"
+#include "QueryEngine/QueryExecutionStats.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
+#include "Shared/thread_count.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+
+namespace {
+
+struct BenchmarkOptions {
+  double scale_factor{0.1};
+  size_t fragment_size{0};
+  bool skip_load{false};
+  std::vector<size_t> thread_counts;
+  std::vector<std::string> query_names;
+  size_t cold_iterations{3};
+  size_t warm_iterations{10};
+  ExecutorDeviceType device_type{ExecutorDeviceType::CPU};
+  double latency_threshold{0.1};
+  double compilation_threshold{0.25};
+  double memory_threshold{0.05};
+  double min_regression_ms{5};
+};
+
+// Star Schema Benchmark style data set.
+
+const std::vector<std::string> kRegions{"AFRICA",
+                                        "AMERICA",
+                                        "ASIA",
+                                        "EUROPE",
+                                        "MIDDLE EAST"};
+
+const std::vector<std::pair<std::string, size_t>> kNations{{"ALGERIA", 0},
+                                                           {"ARGENTINA", 1},
+                                                           {"BRAZIL", 1},
+                                                           {"CANADA", 1},
+                                                           {"EGYPT", 4},
+                                                           {"ETHIOPIA", 0},
+                                                           {"FRANCE", 3},
+                                                           {"GERMANY", 3},
+                                                           {"INDIA", 2},
+                                                           {"INDONESIA", 2},
+                                                           {"IRAN", 4},
+                                                           {"IRAQ", 4},
+                                                           {"JAPAN", 2},
+                                                           {"JORDAN", 4},
+                                                           {"KENYA", 0},
+                                                           {"MOROCCO", 0},
+                                                           {"MOZAMBIQUE", 0},
+                                                           {"PERU", 1},
+                                                           {"CHINA", 2},
+                                                           {"ROMANIA", 3},
+                                                           {"SAUDI ARABIA", 4},
+                                                           {"VIETNAM", 2},
+                                                           {"RUSSIA", 3},
+                                                           {"UNITED KINGDOM", 3},
+                                                           {"UNITED STATES", 1}};
+
+constexpr uint64_t kSeed{42};
+
+size_t scaled_row_count(const size_t rows_at_sf1,
+                        const double scale_factor,
+                        const size_t min_rows) {
+  return std::max(static_cast<size_t>(rows_at_sf1 * scale_factor), min_rows);
+}
+
+// Writes the rows produced by `write_row(f, row_idx)` to a CSV file and copies it into
+// `table_name`.
+template <typename WRITE_ROW>
+void load_table(const std::string& table_name,
+                const std::string& columns,
+                const size_t num_rows,
+                const size_t fragment_size,
+                WRITE_ROW write_row) {
+  LOG(INFO) << "Generating " << num_rows << " rows for table " << table_name;
+  QR::get()->runDDLStatement("DROP TABLE IF EXISTS " + table_name + ";");
+  QR::get()->runDDLStatement("CREATE TABLE " + table_name + " (" + columns +
+                             ") WITH (fragment_size=" +
+                             std::to_string(std::max(fragment_size, size_t(1000))) +
+                             ");");
+  auto csv_path =
+      boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+  csv_path.replace_extension(boost::filesystem::path{".csv"});
+  {
+    std::ofstream f(csv_path.native(), std::ios::binary | std::ios::trunc);
+    CHECK(f.is_open());
+    for (size_t i = 0; i < num_rows; ++i) {
+      write_row(f, i);
+      f << '\n';
+    }
+  }
+  QR::get()->runDDLStatement("COPY " + table_name + " FROM '" + csv_path.string() +
+                             "' WITH (header='false');");
+  boost::filesystem::remove(csv_path);
+}
+
+std::vector<int32_t> make_date_keys() {
+  std::vector<int32_t> date_keys;
+  for (int32_t year = 1992; year <= 1998; ++year) {
+    const bool leap_year = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    const int32_t days_in_month[] = {
+        31, leap_year ? 29 : 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    for (int32_t month = 1; month <= 12; ++month) {
+      for (int32_t day = 1; day <= days_in_month[month - 1]; ++day) {
+        date_keys.push_back(year * 10000 + month * 100 + day);
+      }
+    }
+  }
+  return date_keys;
+}
+
+std::string city_name(const size_t nation_idx, const size_t city_idx) {
+  return kNations[nation_idx].first.substr(0, 9) + std::to_string(city_idx);
+}
+
+void load_ssb_data(const double scale_factor, const size_t fragment_size) {
+  const auto num_lineorders = scaled_row_count(6000000, scale_factor, 1000);
+  const auto num_customers = scaled_row_count(30000, scale_factor, 100);
+  const auto num_suppliers = scaled_row_count(2000, scale_factor, 10);
+  const auto num_parts = scaled_row_count(200000, scale_factor, 100);
+  const auto lineorder_fragment_size =
+      fragment_size ? fragment_size : num_lineorders / 16;
+  const auto date_keys = make_date_keys();
+  std::mt19937_64 gen(kSeed);
+
+  load_table("ddate",
+             "d_datekey INT, d_year SMALLINT, d_yearmonthnum INT, d_weeknuminyear "
+             "SMALLINT",
+             date_keys.size(),
+             fragment_size ? fragment_size : date_keys.size(),
+             [&date_keys](std::ostream& f, const size_t i) {
+               const auto date_key = date_keys[i];
+               f << date_key << ',' << date_key / 10000 << ',' << date_key / 100 << ','
+                 << i % 365 / 7 + 1;
+             });
+  const auto write_location = [&gen](std::ostream& f) {
+    const auto nation_idx = gen() % kNations.size();
+    f << city_name(nation_idx, gen() % 10) << ',' << kNations[nation_idx].first << ','
+      << kRegions[kNations[nation_idx].second];
+  };
+  load_table("customer",
+             "c_custkey INT, c_city TEXT ENCODING DICT(32), c_nation TEXT ENCODING "
+             "DICT(32), c_region TEXT ENCODING DICT(32)",
+             num_customers,
+             fragment_size ? fragment_size : num_customers,
+             [&write_location](std::ostream& f, const size_t i) {
+               f << i + 1 << ',';
+               write_location(f);
+             });
+  load_table("supplier",
+             "s_suppkey INT, s_city TEXT ENCODING DICT(32), s_nation TEXT ENCODING "
+             "DICT(32), s_region TEXT ENCODING DICT(32)",
+             num_suppliers,
+             fragment_size ? fragment_size : num_suppliers,
+             [&write_location](std::ostream& f, const size_t i) {
+               f << i + 1 << ',';
+               write_location(f);
+             });
+  load_table("part",
+             "p_partkey INT, p_mfgr TEXT ENCODING DICT(32), p_category TEXT ENCODING "
+             "DICT(32), p_brand1 TEXT ENCODING DICT(32)",
+             num_parts,
+             fragment_size ? fragment_size : num_parts,
+             [&gen](std::ostream& f, const size_t i) {
+               const auto mfgr = gen() % 5 + 1;
+               const auto category = mfgr * 10 + gen() % 5 + 1;
+               f << i + 1 << ",MFGR#" << mfgr << ",MFGR#" << category << ",MFGR#"
+                 << category << gen() % 40 + 1;
+             });
+  load_table("lineorder",
+             "lo_orderkey BIGINT, lo_linenumber SMALLINT, lo_custkey INT, lo_partkey "
+             "INT, lo_suppkey INT, lo_orderdate INT, lo_quantity SMALLINT, "
+             "lo_extendedprice INT, lo_discount SMALLINT, lo_revenue INT, "
+             "lo_supplycost INT",
+             num_lineorders,
+             lineorder_fragment_size,
+             [&](std::ostream& f, const size_t i) {
+               const auto quantity = gen() % 50 + 1;
+               const auto extended_price = quantity * (90000 + gen() % 20001) / 100;
+               const auto discount = gen() % 11;
+               f << i / 4 + 1 << ',' << i % 4 + 1 << ',' << gen() % num_customers + 1
+                 << ',' << gen() % num_parts + 1 << ',' << gen() % num_suppliers + 1
+                 << ',' << date_keys[gen() % date_keys.size()] << ',' << quantity << ','
+                 << extended_price << ',' << discount << ','
+                 << extended_price * (100 - discount) / 100 << ','
+                 << 6 * (100 + gen() % 900);
+             });
+}
+
+const std::vector<std::pair<std::string, std::string>> kQuerySuite{
+    {"Q1.1",
+     "SELECT SUM(lo_extendedprice * lo_discount) AS revenue FROM lineorder, ddate WHERE "
+     "lo_orderdate = d_datekey AND d_year = 1993 AND lo_discount BETWEEN 1 AND 3 AND "
+     "lo_quantity < 25;"},
+    {"Q1.2",
+     "SELECT SUM(lo_extendedprice * lo_discount) AS revenue FROM lineorder, ddate WHERE "
+     "lo_orderdate = d_datekey AND d_yearmonthnum = 199401 AND lo_discount BETWEEN 4 "
+     "AND 6 AND lo_quantity BETWEEN 26 AND 35;"},
+    {"Q2.1",
+     "SELECT SUM(lo_revenue), d_year, p_brand1 FROM lineorder, ddate, part, supplier "
+     "WHERE lo_orderdate = d_datekey AND lo_partkey = p_partkey AND lo_suppkey = "
+     "s_suppkey AND p_category = 'MFGR#12' AND s_region = 'AMERICA' GROUP BY d_year, "
+     "p_brand1 ORDER BY d_year, p_brand1;"},
+    {"Q3.1",
+     "SELECT c_nation, s_nation, d_year, SUM(lo_revenue) AS revenue FROM customer, "
+     "lineorder, supplier, ddate WHERE lo_custkey = c_custkey AND lo_suppkey = "
+     "s_suppkey AND lo_orderdate = d_datekey AND c_region = 'ASIA' AND s_region = "
+     "'ASIA' AND d_year >= 1992 AND d_year <= 1997 GROUP BY c_nation, s_nation, d_year "
+     "ORDER BY d_year ASC, revenue DESC;"},
+    {"Q4.1",
+     "SELECT d_year, c_nation, SUM(lo_revenue - lo_supplycost) AS profit FROM ddate, "
+     "customer, supplier, part, lineorder WHERE lo_custkey = c_custkey AND lo_suppkey = "
+     "s_suppkey AND lo_partkey = p_partkey AND lo_orderdate = d_datekey AND c_region = "
+     "'AMERICA' AND s_region = 'AMERICA' AND (p_mfgr = 'MFGR#1' OR p_mfgr = 'MFGR#2') "
+     "GROUP BY d_year, c_nation ORDER BY d_year, c_nation;"},
+    {"TopCustomers",
+     "SELECT lo_custkey, SUM(lo_revenue) AS revenue FROM lineorder GROUP BY lo_custkey "
+     "ORDER BY revenue DESC LIMIT 10;"},
+    {"Projection",
+     "SELECT lo_orderkey, lo_revenue FROM lineorder WHERE lo_discount = 7 AND "
+     "lo_quantity > 45;"}};
+
+// Running the queries.
+
+struct QueryRunStats {
+  std::string query_name;
+  std::string mode;
+  size_t thread_count;
+  std::vector<double> latencies_ms;
+  int64_t compilation_time_ms{0};
+  size_t peak_buffer_pool_bytes{0};
+};
+
+Data_Namespace::MemoryLevel get_memory_level(const ExecutorDeviceType device_type) {
+  return device_type == ExecutorDeviceType::GPU ? Data_Namespace::MemoryLevel::GPU_LEVEL
+                                                : Data_Namespace::MemoryLevel::CPU_LEVEL;
+}
+
+std::string get_device_name(const ExecutorDeviceType device_type) {
+  return device_type == ExecutorDeviceType::GPU ? "GPU" : "CPU";
+}
+
+void clear_memory() {
+  QR::get()->clearCpuMemory();
+  QR::get()->clearGpuMemory();
+}
+
+void run_query(const std::string& query_name,
+               const std::string& query,
+               const ExecutorDeviceType device_type,
+               QueryRunStats& run_stats) {
+  QueryExecutionStats execution_stats;
+  QR::get()->setExecutionStats(&execution_stats);
+  ScopeGuard reset_execution_stats = [] { QR::get()->setExecutionStats(nullptr); };
+  execution_stats.beginStep(0, query_name);
+  // the high-water mark of the buffer pool usage during the query, which includes the
+  // chunks fetched by it and the buffers it allocated for its intermediate results
+  auto& data_mgr = QR::get()->getCatalog()->getDataMgr();
+  const auto memory_level = get_memory_level(device_type);
+  data_mgr.resetMaxBufferPoolBytesUsed(memory_level);
+  const auto clock_begin = std::chrono::steady_clock::now();
+  const auto rows = QR::get()->runSQL(query, device_type, true, true);
+  const std::chrono::duration<double, std::milli> latency =
+      std::chrono::steady_clock::now() - clock_begin;
+  execution_stats.endStep(static_cast<int64_t>(latency.count()), rows->rowCount());
+  const auto steps = execution_stats.getSteps();
+  CHECK_EQ(steps.size(), size_t(1));
+  run_stats.latencies_ms.push_back(latency.count());
+  run_stats.compilation_time_ms =
+      std::max(run_stats.compilation_time_ms, steps.front().compilation_time_ms);
+  run_stats.peak_buffer_pool_bytes =
+      std::max(run_stats.peak_buffer_pool_bytes,
+               data_mgr.getMaxBufferPoolBytesUsed(memory_level));
+}
+
+std::vector<QueryRunStats> run_query_suite(const BenchmarkOptions& options) {
+  std::vector<QueryRunStats> results;
+  const auto saved_cpu_threads_override = g_cpu_threads_override;
+  ScopeGuard reset_cpu_threads_override = [saved_cpu_threads_override] {
+    g_cpu_threads_override = saved_cpu_threads_override;
+  };
+  for (const auto& [query_name, query] : kQuerySuite) {
+    if (!options.query_names.empty() &&
+        std::find(options.query_names.begin(), options.query_names.end(), query_name) ==
+            options.query_names.end()) {
+      continue;
+    }
+    LOG(INFO) << "Running query " << query_name;
+    // The code cache is shared by all the thread counts, only the first run compiles.
+    clear_memory();
+    results.push_back({query_name, "first", 0});
+    run_query(query_name, query, options.device_type, results.back());
+    for (const auto thread_count : options.thread_counts) {
+      g_cpu_threads_override = thread_count;
+      results.push_back({query_name, "cold", thread_count});
+      for (size_t i = 0; i < options.cold_iterations; ++i) {
+        clear_memory();
+        run_query(query_name, query, options.device_type, results.back());
+      }
+      QueryRunStats warmup_run_stats;
+      run_query(query_name, query, options.device_type, warmup_run_stats);
+      results.push_back({query_name, "warm", thread_count});
+      for (size_t i = 0; i < options.warm_iterations; ++i) {
+        run_query(query_name, query, options.device_type, results.back());
+      }
+    }
+  }
+  return results;
+}
+
+// Reporting and comparing against the baseline.
+
+double percentile(std::vector<double> values, const double p) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  const auto rank = static_cast<size_t>(std::ceil(p / 100 * values.size()));
+  return values[std::max(rank, size_t(1)) - 1];
+}
+
+std::string get_result_key(const std::string& query_name,
+                           const std::string& mode,
+                           const size_t thread_count) {
+  return query_name + "/" + mode + "/" + std::to_string(thread_count);
+}
+
+rapidjson::Document results_to_json(const std::vector<QueryRunStats>& results,
+                                    const BenchmarkOptions& options) {
+  rapidjson::Document document(rapidjson::kObjectType);
+  auto& allocator = document.GetAllocator();
+  document.AddMember("scale_factor", options.scale_factor, allocator);
+  document.AddMember(
+      "device",
+      rapidjson::Value(get_device_name(options.device_type).c_str(), allocator),
+      allocator);
+  rapidjson::Value json_results(rapidjson::kArrayType);
+  for (const auto& result : results) {
+    rapidjson::Value json_result(rapidjson::kObjectType);
+    json_result.AddMember(
+        "query", rapidjson::Value(result.query_name.c_str(), allocator), allocator);
+    json_result.AddMember(
+        "mode", rapidjson::Value(result.mode.c_str(), allocator), allocator);
+    json_result.AddMember("threads", uint64_t(result.thread_count), allocator);
+    json_result.AddMember("runs", uint64_t(result.latencies_ms.size()), allocator);
+    json_result.AddMember("p50_ms", percentile(result.latencies_ms, 50), allocator);
+    json_result.AddMember("p90_ms", percentile(result.latencies_ms, 90), allocator);
+    json_result.AddMember("p99_ms", percentile(result.latencies_ms, 99), allocator);
+    json_result.AddMember("compilation_ms", result.compilation_time_ms, allocator);
+    json_result.AddMember(
+        "peak_buffer_pool_bytes", uint64_t(result.peak_buffer_pool_bytes), allocator);
+    json_results.PushBack(json_result, allocator);
+  }
+  document.AddMember("results", json_results, allocator);
+  return document;
+}
+
+void print_results(const rapidjson::Document& document) {
+  std::cout << std::left << std::setw(14) << "query" << std::setw(7) << "mode"
+            << std::right << std::setw(8) << "threads" << std::setw(12) << "p50 ms"
+            << std::setw(12) << "p90 ms" << std::setw(12) << "p99 ms" << std::setw(12)
+            << "jit ms" << std::setw(16) << "peak pool MB" << std::endl;
+  for (const auto& result : document["results"].GetArray()) {
+    std::cout << std::left << std::setw(14) << result["query"].GetString()
+              << std::setw(7) << result["mode"].GetString() << std::right
+              << std::setw(8) << result["threads"].GetUint64() << std::fixed
+              << std::setprecision(2) << std::setw(12) << result["p50_ms"].GetDouble()
+              << std::setw(12) << result["p90_ms"].GetDouble() << std::setw(12)
+              << result["p99_ms"].GetDouble() << std::setw(12)
+              << result["compilation_ms"].GetInt64() << std::setw(16)
+              << result["peak_buffer_pool_bytes"].GetUint64() / double(1 << 20)
+              << std::endl;
+  }
+}
+
+rapidjson::Document read_json(const std::string& file_path) {
+  std::ifstream ifs(file_path);
+  if (!ifs) {
+    throw std::runtime_error("Could not open baseline file " + file_path);
+  }
+  rapidjson::IStreamWrapper isw(ifs);
+  rapidjson::Document document;
+  document.ParseStream(isw);
+  if (document.HasParseError() || !document.IsObject() ||
+      !document.HasMember("results") || !document["results"].IsArray()) {
+    throw std::runtime_error("Invalid baseline file " + file_path);
+  }
+  return document;
+}
+
+void write_json(const rapidjson::Document& document, const std::string& file_path) {
+  std::ofstream ofs(file_path);
+  if (!ofs) {
+    throw std::runtime_error("Could not create output file " + file_path);
+  }
+  rapidjson::OStreamWrapper osw(ofs);
+  rapidjson::PrettyWriter<rapidjson::OStreamWrapper> writer(osw);
+  document.Accept(writer);
+}
+
+// Returns the number of metrics of `current` which regressed against `baseline`. Only
+// results present in both are compared.
+size_t compare_with_baseline(const rapidjson::Document& current,
+                             const rapidjson::Document& baseline,
+                             const BenchmarkOptions& options) {
+  if (baseline.HasMember("scale_factor") &&
+      baseline["scale_factor"].GetDouble() != options.scale_factor) {
+    throw std::runtime_error("The baseline was recorded at scale factor " +
+                             std::to_string(baseline["scale_factor"].GetDouble()));
+  }
+  const auto device_name = get_device_name(options.device_type);
+  if (!baseline.HasMember("device") || baseline["device"].GetString() != device_name) {
+    throw std::runtime_error("The baseline was not recorded on " + device_name);
+  }
+  std::map<std::string, const rapidjson::Value*> baseline_results;
+  for (const auto& result : baseline["results"].GetArray()) {
+    baseline_results.emplace(get_result_key(result["query"].GetString(),
+                                            result["mode"].GetString(),
+                                            result["threads"].GetUint64()),
+                             &result);
+  }
+  size_t num_regressions{0};
+  const auto check = [&num_regressions](const std::string& key,
+                                        const char* metric,
+                                        const double current_value,
+                                        const double baseline_value,
+                                        const double threshold,
+                                        const double min_difference) {
+    if (current_value > baseline_value * (1 + threshold) &&
+        current_value - baseline_value > min_difference) {
+      ++num_regressions;
+      std::cout << "REGRESSION " << key << " " << metric << ": " << baseline_value
+                << " -> " << current_value << std::endl;
+    }
+  };
+  for (const auto& result : current["results"].GetArray()) {
+    const auto key = get_result_key(result["query"].GetString(),
+                                    result["mode"].GetString(),
+                                    result["threads"].GetUint64());
+    const auto it = baseline_results.find(key);
+    if (it == baseline_results.end()) {
+      LOG(WARNING) << "No baseline for " << key;
+      continue;
+    }
+    const auto& baseline_result = *it->second;
+    for (const auto metric : {"p50_ms", "p90_ms"}) {
+      check(key,
+            metric,
+            result[metric].GetDouble(),
+            baseline_result[metric].GetDouble(),
+            options.latency_threshold,
+            options.min_regression_ms);
+    }
+    check(key,
+          "compilation_ms",
+          result["compilation_ms"].GetInt64(),
+          baseline_result["compilation_ms"].GetInt64(),
+          options.compilation_threshold,
+          options.min_regression_ms);
+    check(key,
+          "peak_buffer_pool_bytes",
+          result["peak_buffer_pool_bytes"].GetUint64(),
+          baseline_result["peak_buffer_pool_bytes"].GetUint64(),
+          options.memory_threshold,
+          0);
+  }
+  return num_regressions;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  namespace po = boost::program_options;
+
+  BenchmarkOptions options;
+  std::string db_path{BASE_PATH};
+  std::string thread_counts;
+  std::string query_names;
+  std::string baseline_path;
+  std::string output_path;
+
+  po::options_description desc("Options");
+  desc.add_options()("help,h", "Print help messages");
+  desc.add_options()("path",
+                     po::value<std::string>(&db_path)->default_value(db_path),
+                     "Directory path to the catalogs");
+  desc.add_options()("scale-factor",
+                     po::value<double>(&options.scale_factor)
+                         ->default_value(options.scale_factor),
+                     "Scale factor of the generated data, 1 is 6M rows in lineorder");
+  desc.add_options()(
+      "fragment-size",
+      po::value<size_t>(&options.fragment_size)->default_value(options.fragment_size),
+      "Fragment size of the generated tables, 0 splits lineorder in 16 fragments");
+  desc.add_options()("skip-load",
+                     po::bool_switch(&options.skip_load),
+                     "Reuse the tables generated by a previous run");
+  desc.add_options()("threads",
+                     po::value<std::string>(&thread_counts)
+                         ->default_value(std::to_string(cpu_threads())),
+                     "Comma separated CPU thread counts to run the queries with");
+  desc.add_options()("queries",
+                     po::value<std::string>(&query_names),
+                     "Comma separated names of the queries to run, all by default");
+  desc.add_options()("cold-iterations",
+                     po::value<size_t>(&options.cold_iterations)
+                         ->default_value(options.cold_iterations),
+                     "Number of runs after clearing the buffer pools and caches");
+  desc.add_options()("warm-iterations",
+                     po::value<size_t>(&options.warm_iterations)
+                         ->default_value(options.warm_iterations),
+                     "Number of runs with the data and code cached");
+  desc.add_options()("gpu", "Run the queries on GPU (run on CPU by default)");
+  desc.add_options()("baseline",
+                     po::value<std::string>(&baseline_path),
+                     "JSON results of a previous run to compare against");
+  desc.add_options()("output",
+                     po::value<std::string>(&output_path),
+                     "File to write the JSON results to");
+  desc.add_options()("latency-threshold",
+                     po::value<double>(&options.latency_threshold)
+                         ->default_value(options.latency_threshold),
+                     "Allowed relative increase of the latency percentiles");
+  desc.add_options()("compilation-threshold",
+                     po::value<double>(&options.compilation_threshold)
+                         ->default_value(options.compilation_threshold),
+                     "Allowed relative increase of the JIT compilation time");
+  desc.add_options()("memory-threshold",
+                     po::value<double>(&options.memory_threshold)
+                         ->default_value(options.memory_threshold),
+                     "Allowed relative increase of the peak buffer pool usage");
+  desc.add_options()("min-regression-ms",
+                     po::value<double>(&options.min_regression_ms)
+                         ->default_value(options.min_regression_ms),
+                     "Ignore time regressions smaller than this many milliseconds");
+
+  logger::LogOptions log_options(argv[0]);
+  log_options.max_files_ = 0;  // stderr only by default
+  desc.add(log_options.get_options());
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(desc).run(), vm);
+    if (vm.count("help")) {
+      std::cout << "Usage: QueryRegressionBenchmark [options]\n" << desc << std::endl;
+      return 0;
+    }
+    po::notify(vm);
+  } catch (const po::error& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+  logger::init(log_options);
+
+  int err{0};
+  try {
+    std::vector<std::string> tokens;
+    boost::split(tokens, thread_counts, boost::is_any_of(","));
+    for (const auto& token : tokens) {
+      options.thread_counts.push_back(std::stoul(token));
+    }
+    if (!query_names.empty()) {
+      boost::split(options.query_names, query_names, boost::is_any_of(","));
+    }
+    QR::init(db_path.c_str());
+    if (vm.count("gpu")) {
+      if (!QR::get()->gpusPresent()) {
+        throw std::runtime_error("No GPU available");
+      }
+      options.device_type = ExecutorDeviceType::GPU;
+    }
+    if (!options.skip_load) {
+      load_ssb_data(options.scale_factor, options.fragment_size);
+    }
+    const auto results = results_to_json(run_query_suite(options), options);
+    print_results(results);
+    if (!output_path.empty()) {
+      write_json(results, output_path);
+    }
+    if (!baseline_path.empty()) {
+      const auto num_regressions =
+          compare_with_baseline(results, read_json(baseline_path), options);
+      std::cout << num_regressions << " regression(s) against " << baseline_path
+                << std::endl;
+      err = num_regressions ? 1 : 0;
+    }
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+    err = 2;
+  }
+  QR::reset();
+  return err;
+}
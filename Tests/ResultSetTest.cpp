@@ -73,6 +73,52 @@ TEST(Construct, Allocate) {
   result_set.allocateStorage();
 }
 
+TEST(Construct, HotGroupCache) {
+  const uint32_t key_count = 1;
+  const uint32_t row_size_quad = key_count + 1;
+  const uint32_t entry_count = 4 * HOT_GROUP_CACHE_SAMPLE_SIZE;
+  std::vector<int64_t> groups_buffer;
+  const auto reset_groups_buffer = [&] {
+    groups_buffer.assign(size_t(entry_count) * row_size_quad, EMPTY_KEY_64);
+    groups_buffer.resize(groups_buffer.size() + HOT_GROUP_CACHE_QW, 0);
+  };
+  const auto lookup_count = [&] { return groups_buffer[entry_count * row_size_quad]; };
+  const auto get_group = [&](const int64_t key) {
+    auto value_slot = get_group_value_with_hot_cache(groups_buffer.data(),
+                                                     entry_count,
+                                                     &key,
+                                                     key_count,
+                                                     sizeof(int64_t),
+                                                     row_size_quad);
+    // the cached entry must be the one found by the regular lookup
+    EXPECT_EQ(value_slot,
+              get_group_value(groups_buffer.data(),
+                              entry_count,
+                              &key,
+                              key_count,
+                              sizeof(int64_t),
+                              row_size_quad));
+  };
+
+  // a heavy hitter key keeps the cache on past the sample
+  reset_groups_buffer();
+  for (int64_t i = 0; i < 2 * HOT_GROUP_CACHE_SAMPLE_SIZE; ++i) {
+    get_group(i % 4 ? 0 : i);
+  }
+  EXPECT_EQ(lookup_count(), 2 * HOT_GROUP_CACHE_SAMPLE_SIZE);
+
+  // distinct keys turn the cache off, even if the last sampled lookup hits
+  reset_groups_buffer();
+  for (int64_t i = 0; i < HOT_GROUP_CACHE_SAMPLE_SIZE - 1; ++i) {
+    get_group(i);
+  }
+  EXPECT_EQ(lookup_count(), HOT_GROUP_CACHE_SAMPLE_SIZE - 1);
+  get_group(HOT_GROUP_CACHE_SAMPLE_SIZE - 2);
+  EXPECT_EQ(lookup_count(), -1);
+  get_group(0);
+  EXPECT_EQ(lookup_count(), -1);
+}
+
 namespace {
 
 using OneRow = std::vector<TargetValue>;
@@ -21,6 +21,7 @@
 
 #include "Catalog/Catalog.h"
 #include "QueryEngine/ResultSet.h"
+#include "QueryEngine/StringTranslationMapCache.h"
 #include "QueryRunner/QueryRunner.h"
 #include "Shared/scope.h"
 #include "TestHelpers.h"
@@ -40,6 +41,7 @@ extern bool g_enable_string_functions;
 extern unsigned g_trivial_loop_join_threshold;
 extern bool g_enable_watchdog;
 extern size_t g_watchdog_none_encoded_string_translation_limit;
+extern bool g_enable_string_translation_map_cache;
 
 namespace {
 
@@ -1943,6 +1945,42 @@ TEST_F(StringFunctionTest, SelectLowercaseNoneEncoded_MoreRowsThanWatchdogLimit)
   }
 }
 
+TEST_F(StringFunctionTest, DictionaryStringOpsCachedAcrossQueries) {
+  const auto previous_cache_state = g_enable_string_translation_map_cache;
+  ScopeGuard reset_cache_state = [&previous_cache_state] {
+    g_enable_string_translation_map_cache = previous_cache_state;
+    StringTranslationMapCache::instance().clear();
+  };
+  g_enable_string_translation_map_cache = true;
+  auto& cache = StringTranslationMapCache::instance();
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    cache.clear();
+    // upper() yields strings missing from the dictionary, which the cached translation
+    // has to add back as transients
+    const std::string query{
+        "select upper(first_name), lower(full_name) from string_function_test_people "
+        "where id <= 4 order by id asc;"};
+    std::vector<std::vector<ScalarTargetValue>> expected_result_set{
+        {"JOHN", "john smith"},
+        {"JOHN", "john banks"},
+        {"JOHN", "john wilson"},
+        {"SUE", "sue smith"}};
+    compare_result_set(expected_result_set, sql(query, dt));
+    EXPECT_EQ(cache.getHitCount(), size_t(0));
+    EXPECT_GT(cache.getNumEntries(), size_t(0));
+
+    compare_result_set(expected_result_set, sql(query, dt));
+    EXPECT_GT(cache.getHitCount(), size_t(0));
+
+    g_enable_string_translation_map_cache = false;
+    const auto num_hits = cache.getHitCount();
+    compare_result_set(expected_result_set, sql(query, dt));
+    EXPECT_EQ(cache.getHitCount(), num_hits);
+    g_enable_string_translation_map_cache = true;
+  }
+}
+
 const char* postgres_osm_names = R"(
     CREATE TABLE postgres_osm_names (
       name TEXT,
@@ -27,13 +27,16 @@
 #include "Catalog/Catalog.h"
 #include "Fragmenter/InsertOrderFragmenter.h"
 #include "ImportExport/Importer.h"
+#include "LockMgr/LockMgr.h"
 #include "Parser/ParserNode.h"
+#include "QueryEngine/DeferredVacuumQueue.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryEngine/TableOptimizer.h"
 #include "QueryRunner/QueryRunner.h"
 #include "Shared/UpdelRoll.h"
 #include "Shared/measure.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
 #ifndef BASE_PATH
@@ -44,6 +47,8 @@ using namespace Catalog_Namespace;
 
 using QR = QueryRunner::QueryRunner;
 
+extern bool g_enable_snapshot_reads;
+
 namespace {
 struct UpdelTestConfig {
   static bool showMeasuredTime;
@@ -1058,7 +1063,16 @@ TEST_F(UpdateStorageTest, Half_boolean_deleted_rollback) {
 
 class VarLenColumnUpdateTest : public ::testing::Test {
  protected:
-  static void SetUpTestSuite() { g_vacuum_min_selectivity = 1.1; }
+  static void SetUpTestSuite() {
+    orig_vacuum_min_selectivity_ = g_vacuum_min_selectivity;
+    g_vacuum_min_selectivity = 1.1;
+  }
+
+  static void TearDownTestSuite() {
+    g_vacuum_min_selectivity = orig_vacuum_min_selectivity_;
+  }
+
+  static inline float orig_vacuum_min_selectivity_;
 
   void SetUp() override {
     run_ddl_statement("drop table if exists test_table;");
@@ -1182,6 +1196,154 @@ TEST_F(TableWithImmediateVacuumTest, FixedLenColumnUpdate) {
   sqlAndCompareResult("select * from test_table;", 2, "a");
 }
 
+class SnapshotReadsTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    orig_vacuum_min_selectivity_ = g_vacuum_min_selectivity;
+    g_vacuum_min_selectivity = 1.1;
+  }
+
+  static void TearDownTestSuite() {
+    g_vacuum_min_selectivity = orig_vacuum_min_selectivity_;
+  }
+
+  static inline float orig_vacuum_min_selectivity_;
+
+  void SetUp() override {
+    g_enable_snapshot_reads = true;
+    run_ddl_statement("drop table if exists test_table;");
+    run_ddl_statement("create table test_table (i int) with (fragment_size = 2);");
+    for (int i = 1; i <= 4; ++i) {
+      run_query("insert into test_table values (" + std::to_string(i) + ");");
+    }
+  }
+
+  void TearDown() override {
+    g_enable_snapshot_reads = false;
+    run_ddl_statement("drop table if exists test_table;");
+  }
+
+  // Reads the values of the table as a query holding the given fragment infos would.
+  std::vector<int32_t> getValues(const Fragmenter_Namespace::TableInfo& table_info) {
+    auto cat = QR::get()->getCatalog();
+    const auto td = cat->getMetadataForTable("test_table");
+    const auto cd = cat->getMetadataForColumn(td->tableId, "i");
+    std::vector<int32_t> values;
+    for (const auto& fragment : table_info.fragments) {
+      const auto& chunk_metadata =
+          fragment.getChunkMetadataMapPhysical().at(cd->columnId);
+      const auto chunk = fragment.getChunk(
+          cd,
+          &cat->getDataMgr(),
+          {cat->getDatabaseId(), td->tableId, cd->columnId, fragment.fragmentId},
+          Data_Namespace::CPU_LEVEL,
+          0,
+          chunk_metadata->numBytes,
+          chunk_metadata->numElements);
+      const auto data =
+          reinterpret_cast<const int32_t*>(chunk->getBuffer()->getMemoryPtr());
+      values.insert(values.end(), data, data + fragment.getPhysicalNumTuples());
+    }
+    return values;
+  }
+};
+
+TEST_F(SnapshotReadsTest, UpdateAndDeleteDuringQuery) {
+  auto cat = QR::get()->getCatalog();
+  const auto td = cat->getMetadataForTable("test_table");
+  {
+    // stand-in for a query that started before the update and delete
+    const auto read_lock =
+        lockmgr::TableDataLockMgr::getReadLockForTable(*cat, "test_table");
+    const auto table_info = td->fragmenter->getFragmentsForQuery();
+
+    run_query("update test_table set i = i * 10 where i < 3;");
+    const auto updated_table_info = td->fragmenter->getFragmentsForQuery();
+    run_query("update test_table set i = i * 10 where i = 3;");
+    run_query("delete from test_table where i = 4;");
+
+    EXPECT_EQ(getValues(table_info), std::vector<int32_t>({1, 2, 3, 4}));
+    EXPECT_EQ(getValues(updated_table_info), std::vector<int32_t>({10, 20, 3, 4}));
+    EXPECT_EQ(getValues(td->fragmenter->getFragmentsForQuery()),
+              std::vector<int32_t>({10, 20, 30, 4}));
+  }
+  auto rows = run_query("select count(*), sum(i) from test_table;");
+  auto row = rows->getNextRow(true, true);
+  EXPECT_EQ(int64_t(3), v<int64_t>(row[0]));
+  EXPECT_EQ(int64_t(60), v<int64_t>(row[1]));
+}
+
+TEST_F(SnapshotReadsTest, DeleteLeavesVacuumToOptimize) {
+  ScopeGuard reset = [orig_min_selectivity = g_vacuum_min_selectivity,
+                      orig_deferred_vacuum = g_enable_deferred_vacuum] {
+    g_vacuum_min_selectivity = orig_min_selectivity;
+    g_enable_deferred_vacuum = orig_deferred_vacuum;
+  };
+  g_vacuum_min_selectivity = 0.1;
+  g_enable_deferred_vacuum = true;
+  auto cat = QR::get()->getCatalog();
+  const auto td = cat->getMetadataForTable("test_table");
+  auto get_physical_row_count = [td] {
+    size_t row_count{0};
+    for (const auto& fragment : td->fragmenter->getFragmentsForQuery().fragments) {
+      row_count += fragment.getPhysicalNumTuples();
+    }
+    return row_count;
+  };
+
+  const auto completed_job_count = DeferredVacuumQueue::instance().getCompletedJobCount();
+  run_query("delete from test_table where i = 4;");
+  DeferredVacuumQueue::instance().waitForPendingJobs();
+  // neither vacuumed by the delete nor queued for a background vacuum
+  EXPECT_EQ(DeferredVacuumQueue::instance().getCompletedJobCount(), completed_job_count);
+  EXPECT_EQ(get_physical_row_count(), size_t(4));
+
+  run_ddl_statement("optimize table test_table with (vacuum = 'true');");
+  EXPECT_EQ(get_physical_row_count(), size_t(3));
+}
+
+TEST_F(SnapshotReadsTest, RepeatedUpdatesDuringQuery) {
+  auto cat = QR::get()->getCatalog();
+  const auto td = cat->getMetadataForTable("test_table");
+  // pages of the CPU buffers that were replaced while in use
+  auto get_detached_buffer_pages = [cat] {
+    std::vector<size_t> pages;
+    for (const auto& memory_info :
+         cat->getDataMgr().getMemoryInfo(Data_Namespace::CPU_LEVEL)) {
+      for (const auto& memory_data : memory_info.nodeMemoryData) {
+        if (memory_data.memStatus == Buffer_Namespace::USED &&
+            memory_data.chunk_key.at(0) == -1) {
+          pages.push_back(memory_data.numPages);
+        }
+      }
+    }
+    return pages;
+  };
+
+  std::vector<size_t> detached_buffer_pages;
+  {
+    // stand-in for a query that runs across all updates
+    const auto read_lock =
+        lockmgr::TableDataLockMgr::getReadLockForTable(*cat, "test_table");
+    const auto table_info = td->fragmenter->getFragmentsForQuery();
+
+    run_query("update test_table set i = i + 1;");
+    detached_buffer_pages = get_detached_buffer_pages();
+    EXPECT_GE(detached_buffer_pages.size(), table_info.fragments.size());
+    for (int i = 0; i < 10; ++i) {
+      run_query("update test_table set i = i + 1;");
+      // the query keeps the chunks it started with, not those of every update since
+      EXPECT_EQ(get_detached_buffer_pages(), detached_buffer_pages);
+    }
+    EXPECT_EQ(getValues(table_info), std::vector<int32_t>({1, 2, 3, 4}));
+  }
+  run_query("update test_table set i = i + 1;");
+  // the chunks the query held are freed once replaced buffers are next cleaned up
+  EXPECT_LT(get_detached_buffer_pages().size(), detached_buffer_pages.size());
+  EXPECT_EQ(getValues(td->fragmenter->getFragmentsForQuery()),
+            std::vector<int32_t>({13, 14, 15, 16}));
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
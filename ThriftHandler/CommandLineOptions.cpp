@@ -26,6 +26,7 @@
 #include "ImportExport/ForeignDataImporter.h"
 #include "MapDRelease.h"
 #include "MigrationMgr/MigrationMgr.h"
+#include "QueryEngine/FromTableReordering.h"
 #include "QueryEngine/GroupByAndAggregate.h"
 #include "Shared/Compressor.h"
 #include "Shared/SysDefinitions.h"
@@ -46,6 +47,21 @@ bool g_enable_thrift_logs{false};
 
 extern bool g_use_table_device_offset;
 extern float g_fraction_code_cache_to_evict;
+extern bool g_enable_persistent_code_cache;
+extern std::string g_persistent_code_cache_path;
+extern size_t g_persistent_code_cache_max_size_bytes;
+extern bool g_enable_tiered_compilation;
+extern size_t g_tiered_compilation_max_pending_jobs;
+extern bool g_enable_file_mgr_header_snapshot;
+extern size_t g_file_mgr_header_snapshot_interval;
+extern bool g_enable_string_translation_map_cache;
+extern size_t g_string_translation_map_cache_max_size_bytes;
+extern bool g_enable_cost_based_join_ordering;
+extern size_t g_cost_based_join_ordering_max_dp_tables;
+extern bool g_enable_foreign_table_filter_pushdown;
+extern bool g_enable_deferred_vacuum;
+extern bool g_enable_auto_fragment_merge;
+extern bool g_enable_snapshot_reads;
 extern bool g_cache_string_hash;
 extern bool g_enable_idp_temporary_users;
 extern bool g_enable_left_join_filter_hoisting;
@@ -212,6 +228,14 @@ void CommandLineOptions::fillOptions() {
           ->default_value(g_auto_resultset_caching_threshold),
       "A threshold that allows caching query resultset automatically if the size of "
       "resultset is less than it, in bytes (default: 1MB).");
+  help_desc.add_options()(
+      "enable-incremental-resultset-cache",
+      po::value<bool>(&g_enable_incremental_resultset_cache)
+          ->default_value(g_enable_incremental_resultset_cache)
+          ->implicit_value(true),
+      "Cache the partial resultsets of aggregate queries over the full fragments of "
+      "their input table, so that after rows are appended to the table the query only "
+      "aggregates the fragments the partial resultsets do not cover.");
   help_desc.add_options()("allow-query-step-skipping",
                           po::value<bool>(&g_allow_query_step_skipping)
                               ->default_value(g_allow_query_step_skipping)
@@ -527,6 +551,12 @@ void CommandLineOptions::fillOptions() {
           ->default_value(g_enable_interop)
           ->implicit_value(true),
       "Enable offloading of query portions to an external execution engine.");
+  help_desc.add_options()(
+      "max-external-execution-input-rows",
+      po::value<size_t>(&g_max_external_execution_input_rows)
+          ->default_value(g_max_external_execution_input_rows),
+      "Maximum number of input rows of a query step offloaded to the external execution "
+      "engine. Larger steps fail instead. 0 means no limit.");
   help_desc.add_options()("enable-union",
                           po::value<bool>(&g_enable_union)
                               ->default_value(g_enable_union)
@@ -635,6 +665,54 @@ void CommandLineOptions::fillAdvancedOptions() {
                                    ->default_value(g_enable_lazy_fetch)
                                    ->implicit_value(true),
                                "Enable lazy fetch columns in query results.");
+  developer_desc.add_options()(
+      "enable-late-materialization",
+      po::value<bool>(&g_enable_late_materialization)
+          ->default_value(g_enable_late_materialization)
+          ->implicit_value(true),
+      "Load the chunks of lazily fetched columns only after the query kernel has "
+      "produced rows for their fragment.");
+  developer_desc.add_options()(
+      "enable-query-step-fusion",
+      po::value<bool>(&g_enable_query_step_fusion)
+          ->default_value(g_enable_query_step_fusion)
+          ->implicit_value(true),
+      "Fuse projects into the filters and projects consuming them before building the "
+      "query steps, so that their results are not materialized in between.");
+  developer_desc.add_options()(
+      "max-parallel-query-steps",
+      po::value<size_t>(&g_max_parallel_query_steps)
+          ->default_value(g_max_parallel_query_steps),
+      "Maximum number of independent steps (and uncorrelated subqueries) of a query "
+      "executed concurrently. 1 executes the steps one after another.");
+  developer_desc.add_options()(
+      "parallel-query-steps-memory-budget",
+      po::value<size_t>(&g_parallel_query_steps_memory_budget)
+          ->default_value(g_parallel_query_steps_memory_budget),
+      "Estimated size in bytes of the results of the query steps executed "
+      "concurrently, above which no further step is started.");
+  developer_desc.add_options()(
+      "enable-adaptive-group-by-layout",
+      po::value<bool>(&g_enable_adaptive_group_by_layout)
+          ->default_value(g_enable_adaptive_group_by_layout)
+          ->implicit_value(true),
+      "Record the number of groups found by each group by query step and use it to pick "
+      "the layout and the initial size of the groups buffer of its next execution.");
+  developer_desc.add_options()(
+      "adaptive-group-by-min-fill-ratio",
+      po::value<double>(&g_adaptive_group_by_min_fill_ratio)
+          ->default_value(g_adaptive_group_by_min_fill_ratio),
+      "Fraction of a perfect hash groups buffer filled by the previous execution of a "
+      "query step below which the step switches to the baseline hash layout. Requires "
+      "--enable-adaptive-group-by-layout.");
+  developer_desc.add_options()(
+      "enable-hot-group-cache",
+      po::value<bool>(&g_enable_hot_group_cache)
+          ->default_value(g_enable_hot_group_cache)
+          ->implicit_value(true),
+      "Look up the most frequent keys of baseline hash group by queries on CPU in a "
+      "small cache in front of the groups buffer. The cache turns itself off in kernels "
+      "whose keys are not skewed.");
   developer_desc.add_options()(
       "enable-shared-mem-group-by",
       po::value<bool>(&g_enable_smem_group_by)
@@ -756,6 +834,15 @@ void CommandLineOptions::fillAdvancedOptions() {
       "there is not enough free memory to accomodate the target slab size, smaller "
       "slabs will be allocated, down to the minimum size specified by "
       "min-cpu-slab-size.");
+  developer_desc.add_options()(
+      "enable-numa-aware-cpu-buffer-pool",
+      po::value<bool>(&g_enable_numa_aware_cpu_buffer_pool)
+          ->default_value(g_enable_numa_aware_cpu_buffer_pool)
+          ->implicit_value(true),
+      "Place each CPU buffer pool slab on the NUMA node of the thread which needed it "
+      "and take free space for chunks from the slabs local to the loading thread "
+      "first. CPU kernels of fragments placed on a node run on the threads of that "
+      "node if TBB can bind its threads to NUMA nodes.");
   developer_desc.add_options()(
       "min-gpu-slab-size",
       po::value<size_t>(&system_parameters.min_gpu_slab_size)
@@ -806,6 +893,84 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_fraction_code_cache_to_evict),
       "Percentage of the GPU code cache to evict if an out of memory error is "
       "encountered while attempting to place generated code on the GPU.");
+  developer_desc.add_options()(
+      "enable-persistent-code-cache",
+      po::value<bool>(&g_enable_persistent_code_cache)
+          ->default_value(g_enable_persistent_code_cache)
+          ->implicit_value(true),
+      "Persist compiled CPU query code on disk, so that it can be reused across server "
+      "restarts without paying the JIT compilation cost again.");
+  developer_desc.add_options()(
+      "persistent-code-cache-path",
+      po::value<std::string>(&g_persistent_code_cache_path),
+      "Directory path to the persistent code cache. Defaults to the \"code_cache\" "
+      "directory under the data directory.");
+  developer_desc.add_options()(
+      "persistent-code-cache-max-size-bytes",
+      po::value<size_t>(&g_persistent_code_cache_max_size_bytes)
+          ->default_value(g_persistent_code_cache_max_size_bytes),
+      "Maximum size of the persistent code cache, in bytes (default: 1GB). Newly "
+      "compiled code is not persisted once the limit is reached.");
+  developer_desc.add_options()(
+      "enable-tiered-compilation",
+      po::value<bool>(&g_enable_tiered_compilation)
+          ->default_value(g_enable_tiered_compilation)
+          ->implicit_value(true),
+      "Start executing new CPU queries with quickly compiled unoptimized code, and "
+      "replace it with optimized code compiled in the background.");
+  developer_desc.add_options()(
+      "tiered-compilation-max-pending-jobs",
+      po::value<size_t>(&g_tiered_compilation_max_pending_jobs)
+          ->default_value(g_tiered_compilation_max_pending_jobs),
+      "Maximum number of queries waiting for their optimized code to be compiled in the "
+      "background. Queries beyond the limit keep running unoptimized code.");
+  developer_desc.add_options()(
+      "enable-file-mgr-header-snapshot",
+      po::value<bool>(&g_enable_file_mgr_header_snapshot)
+          ->default_value(g_enable_file_mgr_header_snapshot)
+          ->implicit_value(true),
+      "Write a snapshot of the page headers of a table at checkpoints, so that "
+      "opening the table after a restart does not need to read every page header.");
+  developer_desc.add_options()(
+      "file-mgr-header-snapshot-interval",
+      po::value<size_t>(&g_file_mgr_header_snapshot_interval)
+          ->default_value(g_file_mgr_header_snapshot_interval),
+      "Number of checkpoints modifying page headers of a table between two rewrites of "
+      "its page header snapshot. Checkpoints that modify no page header never rewrite "
+      "the snapshot.");
+  developer_desc.add_options()(
+      "enable-string-translation-map-cache",
+      po::value<bool>(&g_enable_string_translation_map_cache)
+          ->default_value(g_enable_string_translation_map_cache)
+          ->implicit_value(true),
+      "Reuse the results of string functions applied to dictionary-encoded strings "
+      "across queries.");
+  developer_desc.add_options()(
+      "string-translation-map-cache-max-size",
+      po::value<size_t>(&g_string_translation_map_cache_max_size_bytes)
+          ->default_value(g_string_translation_map_cache_max_size_bytes),
+      "Maximum size in bytes of the cache of dictionary-encoded string function "
+      "results.");
+  developer_desc.add_options()(
+      "enable-cost-based-join-ordering",
+      po::value<bool>(&g_enable_cost_based_join_ordering)
+          ->default_value(g_enable_cost_based_join_ordering)
+          ->implicit_value(true),
+      "Order the tables of inner joins by the cost estimated from the statistics of the "
+      "join and filter columns, instead of by table size.");
+  developer_desc.add_options()(
+      "cost-based-join-ordering-max-dp-tables",
+      po::value<size_t>(&g_cost_based_join_ordering_max_dp_tables)
+          ->default_value(g_cost_based_join_ordering_max_dp_tables),
+      "Maximum number of joined tables for which cost-based join ordering considers "
+      "every join order. Larger joins are ordered greedily.");
+  developer_desc.add_options()(
+      "enable-foreign-table-filter-pushdown",
+      po::value<bool>(&g_enable_foreign_table_filter_pushdown)
+          ->default_value(g_enable_foreign_table_filter_pushdown)
+          ->implicit_value(true),
+      "Pass simple query filters to foreign table data wrappers, which skip fragments "
+      "using the statistics of the source files, e.g. Parquet row group statistics.");
 
   developer_desc.add_options()("ssl-cert",
                                po::value<std::string>(&system_parameters.ssl_cert_file)
@@ -941,6 +1106,34 @@ void CommandLineOptions::fillAdvancedOptions() {
                                "deleted rows in a fragment at which to perform "
                                "automatic vacuuming. A number greater than 1 can "
                                "be used to disable automatic vacuuming.");
+  developer_desc.add_options()(
+      "enable-deferred-vacuum",
+      po::value<bool>(&g_enable_deferred_vacuum)
+          ->default_value(g_enable_deferred_vacuum)
+          ->implicit_value(true),
+      "Vacuum the fragments selected for automatic vacuuming on a background thread, "
+      "one fragment at a time, instead of as part of the delete query.");
+  developer_desc.add_options()(
+      "enable-snapshot-reads",
+      po::value<bool>(&g_enable_snapshot_reads)
+          ->default_value(g_enable_snapshot_reads)
+          ->implicit_value(true),
+      "Apply updates and deletes of stored tables to copies of the affected chunks, so "
+      "that they commit without waiting for running queries, which keep reading the "
+      "chunks as of when they started. Deleted rows are then only compacted by "
+      "OPTIMIZE.");
+  developer_desc.add_options()(
+      "enable-auto-fragment-merge",
+      po::value<bool>(&g_enable_auto_fragment_merge)
+          ->default_value(g_enable_auto_fragment_merge)
+          ->implicit_value(true),
+      "Merge under-filled fragments of a table after deferred vacuuming of the table.");
+  developer_desc.add_options()(
+      "fragment-merge-max-fill",
+      po::value<float>(&g_fragment_merge_max_fill)
+          ->default_value(g_fragment_merge_max_fill),
+      "Fraction of the fragment size below which a fragment is merged by OPTIMIZE "
+      "TABLE ... WITH (MERGE_FRAGMENTS='true') or automatic fragment merging.");
   developer_desc.add_options()("enable-automatic-ir-metadata",
                                po::value<bool>(&g_enable_automatic_ir_metadata)
                                    ->default_value(g_enable_automatic_ir_metadata)
@@ -1200,6 +1393,16 @@ void CommandLineOptions::validate() {
   }
   ddl_utils::FilePathBlacklist::addToBlacklist(disk_cache_config.path);
 
+  if (g_persistent_code_cache_path.empty()) {
+    g_persistent_code_cache_path = base_path + "/" + shared::kDefaultCodeCacheDirName;
+  }
+  ddl_utils::FilePathBlacklist::addToBlacklist(g_persistent_code_cache_path);
+  LOG(INFO) << "Persistent code cache is set to " << g_enable_persistent_code_cache;
+  if (g_enable_persistent_code_cache) {
+    LOG(INFO) << "Persistent code cache path is set to "
+              << g_persistent_code_cache_path;
+  }
+
   ddl_utils::FilePathBlacklist::addToBlacklist("/etc/passwd");
   ddl_utils::FilePathBlacklist::addToBlacklist("/etc/shadow");
 
@@ -1218,6 +1421,13 @@ void CommandLineOptions::validate() {
   }
   LOG(INFO) << "Vacuum Min Selectivity: " << g_vacuum_min_selectivity;
 
+  if (g_cost_based_join_ordering_max_dp_tables > kMaxCostBasedJoinOrderingDpTables) {
+    LOG(WARNING) << "cost-based-join-ordering-max-dp-tables is limited to "
+                 << kMaxCostBasedJoinOrderingDpTables << ", "
+                 << g_cost_based_join_ordering_max_dp_tables << " was given.";
+    g_cost_based_join_ordering_max_dp_tables = kMaxCostBasedJoinOrderingDpTables;
+  }
+
   LOG(INFO) << "Enable system tables is set to " << g_enable_system_tables;
   if (g_enable_system_tables) {
     // System tables currently reuse FSI infrastructure and therefore, require FSI to be
@@ -1502,6 +1712,8 @@ boost::optional<int> CommandLineOptions::parse_command_line(
                    "automatically cached: "
                 << g_auto_resultset_caching_threshold << " Bytes.";
     }
+    LOG(INFO) << " \t\t Use incremental query resultset cache: "
+              << (g_enable_incremental_resultset_cache ? "enabled" : "disabled");
     LOG(INFO) << " \t\t Use query step skipping: "
               << (g_allow_query_step_skipping ? "enabled" : "disabled");
     LOG(INFO) << " \t Use chunk metadata cache: "
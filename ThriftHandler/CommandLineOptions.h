@@ -202,6 +202,11 @@ extern bool g_enable_smem_non_grouped_agg;
 extern bool g_enable_smem_grouped_non_count_agg;
 extern bool g_use_estimator_result_cache;
 extern bool g_enable_lazy_fetch;
+extern bool g_enable_late_materialization;
+extern bool g_enable_query_step_fusion;
+extern bool g_enable_adaptive_group_by_layout;
+extern double g_adaptive_group_by_min_fill_ratio;
+extern bool g_enable_hot_group_cache;
 
 extern int64_t g_omni_kafka_seek;
 extern size_t g_leaf_count;
@@ -220,6 +225,9 @@ extern bool g_enable_legacy_parquet_import;
 extern bool g_enable_fsi_regex_import;
 extern bool g_enable_add_metadata_columns;
 extern bool g_enable_interop;
+extern size_t g_max_external_execution_input_rows;
+extern size_t g_max_parallel_query_steps;
+extern size_t g_parallel_query_steps_memory_budget;
 extern bool g_enable_union;
 extern bool g_enable_cpu_sub_tasks;
 extern size_t g_cpu_sub_task_size;
@@ -228,10 +236,12 @@ extern size_t g_max_import_threads;
 extern bool g_enable_auto_metadata_update;
 extern bool g_allow_s3_server_privileges;
 extern float g_vacuum_min_selectivity;
+extern float g_fragment_merge_max_fill;
 extern bool g_read_only;
 extern bool g_enable_automatic_ir_metadata;
 extern size_t g_enable_parallel_linearization;
 extern size_t g_max_log_length;
+extern bool g_enable_numa_aware_cpu_buffer_pool;
 #ifdef ENABLE_MEMKIND
 extern bool g_enable_tiered_cpu_mem;
 extern size_t g_pmem_size;
@@ -246,6 +256,7 @@ extern size_t g_query_resultset_cache_total_bytes;
 extern size_t g_max_cacheable_query_resultset_size_bytes;
 extern bool g_use_chunk_metadata_cache;
 extern bool g_allow_auto_resultset_caching;
+extern bool g_enable_incremental_resultset_cache;
 extern size_t g_auto_resultset_caching_threshold;
 extern bool g_allow_query_step_skipping;
 extern bool g_query_engine_cuda_streams;
@@ -5978,6 +5978,9 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
                              cat,
                              query_ra,
                              query_state_proxy.getQueryState().shared_from_this());
+  if (explain_info.explain_analyze) {
+    ra_executor.enableExplainAnalyze();
+  }
   CompilationOptions co = {executor_device_type,
                            /*hoist_literals=*/true,
                            ExecutorOptLevel::Default,
@@ -5999,7 +6002,7 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
                          just_validate,
                          g_enable_dynamic_watchdog,
                          g_dynamic_watchdog_time_limit,
-                         find_push_down_candidates,
+                         find_push_down_candidates && !explain_info.explain_analyze,
                          explain_info.justCalciteExplain(),
                          system_parameters_.gpu_input_mem_limit,
                          g_enable_runtime_query_interrupt && !validate_or_explain_query &&
@@ -6024,7 +6027,7 @@ std::vector<PushedDownFilterInfo> DBHandler::execute_rel_alg(
   if (!filter_push_down_info.empty()) {
     return filter_push_down_info;
   }
-  if (explain_info.justExplain()) {
+  if (explain_info.justExplain() || explain_info.explain_analyze) {
     _return.setResultType(ExecutionResult::Explaination);
   } else if (!explain_info.justCalciteExplain()) {
     _return.setResultType(ExecutionResult::QueryResult);
@@ -6504,7 +6507,7 @@ void DBHandler::sql_execute_impl(ExecutionResult& _return,
     CHECK(dispatch_queue_);
     auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
     if (g_enable_runtime_query_interrupt && !query_session.empty() &&
-        !pw.isSelectExplain()) {
+        (!pw.isSelectExplain() || pw.isAnalyzeExplain())) {
       executor->enrollQuerySession(query_session,
                                    query_str,
                                    submitted_time_str,
@@ -717,6 +717,7 @@ SqlDdl SqlAlterTable(Span s) :
  * Insert into table(s) using one of the following forms:
  *
  * 1) INSERT INTO <table_name> [columns] <values>
+ *        [ON CONFLICT (<key_column>) DO {UPDATE | NOTHING}]
  * 2) INSERT INTO <table_name> [columns] <select>
  */
 SqlNode SqlInsertIntoTable(Span s) :
@@ -726,6 +727,8 @@ SqlNode SqlInsertIntoTable(Span s) :
     SqlNode table;
     SqlNode source;
     SqlNodeList columnList = null;
+    SqlIdentifier conflictColumn = null;
+    String conflictAction = null;
 }
 {
     <INSERT> <INTO> table = CompoundIdentifier()
@@ -734,8 +737,18 @@ SqlNode SqlInsertIntoTable(Span s) :
         columnList = ParenthesizedSimpleIdentifierList()
     ]
     (
-        source = TableConstructor() {
-             return new SqlInsertValues(s.end(this), table, source, columnList);
+        source = TableConstructor()
+        [
+            <ON> <CONFLICT> <LPAREN> conflictColumn = SimpleIdentifier() <RPAREN> <DO>
+            (
+                <UPDATE> { conflictAction = "UPDATE"; }
+            |
+                <NOTHING> { conflictAction = "NOTHING"; }
+            )
+        ]
+        {
+             return new SqlInsertValues(s.end(this), table, source, columnList,
+                     conflictColumn, conflictAction);
         }
     |
         source = OrderedQueryOrExpr(ExprContext.ACCEPT_QUERY) {
@@ -19,16 +19,29 @@ public class SqlInsertValues extends SqlDdl {
   public final SqlNode name;
   public SqlNode values;
   public final SqlNodeList columnList;
+  public final SqlIdentifier conflictColumn;
+  public final String conflictAction;
 
   private static final SqlOperator OPERATOR =
           new SqlSpecialOperator("INSERT_INTO_TABLE_AS_SELECT", SqlKind.OTHER_DDL);
 
   public SqlInsertValues(
           SqlParserPos pos, SqlNode name, SqlNode values, SqlNodeList columnList) {
+    this(pos, name, values, columnList, null, null);
+  }
+
+  public SqlInsertValues(SqlParserPos pos,
+          SqlNode name,
+          SqlNode values,
+          SqlNodeList columnList,
+          SqlIdentifier conflictColumn,
+          String conflictAction) {
     super(OPERATOR, pos);
     this.name = name;
     this.values = values;
     this.columnList = columnList;
+    this.conflictColumn = conflictColumn;
+    this.conflictAction = conflictAction;
   }
 
   @Nonnull
@@ -54,6 +67,15 @@ public class SqlInsertValues extends SqlDdl {
     SqlWriter.Frame frame = writer.startList("(", ")");
     values.unparse(writer, leftPrec, rightPrec);
     writer.endList(frame);
+    if (conflictColumn != null) {
+      writer.keyword("ON");
+      writer.keyword("CONFLICT");
+      SqlWriter.Frame conflictFrame = writer.startList("(", ")");
+      conflictColumn.unparse(writer, 0, 0);
+      writer.endList(conflictFrame);
+      writer.keyword("DO");
+      writer.keyword(conflictAction);
+    }
   }
 
   @Override
@@ -77,6 +99,13 @@ public class SqlInsertValues extends SqlDdl {
       rows.add(toJson(row_node, jsonBuilder));
     }
     jsonBuilder.put(map, "values", rows);
+
+    if (conflictColumn != null) {
+      Map<String, Object> on_conflict = jsonBuilder.map();
+      on_conflict.put("column", conflictColumn.toString());
+      on_conflict.put("action", conflictAction);
+      jsonBuilder.put(map, "on_conflict", on_conflict);
+    }
     Map<String, Object> payload = jsonBuilder.map();
     payload.put("payload", map);
     return jsonBuilder.toJsonString(payload);